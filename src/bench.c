@@ -0,0 +1,457 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/shell/shell.h>
+#include <string.h>
+
+#include "bench.h"
+#include "udp_utils.h"
+#include "time_utils.h"
+#include "power_mgr.h"
+
+LOG_MODULE_REGISTER(bench, CONFIG_LOG_DEFAULT_LEVEL);
+
+#define BENCH_STACK_SIZE 4096
+
+/* Default test points when an argument is omitted */
+#define BENCH_DEFAULT_COUNT 100
+#define BENCH_DEFAULT_DURATION_MS 10000
+#define BENCH_DEFAULT_SWEEP_MIN 64
+#define BENCH_DEFAULT_WINDOW_SIZE 256
+
+enum bench_test {
+	BENCH_LATENCY,
+	BENCH_THROUGHPUT,
+	BENCH_SIZE_SWEEP,
+	BENCH_WINDOW_SWEEP,
+};
+
+static const char *const bench_test_txt[] = {
+	[BENCH_LATENCY] = "latency",
+	[BENCH_THROUGHPUT] = "throughput",
+	[BENCH_SIZE_SWEEP] = "sweep",
+	[BENCH_WINDOW_SWEEP] = "window",
+};
+
+struct bench_run {
+	enum bench_test test;
+	struct udp_echo_client_params echo;
+	struct udp_stream_params stream;
+	/* Last size of a size sweep, last window of a window sweep */
+	size_t max_size;
+	uint32_t max_window;
+};
+
+static struct bench_run bench;
+static const struct shell *bench_sh;
+static bool bench_json;
+
+static struct sockaddr_in bench_server;
+static bool bench_server_known;
+
+static struct udp_echo_stop bench_stop;
+static bool bench_stop_ready;
+static struct udp_echo_stats bench_stats;
+static struct udp_echo_stats bench_snap;
+static atomic_t bench_running;
+
+static K_THREAD_STACK_DEFINE(bench_stack, BENCH_STACK_SIZE);
+static struct k_thread bench_thread;
+static k_tid_t bench_tid;
+
+void bench_set_server(const struct sockaddr_in *addr)
+{
+	if (addr) {
+		bench_server = *addr;
+		bench_server_known = true;
+		return;
+	}
+
+	bench_server_known = false;
+	if (atomic_get(&bench_running) && bench_stop_ready) {
+		udp_echo_stop_request(&bench_stop);
+	}
+}
+
+static void bench_print_header(void)
+{
+	if (!bench_json) {
+		shell_print(bench_sh, "test,size,window,sent,received,lost,"
+			    "rtt_min_us,rtt_avg_us,rtt_p50_us,rtt_p99_us,"
+			    "rtt_max_us,jitter_us,kbps,elapsed_ms");
+	}
+}
+
+/* One line per test point. For throughput, kbps is the offered rate;
+ * the GO logs what was received.
+ */
+static void bench_report(size_t size, uint32_t window, uint64_t elapsed_us)
+{
+	const struct udp_echo_stats *s = &bench_snap;
+	uint32_t rtt_min = 0, rtt_avg = 0, rtt_max = 0, p50 = 0, p99 = 0;
+	uint32_t kbps = 0;
+	uint64_t bytes;
+
+	udp_echo_stats_snapshot(&bench_stats, &bench_snap);
+	bytes = bench.test == BENCH_THROUGHPUT ? s->bytes_sent : s->bytes_received;
+
+	if (s->packets_received > 0 && s->rtt_min_us != UINT32_MAX) {
+		rtt_min = s->rtt_min_us;
+		rtt_avg = s->rtt_avg_us;
+		rtt_max = s->rtt_max_us;
+		p50 = CLAMP(rtt_histogram_percentile(&s->rtt_hist, 5000),
+			    rtt_min, rtt_max);
+		p99 = CLAMP(rtt_histogram_percentile(&s->rtt_hist, 9900),
+			    rtt_min, rtt_max);
+	}
+
+	if (elapsed_us > 0) {
+		kbps = (uint32_t)(bytes * 8 * 1000 / elapsed_us);
+	}
+
+	if (bench_json) {
+		shell_print(bench_sh,
+			    "{\"test\":\"%s\",\"size\":%u,\"window\":%u,"
+			    "\"sent\":%llu,\"received\":%llu,\"lost\":%llu,"
+			    "\"rtt_min_us\":%u,\"rtt_avg_us\":%u,\"rtt_p50_us\":%u,"
+			    "\"rtt_p99_us\":%u,\"rtt_max_us\":%u,\"jitter_us\":%u,"
+			    "\"kbps\":%u,\"elapsed_ms\":%u}",
+			    bench_test_txt[bench.test], (uint32_t)size, window,
+			    (unsigned long long)s->packets_sent,
+			    (unsigned long long)s->packets_received,
+			    (unsigned long long)s->packets_lost,
+			    rtt_min, rtt_avg, p50, p99, rtt_max, s->jitter_us, kbps,
+			    (uint32_t)(elapsed_us / 1000));
+	} else {
+		shell_print(bench_sh, "%s,%u,%u,%llu,%llu,%llu,%u,%u,%u,%u,%u,%u,%u,%u",
+			    bench_test_txt[bench.test], (uint32_t)size, window,
+			    (unsigned long long)s->packets_sent,
+			    (unsigned long long)s->packets_received,
+			    (unsigned long long)s->packets_lost,
+			    rtt_min, rtt_avg, p50, p99, rtt_max, s->jitter_us, kbps,
+			    (uint32_t)(elapsed_us / 1000));
+	}
+}
+
+static int bench_echo_point(int sock, size_t size, uint32_t window)
+{
+	uint64_t start_us;
+	int ret;
+
+	bench.echo.packet_size = size;
+	bench.echo.window = window;
+	udp_echo_reset_stats(&bench_stats);
+
+	start_us = time_utils_to_us(time_utils_now());
+	ret = udp_echo_client_run(sock, &bench_server, &bench.echo,
+				  &bench_stats, &bench_stop);
+	if (ret < 0 || bench_stop.flag) {
+		return ret < 0 ? ret : -ECANCELED;
+	}
+
+	bench_report(size, window,
+		     time_utils_to_us(time_utils_now()) - start_us);
+
+	return 0;
+}
+
+static int bench_run_test(int sock)
+{
+	uint64_t start_us;
+	size_t size;
+	uint32_t window;
+	int ret = 0;
+
+	switch (bench.test) {
+	case BENCH_LATENCY:
+		ret = bench_echo_point(sock, bench.echo.packet_size, 1);
+		break;
+	case BENCH_SIZE_SWEEP:
+		for (size = bench.echo.packet_size; ret == 0;
+		     size = udp_echo_sweep_next_size(size, bench.max_size)) {
+			ret = bench_echo_point(sock, size, bench.echo.window);
+			if (size >= bench.max_size) {
+				break;
+			}
+		}
+		break;
+	case BENCH_WINDOW_SWEEP:
+		for (window = 1; ret == 0 && window <= bench.max_window; window *= 2) {
+			ret = bench_echo_point(sock, bench.echo.packet_size, window);
+		}
+		break;
+	case BENCH_THROUGHPUT:
+		udp_echo_reset_stats(&bench_stats);
+		start_us = time_utils_to_us(time_utils_now());
+		ret = udp_stream_client_run(sock, &bench_server, &bench.stream,
+					    &bench_stats, &bench_stop);
+		if (ret == 0 && !bench_stop.flag) {
+			bench_report(bench.stream.packet_size, 0,
+				     time_utils_to_us(time_utils_now()) - start_us);
+		}
+		break;
+	}
+
+	return ret;
+}
+
+static void bench_thread_fn(void *p1, void *p2, void *p3)
+{
+	char ip_str[NET_IPV4_ADDR_LEN];
+	struct sockaddr_in addr;
+	int sock = -1;
+	int ret;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	zsock_inet_ntop(AF_INET, &bench_server.sin_addr, ip_str, sizeof(ip_str));
+
+	/* Benchmarks measure the link, not the power save wakeups */
+	power_mgr_hold(POWER_MGR_HOLD_BENCH, true);
+
+	ret = udp_client_init(&sock, &addr, ip_str, ntohs(bench_server.sin_port));
+	if (ret == 0) {
+		bench_print_header();
+		ret = bench_run_test(sock);
+		udp_client_cleanup(sock);
+	}
+
+	power_mgr_hold(POWER_MGR_HOLD_BENCH, false);
+
+	if (ret == -EBUSY) {
+		shell_error(bench_sh, "Echo client busy, stop the session with BUTTON 1");
+	} else if (ret == -ECANCELED) {
+		shell_warn(bench_sh, "Benchmark stopped");
+	} else if (ret < 0) {
+		shell_error(bench_sh, "Benchmark failed: %d", ret);
+	} else {
+		shell_print(bench_sh, "Benchmark done");
+	}
+
+	atomic_clear(&bench_running);
+}
+
+/* Arguments are parsed into a local run, which only replaces the shared
+ * one once this command owns the benchmark thread.
+ */
+static int bench_start(const struct shell *sh, const struct bench_run *run)
+{
+	if (!bench_server_known) {
+		shell_error(sh, "No echo server yet, run on a connected Client");
+		return -ENOTCONN;
+	}
+
+	if (!atomic_cas(&bench_running, 0, 1)) {
+		shell_error(sh, "Benchmark already running, use 'p2p bench stop'");
+		return -EBUSY;
+	}
+
+	if (!bench_stop_ready) {
+		(void)udp_echo_stop_init(&bench_stop);
+		bench_stop_ready = true;
+	}
+
+	/* The previous run cleared bench_running as its last step, so this
+	 * only waits for it to exit before its stack is reused.
+	 */
+	if (bench_tid) {
+		(void)k_thread_join(&bench_thread, K_FOREVER);
+	}
+
+	bench = *run;
+	udp_echo_stop_reset(&bench_stop);
+	bench_sh = sh;
+
+	bench_tid = k_thread_create(&bench_thread, bench_stack,
+				    K_THREAD_STACK_SIZEOF(bench_stack),
+				    bench_thread_fn, NULL, NULL, NULL,
+				    UDP_ECHO_THREAD_PRIO, 0, K_NO_WAIT);
+	k_thread_name_set(bench_tid, "p2p_bench");
+
+	return 0;
+}
+
+/* Optional positional argument with a default and bounds */
+static int bench_arg(const struct shell *sh, size_t argc, char **argv, size_t idx,
+		     uint32_t def, uint32_t min, uint32_t max, uint32_t *out)
+{
+	unsigned long val;
+	int err = 0;
+
+	if (idx >= argc) {
+		*out = def;
+		return 0;
+	}
+
+	val = shell_strtoul(argv[idx], 0, &err);
+	if (err || val < min || val > max) {
+		shell_error(sh, "Invalid %s, expected %u to %u", argv[idx], min, max);
+		return -EINVAL;
+	}
+
+	*out = val;
+	return 0;
+}
+
+static void bench_defaults(struct bench_run *run, enum bench_test test)
+{
+	memset(run, 0, sizeof(*run));
+	run->test = test;
+	run->echo.pattern = TX_SCHED_PERIODIC;
+	run->echo.window = 1;
+}
+
+static int cmd_bench_latency(const struct shell *sh, size_t argc, char **argv)
+{
+	struct bench_run run;
+	uint32_t size, count, interval;
+
+	bench_defaults(&run, BENCH_LATENCY);
+	if (bench_arg(sh, argc, argv, 1, CONFIG_UDP_ECHO_PACKET_SIZE, 20,
+		      CONFIG_UDP_ECHO_MAX_PACKET_SIZE, &size) ||
+	    bench_arg(sh, argc, argv, 2, BENCH_DEFAULT_COUNT, 1, UINT32_MAX, &count) ||
+	    bench_arg(sh, argc, argv, 3, CONFIG_UDP_ECHO_INTERVAL_MS, 0, 60000,
+		      &interval)) {
+		return -EINVAL;
+	}
+
+	run.echo.packet_size = size;
+	run.echo.count = count;
+	run.echo.interval_ms = interval;
+
+	return bench_start(sh, &run);
+}
+
+static int cmd_bench_throughput(const struct shell *sh, size_t argc, char **argv)
+{
+	struct bench_run run;
+	uint32_t size, rate, duration;
+
+	bench_defaults(&run, BENCH_THROUGHPUT);
+	if (bench_arg(sh, argc, argv, 1, CONFIG_UDP_THROUGHPUT_PACKET_SIZE, 32,
+		      CONFIG_UDP_THROUGHPUT_PACKET_SIZE, &size) ||
+	    bench_arg(sh, argc, argv, 2, 0, 0, UINT32_MAX, &rate) ||
+	    bench_arg(sh, argc, argv, 3, BENCH_DEFAULT_DURATION_MS, 1,
+		      UINT32_MAX, &duration)) {
+		return -EINVAL;
+	}
+
+	run.stream.packet_size = size;
+	run.stream.rate_kbps = rate;
+	run.stream.duration_ms = duration;
+
+	return bench_start(sh, &run);
+}
+
+static int cmd_bench_sweep(const struct shell *sh, size_t argc, char **argv)
+{
+	struct bench_run run;
+	uint32_t min, max, count, window;
+
+	bench_defaults(&run, BENCH_SIZE_SWEEP);
+	if (bench_arg(sh, argc, argv, 1, BENCH_DEFAULT_SWEEP_MIN, 20,
+		      CONFIG_UDP_ECHO_MAX_PACKET_SIZE, &min) ||
+	    bench_arg(sh, argc, argv, 2, CONFIG_UDP_ECHO_MAX_PACKET_SIZE, min,
+		      CONFIG_UDP_ECHO_MAX_PACKET_SIZE, &max) ||
+	    bench_arg(sh, argc, argv, 3, BENCH_DEFAULT_COUNT, 1, UINT32_MAX, &count) ||
+	    bench_arg(sh, argc, argv, 4, 1, 1, CONFIG_UDP_ECHO_WINDOW_MAX, &window)) {
+		return -EINVAL;
+	}
+
+	run.echo.packet_size = min;
+	run.max_size = max;
+	run.echo.count = count;
+	run.echo.window = window;
+
+	return bench_start(sh, &run);
+}
+
+static int cmd_bench_window(const struct shell *sh, size_t argc, char **argv)
+{
+	struct bench_run run;
+	uint32_t max_window, size, count;
+
+	bench_defaults(&run, BENCH_WINDOW_SWEEP);
+	if (bench_arg(sh, argc, argv, 1, CONFIG_UDP_ECHO_WINDOW_MAX, 1,
+		      CONFIG_UDP_ECHO_WINDOW_MAX, &max_window) ||
+	    bench_arg(sh, argc, argv, 2, MIN(BENCH_DEFAULT_WINDOW_SIZE,
+					     CONFIG_UDP_ECHO_MAX_PACKET_SIZE),
+		      20, CONFIG_UDP_ECHO_MAX_PACKET_SIZE, &size) ||
+	    bench_arg(sh, argc, argv, 3, BENCH_DEFAULT_COUNT, 1, UINT32_MAX, &count)) {
+		return -EINVAL;
+	}
+
+	/* Back to back, so the window is the only limit */
+	run.max_window = max_window;
+	run.echo.packet_size = size;
+	run.echo.count = count;
+
+	return bench_start(sh, &run);
+}
+
+static int cmd_bench_stop(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	if (!atomic_get(&bench_running)) {
+		shell_print(sh, "No benchmark running");
+		return 0;
+	}
+
+	udp_echo_stop_request(&bench_stop);
+	return 0;
+}
+
+static int cmd_bench_format(const struct shell *sh, size_t argc, char **argv)
+{
+	if (argc < 2) {
+		shell_print(sh, "%s", bench_json ? "json" : "csv");
+		return 0;
+	}
+
+	if (strcmp(argv[1], "csv") == 0) {
+		bench_json = false;
+	} else if (strcmp(argv[1], "json") == 0) {
+		bench_json = true;
+	} else {
+		shell_error(sh, "Unknown format %s, use csv or json", argv[1]);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(bench_cmds,
+	SHELL_CMD_ARG(latency, NULL,
+		      "Stop-and-wait RTT: [size] [count] [interval_ms]",
+		      cmd_bench_latency, 1, 3),
+	SHELL_CMD_ARG(throughput, NULL,
+		      "One-way stream: [size] [rate_kbps, 0 = max] [duration_ms]",
+		      cmd_bench_throughput, 1, 3),
+	SHELL_CMD_ARG(sweep, NULL,
+		      "Packet size sweep: [min_size] [max_size] [count] [window]",
+		      cmd_bench_sweep, 1, 4),
+	SHELL_CMD_ARG(window, NULL,
+		      "Window sweep 1, 2, 4...: [max_window] [size] [count]",
+		      cmd_bench_window, 1, 3),
+	SHELL_CMD(stop, NULL, "Stop the running benchmark", cmd_bench_stop),
+	SHELL_CMD_ARG(format, NULL, "Result format: [csv|json]",
+		      cmd_bench_format, 1, 1),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_STATIC_SUBCMD_SET_CREATE(p2p_cmds,
+	SHELL_CMD(bench, &bench_cmds, "Echo benchmarks", NULL),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(p2p, &p2p_cmds, "Wi-Fi Direct P2P echo commands", NULL);
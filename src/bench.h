@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef BENCH_H_
+#define BENCH_H_
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/socket.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Runtime benchmarks from the shell (`p2p bench ...`)
+ *
+ * Runs latency, throughput, packet size sweep and window sweep tests on
+ * the Client against the GO's echo server, with parameters given on the
+ * command line, and prints one CSV or JSON line per test point. The
+ * tests use their own socket and thread; the echo session started at
+ * connection must have finished or been stopped (BUTTON 1) first.
+ */
+
+#if defined(CONFIG_P2P_BENCH)
+
+/**
+ * @brief Set the echo server the benchmarks run against
+ *
+ * Called once the Client's echo server answered its probe. NULL clears
+ * it after a disconnect and stops a running benchmark.
+ *
+ * @param addr Server address, or NULL
+ */
+void bench_set_server(const struct sockaddr_in *addr);
+
+#else
+
+static inline void bench_set_server(const struct sockaddr_in *addr)
+{
+	ARG_UNUSED(addr);
+}
+
+#endif /* CONFIG_P2P_BENCH */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BENCH_H_ */
@@ -0,0 +1,287 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
+#include <string.h>
+
+#include "bringup_prof.h"
+#include "time_utils.h"
+
+LOG_MODULE_REGISTER(bringup_prof, CONFIG_LOG_DEFAULT_LEVEL);
+
+struct phase_agg {
+	uint32_t count;
+	uint32_t min_us;
+	uint32_t max_us;
+	uint64_t total_us;
+};
+
+struct path_agg {
+	uint32_t attempts;
+	uint32_t completed;
+	/* Indexed by the milestone ending the phase; [START] is the total */
+	struct phase_agg phase[BRINGUP_PROF_MARK_COUNT];
+};
+
+/* One finished attempt, logged outside the lock */
+struct attempt {
+	enum bringup_prof_path path;
+	bool completed;
+	uint32_t stamped;
+	uint64_t stamps[BRINGUP_PROF_MARK_COUNT];
+};
+
+static const char *const mark_txt[] = {
+	[BRINGUP_PROF_START] = "start",
+	[BRINGUP_PROF_FIND] = "find",
+	[BRINGUP_PROF_PEER_FOUND] = "peer-found",
+	[BRINGUP_PROF_CONNECT] = "connect",
+	[BRINGUP_PROF_GROUP_FORMED] = "group-formed",
+	[BRINGUP_PROF_STA_CONNECTED] = "sta-connected",
+	[BRINGUP_PROF_IP_CONFIGURED] = "ip-configured",
+	[BRINGUP_PROF_DHCP_BOUND] = "dhcp-bound",
+	[BRINGUP_PROF_ECHO_REPLY] = "echo-reply",
+};
+
+static const char *const path_txt[] = {
+	[BRINGUP_PROF_PATH_PAIRING] = "pairing",
+	[BRINGUP_PROF_PATH_REINVOKE] = "reinvoke",
+	[BRINGUP_PROF_PATH_AUTONOMOUS] = "autonomous",
+};
+
+static struct k_spinlock prof_lock;
+static struct attempt cur;
+static bool active;
+static struct path_agg aggs[BRINGUP_PROF_PATH_COUNT];
+
+#define US_MS(us) (uint32_t)((us) / 1000), (uint32_t)((us) % 1000)
+
+static void phase_add(struct phase_agg *agg, uint32_t us)
+{
+	if (agg->count == 0 || us < agg->min_us) {
+		agg->min_us = us;
+	}
+	agg->max_us = MAX(agg->max_us, us);
+	agg->total_us += us;
+	agg->count++;
+}
+
+/* Stamp of the closest earlier milestone; START is always set */
+static uint64_t phase_start(const struct attempt *a, int mark)
+{
+	for (mark--; mark > BRINGUP_PROF_START; mark--) {
+		if (a->stamped & BIT(mark)) {
+			break;
+		}
+	}
+
+	return a->stamps[mark];
+}
+
+static int last_mark(const struct attempt *a)
+{
+	int mark = BRINGUP_PROF_MARK_COUNT - 1;
+
+	while (mark > BRINGUP_PROF_START && !(a->stamped & BIT(mark))) {
+		mark--;
+	}
+
+	return mark;
+}
+
+static void agg_print(enum bringup_prof_path path, const struct path_agg *agg)
+{
+	const struct phase_agg *p;
+	int mark;
+
+	LOG_INF("Bring-up aggregate (%s): %u attempts, %u complete",
+		path_txt[path], agg->attempts, agg->completed);
+
+	for (mark = BRINGUP_PROF_START + 1; mark < BRINGUP_PROF_MARK_COUNT; mark++) {
+		p = &agg->phase[mark];
+		if (p->count == 0) {
+			continue;
+		}
+		LOG_INF("  %-14s n=%u min %u.%03u avg %u.%03u max %u.%03u ms",
+			mark_txt[mark], p->count, US_MS(p->min_us),
+			US_MS(p->total_us / p->count), US_MS(p->max_us));
+	}
+
+	p = &agg->phase[BRINGUP_PROF_START];
+	if (p->count > 0) {
+		LOG_INF("  %-14s n=%u min %u.%03u avg %u.%03u max %u.%03u ms",
+			"total", p->count, US_MS(p->min_us),
+			US_MS(p->total_us / p->count), US_MS(p->max_us));
+	}
+}
+
+static void attempt_print(const struct attempt *a)
+{
+	uint64_t start = a->stamps[BRINGUP_PROF_START];
+	int last = last_mark(a);
+	uint32_t total_us = time_utils_delta_us(start, a->stamps[last]);
+	int mark;
+
+	if (a->completed) {
+		LOG_INF("Bring-up profile (%s): %u.%03u ms to first echo reply",
+			path_txt[a->path], US_MS(total_us));
+	} else {
+		LOG_WRN("Bring-up profile (%s): failed after %s at %u.%03u ms",
+			path_txt[a->path], mark_txt[last], US_MS(total_us));
+	}
+
+	for (mark = BRINGUP_PROF_START + 1; mark < BRINGUP_PROF_MARK_COUNT; mark++) {
+		if (!(a->stamped & BIT(mark))) {
+			continue;
+		}
+		LOG_INF("  %-14s +%u.%03u ms (at %u.%03u ms)", mark_txt[mark],
+			US_MS(time_utils_delta_us(phase_start(a, mark), a->stamps[mark])),
+			US_MS(time_utils_delta_us(start, a->stamps[mark])));
+	}
+}
+
+/* Called with prof_lock held */
+static void attempt_finish(bool completed, struct attempt *out,
+			   struct path_agg *agg_out)
+{
+	struct path_agg *agg = &aggs[cur.path];
+	int mark;
+
+	active = false;
+	cur.completed = completed;
+
+	agg->attempts++;
+	if (completed) {
+		/* Only completed attempts show where the connection time goes */
+		agg->completed++;
+		for (mark = BRINGUP_PROF_START + 1; mark < BRINGUP_PROF_MARK_COUNT;
+		     mark++) {
+			if (cur.stamped & BIT(mark)) {
+				phase_add(&agg->phase[mark],
+					  time_utils_delta_us(phase_start(&cur, mark),
+							      cur.stamps[mark]));
+			}
+		}
+		phase_add(&agg->phase[BRINGUP_PROF_START],
+			  time_utils_delta_us(cur.stamps[BRINGUP_PROF_START],
+					      cur.stamps[BRINGUP_PROF_ECHO_REPLY]));
+	}
+
+	*out = cur;
+	*agg_out = *agg;
+}
+
+static void attempt_report(const struct attempt *a, const struct path_agg *agg)
+{
+	attempt_print(a);
+	agg_print(a->path, agg);
+}
+
+void bringup_prof_begin(enum bringup_prof_path path)
+{
+	uint64_t now = time_utils_now();
+	struct path_agg agg;
+	struct attempt prev;
+	bool abandoned = false;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&prof_lock);
+	if (active) {
+		attempt_finish(false, &prev, &agg);
+		abandoned = true;
+	}
+
+	cur.path = path;
+	cur.stamped = BIT(BRINGUP_PROF_START);
+	cur.stamps[BRINGUP_PROF_START] = now;
+	active = true;
+	k_spin_unlock(&prof_lock, key);
+
+	if (abandoned) {
+		attempt_report(&prev, &agg);
+	}
+}
+
+void bringup_prof_set_path(enum bringup_prof_path path)
+{
+	k_spinlock_key_t key = k_spin_lock(&prof_lock);
+
+	if (active) {
+		cur.path = path;
+	}
+	k_spin_unlock(&prof_lock, key);
+}
+
+void bringup_prof_mark(enum bringup_prof_mark mark)
+{
+	uint64_t now = time_utils_now();
+	struct path_agg agg;
+	struct attempt done;
+	bool finished = false;
+	k_spinlock_key_t key;
+
+	if (mark <= BRINGUP_PROF_START || mark >= BRINGUP_PROF_MARK_COUNT) {
+		return;
+	}
+
+	key = k_spin_lock(&prof_lock);
+	if (!active || (cur.stamped & BIT(mark))) {
+		k_spin_unlock(&prof_lock, key);
+		return;
+	}
+
+	/* Later milestones belong to an abandoned branch of the path */
+	cur.stamped &= BIT(mark) - 1;
+	cur.stamped |= BIT(mark);
+	cur.stamps[mark] = now;
+
+	if (mark == BRINGUP_PROF_ECHO_REPLY) {
+		attempt_finish(true, &done, &agg);
+		finished = true;
+	}
+	k_spin_unlock(&prof_lock, key);
+
+	if (finished) {
+		attempt_report(&done, &agg);
+	}
+}
+
+void bringup_prof_fail(void)
+{
+	struct path_agg agg;
+	struct attempt done;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&prof_lock);
+	if (!active) {
+		k_spin_unlock(&prof_lock, key);
+		return;
+	}
+
+	attempt_finish(false, &done, &agg);
+	k_spin_unlock(&prof_lock, key);
+
+	attempt_report(&done, &agg);
+}
+
+void bringup_prof_print(void)
+{
+	struct path_agg snapshot;
+	k_spinlock_key_t key;
+	int path;
+
+	for (path = 0; path < BRINGUP_PROF_PATH_COUNT; path++) {
+		key = k_spin_lock(&prof_lock);
+		memcpy(&snapshot, &aggs[path], sizeof(snapshot));
+		k_spin_unlock(&prof_lock, key);
+
+		if (snapshot.attempts > 0) {
+			agg_print(path, &snapshot);
+		}
+	}
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef BRINGUP_PROF_H_
+#define BRINGUP_PROF_H_
+
+#include <zephyr/kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Connection bring-up latency profiler
+ *
+ * Timestamps each milestone of a connection attempt, from the pairing
+ * start to the first echo reply, with the RTT timing backend (the
+ * hardware cycle counter where available). Milestones are stamped where
+ * the request is issued or the event arrives, in the P2P, network and
+ * echo layers. The phase breakdown is logged when the attempt completes
+ * or fails, together with per-path aggregates across all attempts.
+ */
+
+/** Bring-up milestones, in path order */
+enum bringup_prof_mark {
+	/** Pairing or group start requested */
+	BRINGUP_PROF_START,
+	/** P2P discovery started */
+	BRINGUP_PROF_FIND,
+	/** First peer reported by discovery */
+	BRINGUP_PROF_PEER_FOUND,
+	/** Connect, join, reinvoke or group add requested */
+	BRINGUP_PROF_CONNECT,
+	/** Group up: GO mode enabled or Client connected */
+	BRINGUP_PROF_GROUP_FORMED,
+	/** AP-STA-CONNECTED on the GO */
+	BRINGUP_PROF_STA_CONNECTED,
+	/** Static, cached or link-local address configured */
+	BRINGUP_PROF_IP_CONFIGURED,
+	/** DHCP lease bound on the Client */
+	BRINGUP_PROF_DHCP_BOUND,
+	/** First echo reply received (Client) or sent (GO) */
+	BRINGUP_PROF_ECHO_REPLY,
+	BRINGUP_PROF_MARK_COUNT,
+};
+
+/** How the connection is brought up; aggregated separately */
+enum bringup_prof_path {
+	/** Discovery, GO negotiation or join, and WPS */
+	BRINGUP_PROF_PATH_PAIRING,
+	/** Reinvoked persistent group (fast reconnect) */
+	BRINGUP_PROF_PATH_REINVOKE,
+	/** Autonomous GO */
+	BRINGUP_PROF_PATH_AUTONOMOUS,
+	BRINGUP_PROF_PATH_COUNT,
+};
+
+#if defined(CONFIG_P2P_BRINGUP_PROF)
+
+/**
+ * @brief Start profiling a connection attempt
+ *
+ * Stamps BRINGUP_PROF_START. An attempt still in progress is recorded
+ * as failed first.
+ *
+ * @param path Bring-up path the attempt starts on
+ */
+void bringup_prof_begin(enum bringup_prof_path path);
+
+/**
+ * @brief Switch the running attempt to another bring-up path
+ *
+ * Used when a reinvoke falls back to full pairing.
+ *
+ * @param path New bring-up path
+ */
+void bringup_prof_set_path(enum bringup_prof_path path);
+
+/**
+ * @brief Stamp a milestone of the running attempt
+ *
+ * Only the first occurrence of a milestone counts. Stamping a milestone
+ * clears the later ones, so a path that starts over (for example
+ * discovery after a failed reinvoke) is measured from where it resumed.
+ * BRINGUP_PROF_ECHO_REPLY completes the attempt. No-op without a running
+ * attempt; safe from any thread.
+ *
+ * @param mark Milestone reached
+ */
+void bringup_prof_mark(enum bringup_prof_mark mark);
+
+/**
+ * @brief Record the running attempt as failed
+ *
+ * No-op without a running attempt.
+ */
+void bringup_prof_fail(void);
+
+/**
+ * @brief Log the aggregates of all attempts so far
+ */
+void bringup_prof_print(void);
+
+#else
+
+static inline void bringup_prof_begin(enum bringup_prof_path path)
+{
+	ARG_UNUSED(path);
+}
+
+static inline void bringup_prof_set_path(enum bringup_prof_path path)
+{
+	ARG_UNUSED(path);
+}
+
+static inline void bringup_prof_mark(enum bringup_prof_mark mark)
+{
+	ARG_UNUSED(mark);
+}
+
+static inline void bringup_prof_fail(void)
+{
+}
+
+static inline void bringup_prof_print(void)
+{
+}
+
+#endif /* CONFIG_P2P_BRINGUP_PROF */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BRINGUP_PROF_H_ */
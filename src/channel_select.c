@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_mgmt.h>
+#include <zephyr/net/wifi.h>
+#include <zephyr/net/wifi_mgmt.h>
+#include <zephyr/sys/util.h>
+#include <stdlib.h>
+
+#include "channel_select.h"
+#include "wifi_p2p_utils.h"
+
+LOG_MODULE_REGISTER(channel_select, CONFIG_LOG_DEFAULT_LEVEL);
+
+#define CHANNEL_SCAN_EVENTS (NET_EVENT_WIFI_SCAN_RESULT | NET_EVENT_WIFI_SCAN_DONE)
+
+/* Weight of an access point at the floor RSSI and above */
+#define AP_RSSI_FLOOR (-100)
+#define AP_WEIGHT_MAX 70
+
+/* 2.4 GHz channels are 5 MHz apart but 20 MHz wide: an AP this many
+ * channels away still overlaps the candidate
+ */
+#define CHANNEL_OVERLAP_2G 4
+
+struct channel_cand {
+	uint8_t channel;
+	bool allowed;
+	uint32_t load;
+	uint16_t aps;
+};
+
+static struct channel_cand cands[] = {
+	{ .channel = 1 }, { .channel = 6 }, { .channel = 11 },
+#if defined(CONFIG_P2P_CHANNEL_AUTO_5GHZ)
+	{ .channel = 36 }, { .channel = 40 }, { .channel = 44 }, { .channel = 48 },
+	{ .channel = 149 }, { .channel = 153 }, { .channel = 157 },
+	{ .channel = 161 }, { .channel = 165 },
+#endif
+};
+
+static K_SEM_DEFINE(scan_done_sem, 0, 1);
+static struct net_mgmt_event_callback scan_cb;
+static int scan_status;
+
+static void channel_account_ap(const struct wifi_scan_result *res)
+{
+	uint32_t weight = CLAMP(res->rssi - AP_RSSI_FLOOR, 1, AP_WEIGHT_MAX);
+	int dist;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(cands); i++) {
+		/* 5 GHz channels (20 MHz apart) only collide on the same one */
+		if ((cands[i].channel > 14) != (res->channel > 14)) {
+			continue;
+		}
+
+		dist = abs((int)cands[i].channel - (int)res->channel);
+		if (cands[i].channel > 14 ? dist != 0 : dist >= CHANNEL_OVERLAP_2G) {
+			continue;
+		}
+
+		/* Scale by the overlap, a full co-channel AP counts 4x */
+		cands[i].load += weight * (cands[i].channel > 14 ?
+					   CHANNEL_OVERLAP_2G :
+					   CHANNEL_OVERLAP_2G - dist);
+		if (dist == 0) {
+			cands[i].aps++;
+		}
+	}
+}
+
+static void channel_scan_event_handler(struct net_mgmt_event_callback *cb,
+				       uint64_t mgmt_event, struct net_if *iface)
+{
+	ARG_UNUSED(iface);
+
+	switch (mgmt_event) {
+	case NET_EVENT_WIFI_SCAN_RESULT:
+		channel_account_ap((const struct wifi_scan_result *)cb->info);
+		break;
+	case NET_EVENT_WIFI_SCAN_DONE:
+		scan_status = ((const struct wifi_status *)cb->info)->status;
+		k_sem_give(&scan_done_sem);
+		break;
+	default:
+		break;
+	}
+}
+
+/* Mark the candidates the regulatory domain lets us start a group on */
+static void channel_apply_reg_domain(struct net_if *iface)
+{
+	static struct wifi_reg_chan_info chan_info[MAX_REG_CHAN_NUM];
+	struct wifi_reg_domain regd = {
+		.oper = WIFI_MGMT_GET,
+		.chan_info = chan_info,
+	};
+	uint32_t freq;
+	int ret;
+	int i, j;
+
+	ret = net_mgmt(NET_REQUEST_WIFI_REG_DOMAIN, iface, &regd, sizeof(regd));
+	if (ret) {
+		/* Without channel info only trust the 2.4 GHz social channels */
+		LOG_WRN("Regulatory domain unavailable (%d), using 2.4 GHz only", ret);
+		for (i = 0; i < ARRAY_SIZE(cands); i++) {
+			cands[i].allowed = cands[i].channel <= 14;
+		}
+		return;
+	}
+
+	for (i = 0; i < ARRAY_SIZE(cands); i++) {
+		freq = wifi_p2p_channel_to_freq(cands[i].channel);
+		cands[i].allowed = false;
+
+		for (j = 0; j < MIN(regd.num_channels, ARRAY_SIZE(chan_info)); j++) {
+			if (chan_info[j].center_frequency == freq) {
+				cands[i].allowed = chan_info[j].supported &&
+						   !chan_info[j].passive_only &&
+						   !chan_info[j].dfs;
+				break;
+			}
+		}
+	}
+}
+
+int channel_select_best(uint32_t *freq)
+{
+	struct net_if *iface = net_if_get_first_wifi();
+	struct wifi_scan_params params = { 0 };
+	struct channel_cand *best = NULL;
+	int64_t start = k_uptime_get();
+	int ret;
+	int i;
+
+	if (!iface) {
+		LOG_ERR("No Wi-Fi interface found");
+		return -ENODEV;
+	}
+
+	for (i = 0; i < ARRAY_SIZE(cands); i++) {
+		cands[i].load = 0;
+		cands[i].aps = 0;
+	}
+
+	channel_apply_reg_domain(iface);
+
+	params.scan_type = WIFI_SCAN_TYPE_ACTIVE;
+	params.bands = BIT(WIFI_FREQ_BAND_2_4_GHZ);
+	if (IS_ENABLED(CONFIG_P2P_CHANNEL_AUTO_5GHZ)) {
+		params.bands |= BIT(WIFI_FREQ_BAND_5_GHZ);
+	}
+	params.dwell_time_active = CONFIG_P2P_CHANNEL_SCAN_DWELL_MS;
+
+	k_sem_reset(&scan_done_sem);
+	net_mgmt_init_event_callback(&scan_cb, channel_scan_event_handler,
+				     CHANNEL_SCAN_EVENTS);
+	net_mgmt_add_event_callback(&scan_cb);
+
+	LOG_INF("Scanning for the least congested channel...");
+
+	ret = net_mgmt(NET_REQUEST_WIFI_SCAN, iface, &params, sizeof(params));
+	if (ret) {
+		LOG_ERR("Channel scan request failed: %d", ret);
+		goto out;
+	}
+
+	if (k_sem_take(&scan_done_sem, K_MSEC(CONFIG_P2P_CHANNEL_SCAN_TIMEOUT_MS)) != 0) {
+		LOG_WRN("Channel scan timed out");
+		ret = -ETIMEDOUT;
+		goto out;
+	}
+
+	if (scan_status) {
+		LOG_WRN("Channel scan failed: %d", scan_status);
+		ret = -EIO;
+		goto out;
+	}
+
+	/* Ties go to the configured channel, then to the earlier candidate */
+	for (i = 0; i < ARRAY_SIZE(cands); i++) {
+		if (!cands[i].allowed) {
+			continue;
+		}
+
+		LOG_INF("  Channel %3d: load %u (%u AP(s))", cands[i].channel,
+			cands[i].load, cands[i].aps);
+
+		if (!best || cands[i].load < best->load ||
+		    (cands[i].load == best->load &&
+		     cands[i].channel == CONFIG_P2P_OPERATING_CHANNEL)) {
+			best = &cands[i];
+		}
+	}
+
+	if (!best) {
+		ret = -ENOENT;
+		goto out;
+	}
+
+	*freq = wifi_p2p_channel_to_freq(best->channel);
+	LOG_INF("Selected channel %d (%u MHz) in %lld ms", best->channel, *freq,
+		k_uptime_get() - start);
+
+out:
+	net_mgmt_del_event_callback(&scan_cb);
+
+	return ret;
+}
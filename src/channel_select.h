@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef CHANNEL_SELECT_H_
+#define CHANNEL_SELECT_H_
+
+#include <zephyr/kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Operating channel selection for the P2P group
+ *
+ * Scans for access points, weighs each one by its signal strength and by
+ * how much its channel overlaps each candidate, and picks the least
+ * congested candidate. Candidates are the 2.4 GHz social channels 1, 6
+ * and 11 and, with CONFIG_P2P_CHANNEL_AUTO_5GHZ, the non-DFS 5 GHz
+ * channels the regulatory domain allows without passive scanning.
+ */
+
+/**
+ * @brief Scan and pick the least congested operating channel
+ *
+ * @param freq Output: center frequency of the chosen channel in MHz
+ * @return 0 on success, -ETIMEDOUT if the scan did not complete, or
+ *         negative error code on failure
+ */
+int channel_select_best(uint32_t *freq);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CHANNEL_SELECT_H_ */
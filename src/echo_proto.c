@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/crc.h>
+#include <string.h>
+
+#include "echo_proto.h"
+#include "time_utils.h"
+
+/* Offset of the crc field, which is hashed as zero */
+#define ECHO_PROTO_CRC_OFFSET offsetof(struct echo_proto_hdr, crc)
+
+static uint16_t echo_proto_crc(const uint8_t *buf, size_t len)
+{
+	static const uint8_t zero[sizeof(uint16_t)];
+	uint16_t crc;
+
+	crc = crc16_ccitt(0xffff, buf, ECHO_PROTO_CRC_OFFSET);
+	crc = crc16_ccitt(crc, zero, sizeof(zero));
+
+	return crc16_ccitt(crc, buf + ECHO_PROTO_CRC_OFFSET + sizeof(zero),
+			   len - ECHO_PROTO_CRC_OFFSET - sizeof(zero));
+}
+
+void echo_proto_write(void *buf, size_t len, enum echo_proto_type type,
+		      uint16_t flags, uint32_t seq, uint64_t tx_time)
+{
+	uint8_t *p = buf;
+
+	sys_put_le16(ECHO_PROTO_MAGIC, p);
+	p[2] = ECHO_PROTO_VERSION;
+	p[3] = type;
+	sys_put_le16(flags, p + 4);
+	sys_put_le32(seq, p + 8);
+	sys_put_le64(tx_time, p + 12);
+
+	len = (flags & ECHO_PROTO_FLAG_FULL_CRC) ? len : ECHO_PROTO_HDR_LEN;
+	sys_put_le16(echo_proto_crc(buf, len), p + ECHO_PROTO_CRC_OFFSET);
+}
+
+int echo_proto_parse(const void *buf, size_t len, struct echo_proto_hdr *hdr)
+{
+	const uint8_t *p = buf;
+
+	if (len < ECHO_PROTO_HDR_LEN ||
+	    sys_get_le16(p) != ECHO_PROTO_MAGIC ||
+	    p[2] != ECHO_PROTO_VERSION) {
+		return -EINVAL;
+	}
+
+	hdr->magic = ECHO_PROTO_MAGIC;
+	hdr->version = p[2];
+	hdr->type = p[3];
+	hdr->flags = sys_get_le16(p + 4);
+	hdr->crc = sys_get_le16(p + ECHO_PROTO_CRC_OFFSET);
+	hdr->seq = sys_get_le32(p + 8);
+	hdr->tx_time = sys_get_le64(p + 12);
+
+	len = (hdr->flags & ECHO_PROTO_FLAG_FULL_CRC) ? len : ECHO_PROTO_HDR_LEN;
+	if (echo_proto_crc(buf, len) != hdr->crc) {
+		return -EBADMSG;
+	}
+
+	return 0;
+}
+
+uint16_t echo_proto_crc_begin(const void *buf)
+{
+	return echo_proto_crc(buf, ECHO_PROTO_HDR_LEN);
+}
+
+uint32_t echo_proto_one_way_us(const struct echo_proto_hdr *hdr,
+			       uint64_t rx_time)
+{
+	return time_utils_delta_us(hdr->tx_time, rx_time);
+}
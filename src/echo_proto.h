@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef ECHO_PROTO_H_
+#define ECHO_PROTO_H_
+
+#include <zephyr/kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Binary header shared by all traffic modes
+ *
+ * Every echo request and throughput stream datagram starts with this
+ * fixed-layout, little-endian header. The rest of the datagram is padding
+ * that is built once per run.
+ */
+
+/** Magic value identifying our datagrams ("P2") */
+#define ECHO_PROTO_MAGIC 0x5032
+
+/** Current header version */
+#define ECHO_PROTO_VERSION 1
+
+/** Datagram types */
+enum echo_proto_type {
+	/** Echo request, reflected by the server */
+	ECHO_PROTO_TYPE_ECHO = 1,
+	/** One-way throughput stream packet, consumed by the server */
+	ECHO_PROTO_TYPE_STREAM = 2,
+	/** Server readiness probe, reflected like an echo request */
+	ECHO_PROTO_TYPE_PROBE = 3,
+	/** Persistent group credential request/reply (see p2p_persist.h) */
+	ECHO_PROTO_TYPE_GROUP = 4,
+	/** Reliable transport message (see udp_reliable.h) */
+	ECHO_PROTO_TYPE_REL_DATA = 5,
+	/** Reliable transport cumulative and selective ACK */
+	ECHO_PROTO_TYPE_REL_ACK = 6,
+	/** Reliable transport XOR parity of a block of messages */
+	ECHO_PROTO_TYPE_REL_FEC = 7,
+};
+
+/** Flag: last packet(s) of a stream */
+#define ECHO_PROTO_FLAG_END BIT(0)
+/** Flag: the CRC also covers the payload following the header */
+#define ECHO_PROTO_FLAG_FULL_CRC BIT(1)
+
+/** Datagram header (little-endian on the wire) */
+struct echo_proto_hdr {
+	/** ECHO_PROTO_MAGIC */
+	uint16_t magic;
+	/** ECHO_PROTO_VERSION */
+	uint8_t version;
+	/** enum echo_proto_type */
+	uint8_t type;
+	/** ECHO_PROTO_FLAG_* */
+	uint16_t flags;
+	/** CRC-16/CCITT of the header (this field zeroed), see FULL_CRC */
+	uint16_t crc;
+	/** Sequence number */
+	uint32_t seq;
+	/** Sender timestamp in time_utils_now() units */
+	uint64_t tx_time;
+} __packed;
+
+/** Size of the header on the wire */
+#define ECHO_PROTO_HDR_LEN sizeof(struct echo_proto_hdr)
+
+/**
+ * Size of a readiness probe: the header, then the sender's
+ * time_utils_hz() as little-endian uint32 (0 = unknown). The socket echo
+ * server puts its own rate there in the reply; the zero-copy reflector
+ * returns the probe unchanged.
+ */
+#define ECHO_PROTO_PROBE_LEN (ECHO_PROTO_HDR_LEN + sizeof(uint32_t))
+
+/**
+ * @brief Write the header at the start of a datagram
+ *
+ * With ECHO_PROTO_FLAG_FULL_CRC the CRC covers all @p len bytes, so the
+ * payload must be final before calling this.
+ *
+ * @param buf Datagram buffer
+ * @param len Datagram length, at least ECHO_PROTO_HDR_LEN
+ * @param type Datagram type
+ * @param flags ECHO_PROTO_FLAG_* flags
+ * @param seq Sequence number
+ * @param tx_time Sender timestamp (see time_utils_now())
+ */
+void echo_proto_write(void *buf, size_t len, enum echo_proto_type type,
+		      uint16_t flags, uint32_t seq, uint64_t tx_time);
+
+/**
+ * @brief Validate and decode a datagram header
+ *
+ * @param buf Received datagram
+ * @param len Number of valid bytes in @p buf
+ * @param hdr Output: decoded header in CPU byte order
+ * @return 0 on success, -EINVAL if the datagram is not ours (too short,
+ *         bad magic or unknown version), -EBADMSG on CRC mismatch
+ */
+int echo_proto_parse(const void *buf, size_t len, struct echo_proto_hdr *hdr);
+
+/**
+ * @brief CRC of a datagram header, to extend over a payload in pieces
+ *
+ * For ECHO_PROTO_FLAG_FULL_CRC datagrams that are not contiguous in
+ * memory: continue the result with crc16_ccitt() over the payload and
+ * compare it with the crc field.
+ *
+ * @param buf First ECHO_PROTO_HDR_LEN bytes of the datagram
+ * @return CRC of the header, with the crc field hashed as zero
+ */
+uint16_t echo_proto_crc_begin(const void *buf);
+
+/**
+ * @brief One-way delay of a received datagram
+ *
+ * Only meaningful when the sender and receiver clocks are synchronized.
+ *
+ * @param hdr Decoded header
+ * @param rx_time Receive timestamp (see time_utils_now())
+ * @return One-way delay in microseconds, 0 if negative
+ */
+uint32_t echo_proto_one_way_us(const struct echo_proto_hdr *hdr,
+			       uint64_t rx_time);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ECHO_PROTO_H_ */
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <string.h>
+
+#include "echo_trace.h"
+#include "time_utils.h"
+
+LOG_MODULE_REGISTER(echo_trace, CONFIG_LOG_DEFAULT_LEVEL);
+
+/* Records logged between pauses, so the deferred log buffer can drain */
+#define ECHO_TRACE_DUMP_BURST 16
+
+static struct echo_trace_entry trace_ring[CONFIG_UDP_ECHO_TRACE_ENTRIES];
+static atomic_t trace_head;
+
+static const char *const event_names[] = {
+	[ECHO_TRACE_TX] = "tx",
+	[ECHO_TRACE_RX] = "rx",
+	[ECHO_TRACE_REPLY] = "reply",
+	[ECHO_TRACE_TIMEOUT] = "timeout",
+	[ECHO_TRACE_LATE] = "late",
+	[ECHO_TRACE_DUP] = "dup",
+	[ECHO_TRACE_ERROR] = "error",
+	[ECHO_TRACE_CORRUPT] = "corrupt",
+};
+
+void echo_trace_record(enum echo_trace_event event, uint32_t seq, uint32_t value)
+{
+	uint32_t idx = (uint32_t)atomic_inc(&trace_head) %
+		       CONFIG_UDP_ECHO_TRACE_ENTRIES;
+	struct echo_trace_entry *entry = &trace_ring[idx];
+
+	entry->time = (uint32_t)time_utils_now();
+	entry->seq = seq;
+	entry->value = value;
+	entry->event = event;
+}
+
+void echo_trace_reset(void)
+{
+	atomic_set(&trace_head, 0);
+	memset(trace_ring, 0, sizeof(trace_ring));
+}
+
+void echo_trace_dump(void)
+{
+	uint32_t head = (uint32_t)atomic_get(&trace_head);
+	uint32_t count = MIN(head, CONFIG_UDP_ECHO_TRACE_ENTRIES);
+	uint32_t first = head - count;
+	uint32_t base = 0;
+
+	LOG_INF("Packet trace: %u of %u events", count, head);
+
+	for (uint32_t i = 0; i < count; i++) {
+		const struct echo_trace_entry *entry =
+			&trace_ring[(first + i) % CONFIG_UDP_ECHO_TRACE_ENTRIES];
+		const char *name = "?";
+
+		if (entry->event < ARRAY_SIZE(event_names) &&
+		    event_names[entry->event]) {
+			name = event_names[entry->event];
+		}
+
+		if (i == 0) {
+			base = entry->time;
+		}
+
+		/* Times are relative to the oldest record */
+		LOG_INF("  +%8u us %-7s seq=%u val=%d",
+			(uint32_t)time_utils_to_us((uint32_t)(entry->time - base)),
+			name, entry->seq, (int32_t)entry->value);
+
+		if ((i + 1) % ECHO_TRACE_DUMP_BURST == 0) {
+			k_msleep(10);
+		}
+	}
+}
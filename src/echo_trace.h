@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef ECHO_TRACE_H_
+#define ECHO_TRACE_H_
+
+#include <zephyr/kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Per-packet event trace
+ *
+ * Fixed-size ring of binary records written from the packet hot paths
+ * instead of formatted log messages. Recording costs an atomic increment
+ * and a 16-byte store; the ring is only formatted when dumped.
+ */
+
+/** Trace event types */
+enum echo_trace_event {
+	/** Echo request sent (value: bytes) */
+	ECHO_TRACE_TX = 1,
+	/** Datagram received by the server (value: bytes) */
+	ECHO_TRACE_RX,
+	/** Echo reply matched (value: RTT in us) */
+	ECHO_TRACE_REPLY,
+	/** Echo request timed out */
+	ECHO_TRACE_TIMEOUT,
+	/** Reply for an expired or reused slot */
+	ECHO_TRACE_LATE,
+	/** Duplicate reply */
+	ECHO_TRACE_DUP,
+	/** Send or receive error (value: negative errno) */
+	ECHO_TRACE_ERROR,
+	/** Datagram failed the header CRC check (value: bytes) */
+	ECHO_TRACE_CORRUPT,
+};
+
+/** Trace record */
+struct echo_trace_entry {
+	/** Low 32 bits of time_utils_now() */
+	uint32_t time;
+	/** Sequence number, if any */
+	uint32_t seq;
+	/** Event dependent value */
+	uint32_t value;
+	/** enum echo_trace_event */
+	uint8_t event;
+	uint8_t reserved[3];
+};
+
+#if defined(CONFIG_UDP_ECHO_TRACE)
+
+/**
+ * @brief Record a trace event
+ *
+ * Safe to call from any thread; the oldest record is overwritten when the
+ * ring is full.
+ *
+ * @param event Event type
+ * @param seq Sequence number
+ * @param value Event dependent value
+ */
+void echo_trace_record(enum echo_trace_event event, uint32_t seq, uint32_t value);
+
+/**
+ * @brief Discard all recorded events
+ */
+void echo_trace_reset(void);
+
+/**
+ * @brief Log the recorded events, oldest first
+ *
+ * Must not be called while traffic is running.
+ */
+void echo_trace_dump(void);
+
+#else
+
+static inline void echo_trace_record(enum echo_trace_event event, uint32_t seq,
+				     uint32_t value)
+{
+	ARG_UNUSED(event);
+	ARG_UNUSED(seq);
+	ARG_UNUSED(value);
+}
+
+static inline void echo_trace_reset(void)
+{
+}
+
+static inline void echo_trace_dump(void)
+{
+}
+
+#endif /* CONFIG_UDP_ECHO_TRACE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ECHO_TRACE_H_ */
@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_mgmt.h>
+#include <zephyr/net/wifi_mgmt.h>
+#include <string.h>
+
+#include "link_health.h"
+
+LOG_MODULE_REGISTER(link_health, CONFIG_LOG_DEFAULT_LEVEL);
+
+/* One sampling interval */
+struct health_sample {
+	uint32_t sent;
+	uint32_t received;
+	uint64_t rtt_total_us;
+	/* dBm, 0 if unknown */
+	int8_t rssi;
+};
+
+static struct health_sample window[CONFIG_LINK_HEALTH_WINDOW];
+static int window_head;
+static int window_fill;
+
+static const struct udp_echo_stats *mon_stats;
+static link_health_recover_cb_t recover_cb;
+static struct udp_echo_stats snapshot;
+static uint64_t last_sent;
+static uint64_t last_received;
+static uint64_t last_rtt_total_us;
+
+/* Requests sent since the last reply */
+static uint32_t unanswered;
+/* Lowest interval RTT of the session, the inflation reference */
+static uint32_t rtt_floor_us;
+static int healthy_intervals;
+
+/* Escalation state, kept across session restarts */
+static enum link_health_action tier;
+static int64_t grace_until;
+static bool link_lost;
+static bool armed;
+
+/* Queue the checks and recovery run on, set by link_health_start() */
+static struct k_work_q *health_wq;
+
+static void health_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(health_work, health_work_handler);
+
+static const char *const action_txt[] = {
+	[LINK_HEALTH_REBIND] = "rebind socket",
+	[LINK_HEALTH_REJOIN] = "rejoin persistent group",
+	[LINK_HEALTH_REFORM] = "re-form group",
+};
+
+const char *link_health_action_txt(enum link_health_action action)
+{
+	if (action < ARRAY_SIZE(action_txt) && action_txt[action]) {
+		return action_txt[action];
+	}
+	return "none";
+}
+
+static int8_t health_read_rssi(void)
+{
+	struct net_if *iface = net_if_get_first_wifi();
+	struct wifi_iface_status status = { 0 };
+
+	if (!iface || net_mgmt(NET_REQUEST_WIFI_IFACE_STATUS, iface, &status,
+			       sizeof(status))) {
+		return 0;
+	}
+
+	return (int8_t)CLAMP(status.rssi, INT8_MIN, 0);
+}
+
+static void health_sample_take(void)
+{
+	struct health_sample *s = &window[window_head];
+	uint32_t rtt_us;
+
+	udp_echo_stats_snapshot(mon_stats, &snapshot);
+
+	s->sent = (uint32_t)(snapshot.packets_sent - last_sent);
+	s->received = (uint32_t)(snapshot.packets_received - last_received);
+	s->rtt_total_us = snapshot.rtt_total_us - last_rtt_total_us;
+	s->rssi = health_read_rssi();
+
+	last_sent = snapshot.packets_sent;
+	last_received = snapshot.packets_received;
+	last_rtt_total_us = snapshot.rtt_total_us;
+
+	if (s->received > 0) {
+		unanswered = 0;
+		rtt_us = (uint32_t)(s->rtt_total_us / s->received);
+		if (rtt_floor_us == 0 || rtt_us < rtt_floor_us) {
+			rtt_floor_us = rtt_us;
+		}
+	} else {
+		unanswered += s->sent;
+	}
+
+	window_head = (window_head + 1) % ARRAY_SIZE(window);
+	window_fill = MIN(window_fill + 1, ARRAY_SIZE(window));
+}
+
+/* Returns true if the window shows a dead or badly degraded link */
+static bool health_link_down(bool *clean)
+{
+	uint32_t sent = 0, received = 0, rssi_cnt = 0;
+	uint64_t rtt_total_us = 0;
+	int32_t rssi_sum = 0;
+	uint32_t loss_pct = 0;
+	bool rtt_inflated = false;
+	bool rssi_low = false;
+	int i;
+
+	for (i = 0; i < window_fill; i++) {
+		sent += window[i].sent;
+		received += window[i].received;
+		rtt_total_us += window[i].rtt_total_us;
+		if (window[i].rssi) {
+			rssi_sum += window[i].rssi;
+			rssi_cnt++;
+		}
+	}
+
+	if (sent > received) {
+		loss_pct = (sent - received) * 100 / sent;
+	}
+
+	if (received > 0 && rtt_floor_us > 0) {
+		rtt_inflated = rtt_total_us / received >
+			       (uint64_t)rtt_floor_us * CONFIG_LINK_HEALTH_RTT_FACTOR;
+	}
+
+	if (rssi_cnt > 0) {
+		rssi_low = rssi_sum / (int32_t)rssi_cnt < CONFIG_LINK_HEALTH_RSSI_MIN;
+	}
+
+	*clean = window_fill == ARRAY_SIZE(window) &&
+		 loss_pct < CONFIG_LINK_HEALTH_LOSS_PCT && unanswered == 0;
+
+	if (unanswered >= CONFIG_LINK_HEALTH_LOSS_BURST) {
+		LOG_WRN("Link down: %u requests unanswered", unanswered);
+		return true;
+	}
+
+	if (window_fill == ARRAY_SIZE(window) &&
+	    loss_pct >= CONFIG_LINK_HEALTH_LOSS_PCT && (rtt_inflated || rssi_low)) {
+		LOG_WRN("Link degraded: %u%% loss, RTT %s, RSSI %s", loss_pct,
+			rtt_inflated ? "inflated" : "normal",
+			rssi_low ? "low" : "normal");
+		return true;
+	}
+
+	return false;
+}
+
+static void health_escalate(void)
+{
+	enum link_health_action action;
+
+	action = MIN(tier + 1, LINK_HEALTH_REFORM);
+	if (link_lost) {
+		/* No group left to open a socket on */
+		action = MAX(action, LINK_HEALTH_REJOIN);
+	}
+
+	tier = action;
+	link_lost = false;
+	grace_until = k_uptime_get() + CONFIG_LINK_HEALTH_RECOVERY_MS;
+	healthy_intervals = 0;
+
+	LOG_WRN("Link recovery: %s", link_health_action_txt(action));
+
+	if (recover_cb) {
+		recover_cb(action);
+	}
+}
+
+static void health_work_handler(struct k_work *work)
+{
+	int64_t now = k_uptime_get();
+	bool clean = false;
+
+	ARG_UNUSED(work);
+
+	if (!mon_stats) {
+		/* No session: the group is gone or a rejoin has not completed.
+		 * A re-form is left to the pairing flow and not retried here.
+		 */
+		if (!armed || tier >= LINK_HEALTH_REFORM ||
+		    (tier < LINK_HEALTH_REJOIN && !link_lost)) {
+			return;
+		}
+		if (now >= grace_until) {
+			health_escalate();
+		}
+	} else {
+		health_sample_take();
+
+		if (health_link_down(&clean)) {
+			if (now >= grace_until) {
+				health_escalate();
+			}
+		} else if (clean && tier != 0 &&
+			   ++healthy_intervals >= CONFIG_LINK_HEALTH_WINDOW) {
+			LOG_INF("Link recovered after %s", link_health_action_txt(tier));
+			tier = 0;
+		}
+	}
+
+	if (mon_stats) {
+		k_work_schedule_for_queue(health_wq, &health_work,
+					  K_MSEC(CONFIG_LINK_HEALTH_INTERVAL_MS));
+	} else if (tier >= LINK_HEALTH_REJOIN && tier < LINK_HEALTH_REFORM) {
+		/* Escalate again if the rejoin has not restarted a session */
+		k_work_schedule_for_queue(health_wq, &health_work,
+					  K_TIMEOUT_ABS_MS(grace_until));
+	}
+}
+
+void link_health_start(const struct udp_echo_stats *stats,
+		       link_health_recover_cb_t cb, struct k_work_q *wq)
+{
+	memset(window, 0, sizeof(window));
+	window_head = 0;
+	window_fill = 0;
+	last_sent = 0;
+	last_received = 0;
+	last_rtt_total_us = 0;
+	unanswered = 0;
+	rtt_floor_us = 0;
+	healthy_intervals = 0;
+	link_lost = false;
+
+	/* A re-formed group is a fresh link, escalate from the start */
+	if (tier >= LINK_HEALTH_REFORM) {
+		LOG_INF("Link recovered after %s", link_health_action_txt(tier));
+		tier = 0;
+	}
+
+	mon_stats = stats;
+	recover_cb = cb;
+	health_wq = wq;
+	armed = true;
+
+	k_work_reschedule_for_queue(health_wq, &health_work,
+				    K_MSEC(CONFIG_LINK_HEALTH_INTERVAL_MS));
+}
+
+void link_health_stop(bool reset)
+{
+	mon_stats = NULL;
+
+	if (reset) {
+		armed = false;
+		tier = 0;
+		link_lost = false;
+		k_work_cancel_delayable(&health_work);
+		return;
+	}
+
+	/* Keep retrying while an escalation or a lost link is pending */
+	if (tier < LINK_HEALTH_REJOIN && !link_lost) {
+		k_work_cancel_delayable(&health_work);
+	}
+}
+
+void link_health_link_lost(void)
+{
+	if (!armed) {
+		return;
+	}
+
+	/* Expected while our own rejoin or re-form is in progress */
+	if (k_uptime_get() < grace_until) {
+		return;
+	}
+
+	LOG_WRN("Link lost");
+	link_lost = true;
+	k_work_reschedule_for_queue(health_wq, &health_work, K_NO_WAIT);
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef LINK_HEALTH_H_
+#define LINK_HEALTH_H_
+
+#include <zephyr/kernel.h>
+
+#include "udp_utils.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Client-side link health monitor with tiered recovery
+ *
+ * Samples the echo client statistics and the interface RSSI every
+ * CONFIG_LINK_HEALTH_INTERVAL_MS into a sliding window of
+ * CONFIG_LINK_HEALTH_WINDOW intervals. The link is declared down when
+ * - CONFIG_LINK_HEALTH_LOSS_BURST requests in a row are unanswered, or
+ * - the window loss exceeds CONFIG_LINK_HEALTH_LOSS_PCT while the RTT
+ *   is inflated beyond CONFIG_LINK_HEALTH_RTT_FACTOR times its session
+ *   minimum or the RSSI is below CONFIG_LINK_HEALTH_RSSI_MIN.
+ *
+ * Each time the link is down the next recovery action is requested,
+ * after a grace period of CONFIG_LINK_HEALTH_RECOVERY_MS for the
+ * previous one. A full healthy window resets the escalation.
+ */
+
+/** Recovery actions, in escalation order */
+enum link_health_action {
+	/** Reopen the UDP socket and probe the server again */
+	LINK_HEALTH_REBIND = 1,
+	/** Leave the group and reinvoke the stored persistent group */
+	LINK_HEALTH_REJOIN,
+	/** Leave the group and run full discovery and pairing */
+	LINK_HEALTH_REFORM,
+};
+
+/**
+ * @brief Recovery callback, called from the work queue passed to
+ *        link_health_start()
+ *
+ * @param action Requested recovery action
+ */
+typedef void (*link_health_recover_cb_t)(enum link_health_action action);
+
+/**
+ * @brief Start monitoring an echo session
+ *
+ * Starts a fresh window. An escalation in progress is kept, so a
+ * session restarted by a recovery action continues from its tier.
+ *
+ * @param stats Live statistics of the echo client
+ * @param cb Recovery callback
+ * @param wq Work queue for the checks and @p cb. Use the queue that
+ *           starts and stops the echo session, so recovery is serialized
+ *           with it.
+ */
+void link_health_start(const struct udp_echo_stats *stats,
+		       link_health_recover_cb_t cb, struct k_work_q *wq);
+
+/**
+ * @brief Stop monitoring
+ *
+ * @param reset Also forget the escalation in progress
+ */
+void link_health_stop(bool reset);
+
+/**
+ * @brief Report that the group was lost
+ *
+ * Skips the socket tier and requests at least LINK_HEALTH_REJOIN.
+ * Does nothing unless a session has been monitored.
+ */
+void link_health_link_lost(void);
+
+/**
+ * @brief Get a readable name of a recovery action
+ *
+ * @param action Recovery action
+ * @return Action name
+ */
+const char *link_health_action_txt(enum link_health_action action);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LINK_HEALTH_H_ */
@@ -34,6 +34,19 @@ LOG_MODULE_REGISTER(main, CONFIG_LOG_DEFAULT_LEVEL);
 #include "wifi_p2p_utils.h"
 #include "net_utils.h"
 #include "udp_utils.h"
+#include "udp_zerocopy.h"
+#include "udp_reliable.h"
+#include "tcp_utils.h"
+#include "echo_trace.h"
+#include "p2p_persist.h"
+#include "peer_table.h"
+#include "peer_score.h"
+#include "channel_select.h"
+#include "link_health.h"
+#include "bench.h"
+#include "bringup_prof.h"
+#include "power_mgr.h"
+#include "thread_stats.h"
 
 /* Helper function to format MAC address as string */
 static inline char *format_mac_addr(const uint8_t *mac, char *buf, size_t buf_len)
@@ -53,12 +66,30 @@ static inline char *format_mac_addr(const uint8_t *mac, char *buf, size_t buf_le
 #define BUTTON_P2P_START   DK_BTN1_MSK
 #define BUTTON_STOP_ECHO   DK_BTN2_MSK
 
+/* Echo server address: with link-local addressing the GO's address is not
+ * known in advance and is found with a broadcast readiness probe.
+ */
+#if defined(CONFIG_P2P_ADDR_LINK_LOCAL)
+#define P2P_ECHO_SERVER_ADDR "255.255.255.255"
+#else
+#define P2P_ECHO_SERVER_ADDR CONFIG_P2P_GO_IP_ADDRESS
+#endif
+
 /* Thread stack sizes */
-#define UDP_ECHO_STACK_SIZE 4096
+#define UDP_ECHO_STACK_SIZE CONFIG_UDP_ECHO_THREAD_STACK_SIZE
+
+/* A stopped echo thread returns right away; waiting longer than this is
+ * logged before the join carries on
+ */
+#define UDP_ECHO_JOIN_TIMEOUT_MS 1000
 
 /* Work queue for P2P operations */
 static struct k_work p2p_start_work;
 static struct k_work p2p_connect_work;
+static struct k_work p2p_go_start_work;
+static struct k_work wps_pbc_work;
+static struct k_work link_rearm_work;
+static struct k_work echo_stop_work;
 
 /* Wi-Fi ready semaphore */
 static K_SEM_DEFINE(wifi_ready_sem, 0, 1);
@@ -70,11 +101,61 @@ static uint16_t discovered_peer_count;
 
 /* Connection state */
 static bool p2p_pairing_in_progress;
+/* Autonomous group is up and serving Clients */
+static bool autonomous_go;
+
+/* Next pairing skips the persistent group (link health re-form) */
+static bool link_reform;
+
+/* Connection bring-up stages. Each stage advances on its supplicant or
+ * network event; the configured delays are only upper bounds.
+ */
+enum bringup_state {
+	BRINGUP_IDLE,
+	BRINGUP_DISCOVERY,
+	BRINGUP_FIND_STOP,
+	BRINGUP_GO_NEG_WAIT,
+	BRINGUP_GROUP_FORMATION,
+	BRINGUP_STA_AUTH,
+	BRINGUP_NET_SETUP,
+	BRINGUP_DHCP,
+	BRINGUP_SERVER_PROBE,
+	BRINGUP_READY,
+	BRINGUP_FAILED,
+};
+
+static const char *const bringup_state_txt[] = {
+	[BRINGUP_IDLE] = "idle",
+	[BRINGUP_DISCOVERY] = "discovery",
+	[BRINGUP_FIND_STOP] = "find-stop",
+	[BRINGUP_GO_NEG_WAIT] = "go-neg-wait",
+	[BRINGUP_GROUP_FORMATION] = "group-formation",
+	[BRINGUP_STA_AUTH] = "sta-auth",
+	[BRINGUP_NET_SETUP] = "net-setup",
+	[BRINGUP_DHCP] = "dhcp",
+	[BRINGUP_SERVER_PROBE] = "server-probe",
+	[BRINGUP_READY] = "ready",
+	[BRINGUP_FAILED] = "failed",
+};
+
+static enum bringup_state bringup_state;
+static int64_t bringup_state_start;
+static int64_t bringup_start;
+
+/* Persistent group (fast reconnect) */
+static struct p2p_persist_group persist_group;
+static bool persist_reinvoked;
+static bool persist_fetch_pending;
+static uint8_t p2p_peer_mac[WIFI_MAC_ADDR_LEN];
 
 /* DHCP bound handling (CLI) */
 static struct k_work dhcp_bound_work;
+static struct k_work_delayable dhcp_retry_work;
 static struct net_if *dhcp_bound_iface;
 static bool dhcp_bound_handled;
+static int64_t dhcp_start_time;
+/* Cached lease in use while DHCP confirms it, 0 when not checking */
+static struct in_addr lease_check_addr;
 
 /* LED blink work */
 static struct k_work_delayable led_blink_work;
@@ -83,8 +164,30 @@ static bool led_blink_state;
 /* UDP Echo state */
 static int udp_socket = -1;
 static struct sockaddr_in server_addr;
-static volatile bool udp_echo_stop_flag;
+/* Second server socket for bulk streams (CONFIG_UDP_ECHO_MULTI_STREAM) */
+static int udp_bulk_socket = -1;
+static struct udp_echo_stop echo_stop;
 static struct udp_echo_stats echo_stats;
+static struct udp_echo_client_params echo_client_params = {
+	.packet_size = CONFIG_UDP_ECHO_PACKET_SIZE,
+	.interval_ms = CONFIG_UDP_ECHO_INTERVAL_MS,
+	.rate_pps = CONFIG_UDP_ECHO_RATE_PPS,
+#if defined(CONFIG_UDP_ECHO_PATTERN_POISSON)
+	.pattern = TX_SCHED_POISSON,
+#elif defined(CONFIG_UDP_ECHO_PATTERN_BURST)
+	.pattern = TX_SCHED_BURST,
+	.burst = CONFIG_UDP_ECHO_BURST_SIZE,
+#else
+	.pattern = TX_SCHED_PERIODIC,
+#endif
+	.count = CONFIG_UDP_ECHO_COUNT,
+	.window = CONFIG_UDP_ECHO_WINDOW_SIZE,
+};
+static struct udp_stream_params stream_params = {
+	.packet_size = CONFIG_UDP_THROUGHPUT_PACKET_SIZE,
+	.rate_kbps = CONFIG_UDP_THROUGHPUT_RATE_KBPS,
+	.duration_ms = CONFIG_UDP_THROUGHPUT_DURATION_MS,
+};
 
 /* UDP Echo threads */
 static K_THREAD_STACK_DEFINE(udp_server_stack, UDP_ECHO_STACK_SIZE);
@@ -95,10 +198,72 @@ static K_THREAD_STACK_DEFINE(udp_client_stack, UDP_ECHO_STACK_SIZE);
 static struct k_thread udp_client_thread;
 static k_tid_t udp_client_tid;
 
+#if defined(CONFIG_TCP_ECHO)
+static K_THREAD_STACK_DEFINE(tcp_server_stack, UDP_ECHO_STACK_SIZE);
+static struct k_thread tcp_server_thread;
+#endif
+static k_tid_t tcp_server_tid;
+
+/* P2P control work queue; the LED blink stays on the system work queue */
+#if defined(CONFIG_P2P_CONTROL_WORKQ)
+static K_THREAD_STACK_DEFINE(ctrl_wq_stack, CONFIG_P2P_CONTROL_WORKQ_STACK_SIZE);
+static struct k_work_q ctrl_wq;
+#define CTRL_WQ (&ctrl_wq)
+#else
+#define CTRL_WQ (&k_sys_work_q)
+#endif
+
 /* Forward declarations */
 static void udp_echo_server_thread_fn(void *p1, void *p2, void *p3);
+static void tcp_echo_server_thread_fn(void *p1, void *p2, void *p3);
 static void udp_echo_client_thread_fn(void *p1, void *p2, void *p3);
 static void start_udp_echo_client(const char *server_ip);
+static void stop_udp_echo(void);
+static void setup_client_network(void);
+static void link_recover(enum link_health_action action);
+
+static void bringup_enter(enum bringup_state state)
+{
+	int64_t now = k_uptime_get();
+
+	if (bringup_state == BRINGUP_IDLE) {
+		bringup_start = now;
+	} else {
+		LOG_INF("Bring-up: %s -> %s (%lld ms, total %lld ms)",
+			bringup_state_txt[bringup_state], bringup_state_txt[state],
+			now - bringup_state_start, now - bringup_start);
+	}
+
+	/* Feed the outcome into peer selection once a peer was chosen */
+	if (autonomous_go) {
+		/* No peer selection on an autonomous GO */
+	} else if (state == BRINGUP_READY) {
+		peer_score_session_end(p2p_peer_mac, true);
+	} else if (state == BRINGUP_FAILED &&
+		   bringup_state >= BRINGUP_GROUP_FORMATION) {
+		peer_score_session_end(p2p_peer_mac, false);
+	}
+
+	bringup_state = state;
+	bringup_state_start = now;
+
+	/* Keep latency low until the connection is up or given up */
+	power_mgr_hold(POWER_MGR_HOLD_BRINGUP,
+		       state != BRINGUP_READY && state != BRINGUP_FAILED);
+
+	if (state == BRINGUP_FAILED) {
+		/* Nothing left to wait for, allow a new attempt */
+		bringup_state = BRINGUP_IDLE;
+		bringup_prof_fail();
+	}
+}
+
+/* Abandon the bring-up without an outcome, e.g. after the link is gone */
+static void bringup_reset(void)
+{
+	bringup_state = BRINGUP_IDLE;
+	power_mgr_hold(POWER_MGR_HOLD_BRINGUP, false);
+}
 
 static void led_blink_handler(struct k_work *work)
 {
@@ -116,6 +281,60 @@ static void led_blink_handler(struct k_work *work)
 	}
 }
 
+static void client_network_ready(struct net_if *iface)
+{
+	net_utils_print_status(iface);
+
+	/* Start UDP echo client - connect to GO's IP. The client thread
+	 * probes the server before the measurement starts.
+	 */
+	bringup_enter(BRINGUP_SERVER_PROBE);
+	start_udp_echo_client(P2P_ECHO_SERVER_ADDR);
+}
+
+static void client_use_address(struct net_if *iface, const struct in_addr *addr,
+			       const char *source)
+{
+	char ip_str[NET_IPV4_ADDR_LEN];
+	int ret;
+
+	bringup_enter(BRINGUP_NET_SETUP);
+	net_addr_ntop(AF_INET, addr, ip_str, sizeof(ip_str));
+	LOG_INF("Using %s address %s, skipping DHCP", source, ip_str);
+
+	ret = net_utils_configure_ip(iface, ip_str, CONFIG_P2P_GO_IP_NETMASK);
+	if (ret < 0) {
+		LOG_ERR("Failed to configure client IP: %d", ret);
+	}
+
+	client_network_ready(iface);
+}
+
+/* DHCP bound after the Client already runs on its cached lease. The
+ * server may have leased that address to another Client in the meantime,
+ * so move to whatever it assigned now.
+ */
+static void client_lease_checked(struct net_if *iface)
+{
+	struct in_addr leased = iface->config.dhcpv4.requested_ip;
+	char cached_str[NET_IPV4_ADDR_LEN];
+	char leased_str[NET_IPV4_ADDR_LEN];
+
+	net_addr_ntop(AF_INET, &lease_check_addr, cached_str, sizeof(cached_str));
+	net_addr_ntop(AF_INET, &leased, leased_str, sizeof(leased_str));
+
+	if (leased.s_addr == lease_check_addr.s_addr) {
+		LOG_INF("Cached lease %s confirmed by DHCP", cached_str);
+	} else {
+		LOG_WRN("GO leased %s instead of cached %s, switching address",
+			leased_str, cached_str);
+		net_if_ipv4_addr_rm(iface, &lease_check_addr);
+		net_utils_lease_save(p2p_peer_mac, &leased);
+	}
+
+	lease_check_addr.s_addr = 0;
+}
+
 static void dhcp_bound_handler(struct k_work *work)
 {
 	struct net_if *iface = dhcp_bound_iface;
@@ -124,14 +343,54 @@ static void dhcp_bound_handler(struct k_work *work)
 		return;
 	}
 
+	k_work_cancel_delayable(&dhcp_retry_work);
+
+	if (lease_check_addr.s_addr != 0) {
+		client_lease_checked(iface);
+		return;
+	}
+
 	LOG_INF("IP address obtained from DHCP");
-	net_utils_print_status(iface);
 
-	/* Give GO some time to start its echo server */
-	k_sleep(K_MSEC(CONFIG_P2P_CLIENT_CONNECT_DELAY_MS));
+	if (IS_ENABLED(CONFIG_P2P_CLI_LEASE_CACHE)) {
+		struct in_addr *addr = net_if_ipv4_get_global_addr(iface,
+								   NET_ADDR_PREFERRED);
+
+		if (addr) {
+			net_utils_lease_save(p2p_peer_mac, addr);
+		}
+	}
+
+	client_network_ready(iface);
+}
+
+static void dhcp_retry_handler(struct k_work *work)
+{
+	struct net_if *iface = dhcp_bound_iface;
+
+	if (dhcp_bound_handled || !iface) {
+		return;
+	}
+
+	if (k_uptime_get() - dhcp_start_time >= CONFIG_P2P_DHCP_TIMEOUT_MS) {
+		if (lease_check_addr.s_addr != 0) {
+			/* The DHCP client keeps trying in the background */
+			LOG_WRN("Cached lease not confirmed after %d ms, keeping it",
+				CONFIG_P2P_DHCP_TIMEOUT_MS);
+			return;
+		}
+		LOG_ERR("No DHCP lease after %d ms", CONFIG_P2P_DHCP_TIMEOUT_MS);
+		bringup_enter(BRINGUP_FAILED);
+		return;
+	}
 
-	/* Start UDP echo client - connect to GO's IP */
-	start_udp_echo_client(CONFIG_P2P_GO_IP_ADDRESS);
+	/* The GO may have started its DHCP server after our first DISCOVER;
+	 * restart instead of waiting for the client's exponential backoff.
+	 */
+	LOG_INF("No DHCP lease yet, restarting DHCP client");
+	net_dhcpv4_restart(iface);
+	k_work_schedule_for_queue(CTRL_WQ, &dhcp_retry_work,
+				  K_MSEC(CONFIG_P2P_DHCP_RETRY_MS));
 }
 
 static void dhcp_bound_cb(struct net_if *iface)
@@ -142,7 +401,26 @@ static void dhcp_bound_cb(struct net_if *iface)
 
 	dhcp_bound_handled = true;
 	dhcp_bound_iface = iface;
-	k_work_submit(&dhcp_bound_work);
+	k_work_submit_to_queue(CTRL_WQ, &dhcp_bound_work);
+}
+
+static void client_dhcp_start(struct net_if *iface)
+{
+	/* Register DHCP callback BEFORE starting DHCP client
+	 * to ensure we don't miss the DHCP_BOUND event
+	 */
+	dhcp_bound_handled = false;
+	dhcp_bound_iface = iface;
+	net_utils_set_dhcp_bound_cb(dhcp_bound_cb);
+	net_utils_register_dhcp_callback();
+
+	/* If the GO's server is not up yet, the retry work restarts the
+	 * client rather than waiting out its backoff.
+	 */
+	dhcp_start_time = k_uptime_get();
+	net_dhcpv4_start(iface);
+	k_work_schedule_for_queue(CTRL_WQ, &dhcp_retry_work,
+				  K_MSEC(CONFIG_P2P_DHCP_RETRY_MS));
 }
 
 static void update_leds(void)
@@ -165,12 +443,54 @@ static void update_leds(void)
 	}
 }
 
+/* The TCP server runs next to the UDP one, on the same stop signal */
+static void start_tcp_echo_server(void)
+{
+#if defined(CONFIG_TCP_ECHO)
+	if (tcp_server_tid) {
+		return;
+	}
+
+	tcp_server_tid = k_thread_create(&tcp_server_thread,
+					 tcp_server_stack,
+					 K_THREAD_STACK_SIZEOF(tcp_server_stack),
+					 tcp_echo_server_thread_fn,
+					 NULL, NULL, NULL,
+					 UDP_ECHO_THREAD_PRIO, 0, K_NO_WAIT);
+
+	k_thread_name_set(tcp_server_tid, "tcp_echo_server");
+#endif
+}
+
 static void start_udp_echo_server(void)
 {
 	int ret;
 
 	LOG_INF("Starting UDP Echo Server on port %d...", CONFIG_UDP_ECHO_PORT);
 
+	peer_table_reset();
+
+	/* The previous session must not write the stats while they are reset */
+	if (udp_server_tid || udp_client_tid || tcp_server_tid ||
+	    (IS_ENABLED(CONFIG_UDP_ECHO_ZERO_COPY) && udp_echo_zc_running())) {
+		stop_udp_echo();
+	}
+
+	if (IS_ENABLED(CONFIG_UDP_ECHO_ZERO_COPY)) {
+		/* Reflected from the network RX thread, no server thread */
+		udp_echo_reset_stats(&echo_stats);
+		echo_trace_reset();
+		ret = udp_echo_zc_start(CONFIG_UDP_ECHO_PORT, &echo_stats);
+		if (ret < 0) {
+			LOG_ERR("Failed to start zero-copy echo: %d", ret);
+			return;
+		}
+		udp_echo_stop_reset(&echo_stop);
+		start_tcp_echo_server();
+		power_mgr_start(&echo_stats);
+		return;
+	}
+
 	/* Initialize UDP server */
 	ret = udp_server_init(&udp_socket, CONFIG_UDP_ECHO_PORT);
 	if (ret < 0) {
@@ -178,9 +498,19 @@ static void start_udp_echo_server(void)
 		return;
 	}
 
+#if defined(CONFIG_UDP_ECHO_MULTI_STREAM)
+	/* Served by the same thread, after the echo port */
+	ret = udp_server_init(&udp_bulk_socket, CONFIG_UDP_ECHO_BULK_PORT);
+	if (ret < 0) {
+		LOG_WRN("No bulk port %d (%d), serving the echo port only",
+			CONFIG_UDP_ECHO_BULK_PORT, ret);
+	}
+#endif
+
 	/* Reset stats and stop flag */
 	udp_echo_reset_stats(&echo_stats);
-	udp_echo_stop_flag = false;
+	echo_trace_reset();
+	udp_echo_stop_reset(&echo_stop);
 
 	/* Create and start UDP server thread */
 	udp_server_tid = k_thread_create(&udp_server_thread,
@@ -188,9 +518,11 @@ static void start_udp_echo_server(void)
 					 K_THREAD_STACK_SIZEOF(udp_server_stack),
 					 udp_echo_server_thread_fn,
 					 NULL, NULL, NULL,
-					 K_PRIO_PREEMPT(8), 0, K_NO_WAIT);
+					 UDP_ECHO_THREAD_PRIO, 0, K_NO_WAIT);
 
 	k_thread_name_set(udp_server_tid, "udp_echo_server");
+	start_tcp_echo_server();
+	power_mgr_start(&echo_stats);
 
 	LOG_INF("UDP Echo Server started!");
 	LOG_INF("Waiting for Client to send packets...");
@@ -203,6 +535,10 @@ static void start_udp_echo_client(const char *server_ip)
 	LOG_INF("Starting UDP Echo Client...");
 	LOG_INF("Target: %s:%d", server_ip, CONFIG_UDP_ECHO_PORT);
 
+	if (udp_server_tid || udp_client_tid || tcp_server_tid) {
+		stop_udp_echo();
+	}
+
 	/* Initialize UDP client */
 	ret = udp_client_init(&udp_socket, &server_addr, server_ip,
 			      CONFIG_UDP_ECHO_PORT);
@@ -213,7 +549,8 @@ static void start_udp_echo_client(const char *server_ip)
 
 	/* Reset stats and stop flag */
 	udp_echo_reset_stats(&echo_stats);
-	udp_echo_stop_flag = false;
+	echo_trace_reset();
+	udp_echo_stop_reset(&echo_stop);
 
 	/* Create and start UDP client thread */
 	udp_client_tid = k_thread_create(&udp_client_thread,
@@ -221,31 +558,78 @@ static void start_udp_echo_client(const char *server_ip)
 					 K_THREAD_STACK_SIZEOF(udp_client_stack),
 					 udp_echo_client_thread_fn,
 					 NULL, NULL, NULL,
-					 K_PRIO_PREEMPT(8), 0, K_NO_WAIT);
+					 UDP_ECHO_THREAD_PRIO, 0, K_NO_WAIT);
 
 	k_thread_name_set(udp_client_tid, "udp_echo_client");
+	power_mgr_start(&echo_stats);
+
+	if (IS_ENABLED(CONFIG_LINK_HEALTH) && !IS_ENABLED(CONFIG_UDP_ECHO_MODE_THROUGHPUT) &&
+	    !IS_ENABLED(CONFIG_UDP_ECHO_MODE_TCP_STREAM)) {
+		link_health_start(&echo_stats, link_recover, CTRL_WQ);
+	}
 
 	LOG_INF("UDP Echo Client started!");
 }
 
+static void echo_thread_join(struct k_thread *thread, k_tid_t *tid)
+{
+	if (!*tid) {
+		return;
+	}
+
+	/* Every wait in the echo threads also wakes on the stop signal, so
+	 * they return and release their socket, buffers and client slot.
+	 */
+	if (k_thread_join(thread, K_MSEC(UDP_ECHO_JOIN_TIMEOUT_MS)) != 0) {
+		LOG_WRN("Still waiting for %s to stop", k_thread_name_get(*tid));
+		(void)k_thread_join(thread, K_FOREVER);
+	}
+
+	*tid = NULL;
+}
+
+/* Blocks until the echo threads have returned, so call it from a work
+ * item; event callbacks use echo_stop_work instead.
+ */
 static void stop_udp_echo(void)
 {
 	LOG_INF("Stopping UDP Echo...");
 
-	/* Set stop flag */
-	udp_echo_stop_flag = true;
+	if (IS_ENABLED(CONFIG_LINK_HEALTH)) {
+		link_health_stop(false);
+	}
+	power_mgr_stop();
+
+	/* Wake the threads out of poll and wait for them to return */
+	udp_echo_stop_request(&echo_stop);
+	echo_thread_join(&udp_server_thread, &udp_server_tid);
+	echo_thread_join(&udp_client_thread, &udp_client_tid);
+#if defined(CONFIG_TCP_ECHO)
+	echo_thread_join(&tcp_server_thread, &tcp_server_tid);
+#endif
 
-	/* Wait a bit for threads to exit */
-	k_sleep(K_MSEC(500));
+	if (IS_ENABLED(CONFIG_UDP_ECHO_ZERO_COPY)) {
+		udp_echo_zc_stop();
+	}
 
 	/* Close socket */
 	if (udp_socket >= 0) {
 		udp_client_cleanup(udp_socket);
 		udp_socket = -1;
 	}
+	if (udp_bulk_socket >= 0) {
+		udp_server_cleanup(udp_bulk_socket);
+		udp_bulk_socket = -1;
+	}
 
 	/* Print final statistics */
 	udp_echo_print_stats(&echo_stats);
+	if (IS_ENABLED(CONFIG_UDP_RELIABLE)) {
+		udp_rel_print_stats();
+	}
+	echo_trace_dump();
+	power_mgr_print();
+	thread_stats_print();
 
 	LOG_INF("UDP Echo stopped");
 }
@@ -256,23 +640,140 @@ static void udp_echo_server_thread_fn(void *p1, void *p2, void *p3)
 	ARG_UNUSED(p2);
 	ARG_UNUSED(p3);
 
-	udp_echo_server_run(udp_socket, &echo_stats, &udp_echo_stop_flag);
+	if (udp_bulk_socket >= 0) {
+		int sockets[] = { udp_socket, udp_bulk_socket };
+
+		udp_echo_server_run_multi(sockets, ARRAY_SIZE(sockets),
+					  &echo_stats, &echo_stop);
+	} else {
+		udp_echo_server_run(udp_socket, &echo_stats, &echo_stop);
+	}
+}
+
+static void tcp_echo_server_thread_fn(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	tcp_echo_server_run(CONFIG_TCP_ECHO_PORT, &echo_stop);
+}
+
+/* Same server as the UDP session, on the TCP echo port */
+static void run_tcp_client(void)
+{
+#if defined(CONFIG_TCP_ECHO)
+	struct sockaddr_in tcp_addr = server_addr;
+
+	tcp_addr.sin_port = htons(CONFIG_TCP_ECHO_PORT);
+
+	if (IS_ENABLED(CONFIG_UDP_ECHO_MODE_TCP_STREAM)) {
+		tcp_stream_client_run(&tcp_addr, &stream_params, &echo_stats,
+				      &echo_stop);
+	} else {
+		tcp_echo_client_run(&tcp_addr, &echo_client_params, &echo_stats,
+				    &echo_stop);
+	}
+#endif
+}
+
+/* Probes on the echo socket, the stream on a second socket to the bulk port */
+static void run_mixed_client(void)
+{
+#if defined(CONFIG_UDP_ECHO_MULTI_STREAM)
+	struct sockaddr_in bulk_addr;
+	char ip_str[NET_IPV4_ADDR_LEN];
+	int bulk_socket;
+	int ret;
+
+	net_addr_ntop(AF_INET, &server_addr.sin_addr, ip_str, sizeof(ip_str));
+	ret = udp_client_init(&bulk_socket, &bulk_addr, ip_str,
+			      CONFIG_UDP_ECHO_BULK_PORT);
+	if (ret < 0) {
+		LOG_ERR("Failed to initialize bulk stream socket: %d", ret);
+		return;
+	}
+
+	udp_echo_mixed_run(udp_socket, &server_addr, bulk_socket, &bulk_addr,
+			   &echo_client_params, &stream_params,
+			   CONFIG_UDP_ECHO_MIXED_BASELINE_MS, &echo_stats,
+			   &echo_stop);
+
+	udp_client_cleanup(bulk_socket);
+#endif
 }
 
 static void udp_echo_client_thread_fn(void *p1, void *p2, void *p3)
 {
+	int ret;
+
 	ARG_UNUSED(p1);
 	ARG_UNUSED(p2);
 	ARG_UNUSED(p3);
 
-	udp_echo_client_run(udp_socket, &server_addr,
-			    CONFIG_UDP_ECHO_PACKET_SIZE,
-			    CONFIG_UDP_ECHO_INTERVAL_MS,
-			    CONFIG_UDP_ECHO_COUNT,
-			    &echo_stats, &udp_echo_stop_flag);
+	/* Start as soon as the GO's echo server answers */
+	ret = udp_echo_wait_server_ready(udp_socket, &server_addr,
+					 CONFIG_P2P_CLIENT_CONNECT_DELAY_MS, &echo_stop);
+	if (ret == -ECANCELED) {
+		bringup_prof_fail();
+		return;
+	} else if (ret < 0) {
+		LOG_WRN("Echo server did not answer probe (%d), starting anyway",
+			ret);
+		bringup_prof_fail();
+	} else {
+		/* The probe reply is the first echo reply of the connection */
+		bringup_prof_mark(BRINGUP_PROF_ECHO_REPLY);
+		/* Runtime benchmarks target the server that answered */
+		bench_set_server(&server_addr);
+	}
+
+	/* After a negotiated connection, take over the GO's group
+	 * credentials so the next pairing can reinvoke the group.
+	 */
+	if (IS_ENABLED(CONFIG_P2P_PERSISTENT_GROUP) && persist_fetch_pending) {
+		struct in_addr *own_addr = net_if_ipv4_get_global_addr(
+			net_utils_get_wifi_iface(), NET_ADDR_PREFERRED);
+
+		persist_fetch_pending = false;
+		if (own_addr) {
+			ret = p2p_persist_fetch(&server_addr.sin_addr, p2p_peer_mac,
+						own_addr, CONFIG_P2P_CLIENT_CONNECT_DELAY_MS,
+						&echo_stop);
+			if (ret == -ECANCELED) {
+				return;
+			} else if (ret < 0) {
+				LOG_WRN("No persistent group from GO: %d", ret);
+			}
+		}
+	}
+
+	bringup_enter(BRINGUP_READY);
+
+	if (IS_ENABLED(CONFIG_UDP_ECHO_MODE_THROUGHPUT)) {
+		udp_stream_client_run(udp_socket, &server_addr, &stream_params,
+				      &echo_stats, &echo_stop);
+	} else if (IS_ENABLED(CONFIG_UDP_ECHO_MODE_RELIABLE)) {
+		udp_rel_client_run(udp_socket, &server_addr, &echo_client_params,
+				   &echo_stats, &echo_stop);
+	} else if (IS_ENABLED(CONFIG_UDP_ECHO_MODE_TCP_ECHO) ||
+		   IS_ENABLED(CONFIG_UDP_ECHO_MODE_TCP_STREAM)) {
+		run_tcp_client();
+	} else if (IS_ENABLED(CONFIG_UDP_ECHO_MODE_MIXED)) {
+		run_mixed_client();
+	} else if (IS_ENABLED(CONFIG_UDP_ECHO_SWEEP)) {
+		udp_echo_sweep_run(udp_socket, &server_addr, &echo_client_params,
+				   &echo_stats, &echo_stop);
+	} else {
+		udp_echo_client_run(udp_socket, &server_addr, &echo_client_params,
+				    &echo_stats, &echo_stop);
+	}
 
 	/* Print stats when done */
 	udp_echo_print_stats(&echo_stats);
+	if (IS_ENABLED(CONFIG_UDP_ECHO_MODE_RELIABLE)) {
+		udp_rel_print_stats();
+	}
 }
 
 static void setup_go_network(void)
@@ -287,6 +788,19 @@ static void setup_go_network(void)
 	 * 3. Start DHCP server
 	 */
 	LOG_INF("Configuring GO network...");
+	bringup_enter(BRINGUP_NET_SETUP);
+
+	if (IS_ENABLED(CONFIG_P2P_ADDR_LINK_LOCAL)) {
+		/* Zero-config: no static address and no DHCP server, the
+		 * Client finds us with a broadcast probe.
+		 */
+		ret = net_utils_wait_for_link_local(iface, CONFIG_P2P_DHCP_TIMEOUT_MS,
+						    NULL);
+		if (ret < 0) {
+			LOG_ERR("No link-local address: %d", ret);
+		}
+		goto network_ready;
+	}
 
 	/* Configure IP address for GO */
 	ret = net_utils_configure_go_ip(iface,
@@ -309,47 +823,217 @@ static void setup_go_network(void)
 	LOG_INF("DHCP Pool: %s", CONFIG_P2P_DHCP_SERVER_POOL_START);
 	LOG_INF("=================================");
 
+network_ready:
 	net_utils_print_status(iface);
 
 	/* Start UDP echo server */
 	start_udp_echo_server();
+
+	/* Let the first Client join */
+	if (autonomous_go) {
+		wifi_p2p_wps_pbc();
+	}
+
+	/* Hand the Client credentials for reinvoking this group */
+	if (IS_ENABLED(CONFIG_P2P_PERSISTENT_GROUP) && !persist_reinvoked &&
+	    !autonomous_go) {
+		uint8_t channel = wifi_p2p_freq_to_channel(
+			wifi_p2p_get_context()->frequency);
+
+		ret = p2p_persist_serve(p2p_peer_mac, channel ? channel :
+					CONFIG_P2P_OPERATING_CHANNEL);
+		if (ret < 0) {
+			LOG_WRN("Failed to offer persistent group: %d", ret);
+		}
+	}
+
+	bringup_enter(BRINGUP_READY);
 }
 
-static void p2p_connect_handler(struct k_work *work)
+static void p2p_group_ready(void)
+{
+	struct wifi_p2p_context *ctx = wifi_p2p_get_context();
+	int ret;
+
+	/* Check the role we got from the negotiation */
+	LOG_INF("P2P group formed!");
+	LOG_INF("Role: %s", wifi_p2p_role_txt(ctx->role));
+
+	/* Handle based on actual role (determined by negotiation) */
+	if (ctx->role == WIFI_P2P_ROLE_GO) {
+		/* We became Group Owner - wait for the station to be authorized.
+		 * hostapd only reports AP-STA-CONNECTED once the EAPOL 4-way
+		 * handshake has completed, so no extra delay is needed then.
+		 * A reinvoked group has already seen it, and an autonomous
+		 * group serves Clients as they come.
+		 */
+		if (!persist_reinvoked && !autonomous_go) {
+			bringup_enter(BRINGUP_STA_AUTH);
+			LOG_INF("Waiting for AP-STA-CONNECTED...");
+			ret = wifi_p2p_wait_for_ap_sta_connected(
+				CONFIG_P2P_AP_STA_CONNECTED_TIMEOUT_MS);
+			if (ret < 0) {
+				LOG_WRN("AP-STA-CONNECTED not received, continuing anyway");
+				LOG_INF("Waiting for EAPOL 4-way handshake to complete...");
+				k_sleep(K_MSEC(CONFIG_P2P_4WAY_HANDSHAKE_WAIT_MS));
+			}
+		}
+
+		/* Now configure GO network and start DHCP server */
+		setup_go_network();
+	} else if (ctx->role == WIFI_P2P_ROLE_CLI) {
+		setup_client_network();
+	} else {
+		LOG_WRN("P2P role undetermined after connection");
+		bringup_enter(BRINGUP_FAILED);
+	}
+
+	wifi_p2p_print_status();
+	update_leds();
+	p2p_pairing_in_progress = false;
+}
+
+static void setup_client_network(void)
+{
+	struct net_if *iface = net_utils_get_wifi_iface();
+	struct in_addr addr;
+	int ret;
+
+#if defined(CONFIG_P2P_ADDR_STATIC)
+	ret = net_addr_pton(AF_INET, CONFIG_P2P_CLI_STATIC_IP, &addr);
+	if (ret < 0) {
+		LOG_ERR("Invalid static IP: %s", CONFIG_P2P_CLI_STATIC_IP);
+		bringup_enter(BRINGUP_FAILED);
+		return;
+	}
+
+	client_use_address(iface, &addr, "static");
+	return;
+#endif
+
+	if (IS_ENABLED(CONFIG_P2P_ADDR_LINK_LOCAL)) {
+		bringup_enter(BRINGUP_NET_SETUP);
+		persist_fetch_pending = !persist_reinvoked;
+		ret = net_utils_wait_for_link_local(iface, CONFIG_P2P_DHCP_TIMEOUT_MS,
+						    NULL);
+		if (ret < 0) {
+			bringup_enter(BRINGUP_FAILED);
+			return;
+		}
+
+		client_network_ready(iface);
+		return;
+	}
+
+	/* Reinvoked group - reuse the address from the last session */
+	if (persist_reinvoked && persist_group.client_ip.s_addr != 0) {
+		client_use_address(iface, &persist_group.client_ip,
+				   "persistent group");
+		return;
+	}
+
+	persist_fetch_pending = !persist_reinvoked;
+	lease_check_addr.s_addr = 0;
+
+	if (IS_ENABLED(CONFIG_P2P_CLI_LEASE_CACHE) &&
+	    net_utils_lease_get(p2p_peer_mac, &addr) == 0) {
+		client_use_address(iface, &addr, "cached lease");
+		/* The GO's server only reserves the address in a DHCP
+		 * exchange, so run one behind the echo session
+		 */
+		lease_check_addr = addr;
+		client_dhcp_start(iface);
+		return;
+	}
+
+	/* Get IP from GO's DHCP server */
+	LOG_INF("P2P connection complete - starting DHCP client to get IP from GO...");
+	bringup_enter(BRINGUP_DHCP);
+
+#if CONFIG_P2P_DHCP_START_DELAY_MS > 0
+	/* Optional delay to wait for GO to start DHCP server */
+	LOG_INF("Waiting %d ms for GO to start DHCP server...",
+		CONFIG_P2P_DHCP_START_DELAY_MS);
+	k_sleep(K_MSEC(CONFIG_P2P_DHCP_START_DELAY_MS));
+#endif
+
+	client_dhcp_start(iface);
+	LOG_INF("DHCP client started - waiting for DHCP bound event...");
+}
+
+/* Try to bring the stored persistent group back up. Returns true if the
+ * group is up and bring-up continues from there.
+ */
+static bool p2p_reinvoke_group(void)
 {
 	struct wifi_p2p_context *ctx = wifi_p2p_get_context();
+	int ret;
+
+	if (p2p_persist_get(&persist_group) != 0) {
+		return false;
+	}
+
+	bringup_prof_set_path(BRINGUP_PROF_PATH_REINVOKE);
+	bringup_enter(BRINGUP_GROUP_FORMATION);
+	ret = wifi_p2p_group_reinvoke(persist_group.role, persist_group.ssid,
+				      persist_group.psk, persist_group.channel);
+	if (ret == 0) {
+		ret = wifi_p2p_wait_for_group_formation(CONFIG_P2P_PERSIST_TIMEOUT_MS);
+	}
+
+	/* Only a returning Client shows the peer still knows the group */
+	if (ret == 0 && ctx->role == WIFI_P2P_ROLE_GO) {
+		bringup_enter(BRINGUP_STA_AUTH);
+		ret = wifi_p2p_wait_for_ap_sta_connected(CONFIG_P2P_PERSIST_TIMEOUT_MS);
+	}
+
+	if (ret < 0) {
+		LOG_WRN("Persistent group not reinvoked (%d), falling back to full pairing",
+			ret);
+		wifi_p2p_group_reinvoke_abort();
+		bringup_prof_set_path(BRINGUP_PROF_PATH_PAIRING);
+		return false;
+	}
+
+	memcpy(p2p_peer_mac, persist_group.peer_mac, WIFI_MAC_ADDR_LEN);
+	persist_reinvoked = true;
+	p2p_group_ready();
+
+	return true;
+}
+
+static void p2p_connect_handler(struct k_work *work)
+{
 	struct wifi_p2p_device_info *target_peer;
 	int ret;
 
 	if (discovered_peer_count == 0) {
 		LOG_WRN("No peers discovered, cannot connect");
+		bringup_enter(BRINGUP_FAILED);
 		p2p_pairing_in_progress = false;
 		return;
 	}
 
 	/* Stop discovery before connecting */
+	bringup_enter(BRINGUP_FIND_STOP);
 	wifi_p2p_stop_find();
 
-	/* Allow time for P2P-FIND-STOPPED before connecting */
+	/* Wait for P2P-FIND-STOPPED before connecting */
 	LOG_INF("Waiting for P2P-FIND-STOPPED...");
-	k_sleep(K_MSEC(CONFIG_P2P_FIND_STOP_DELAY_MS));
+	ret = wifi_p2p_wait_for_find_stopped(CONFIG_P2P_FIND_STOP_DELAY_MS);
+	if (ret < 0) {
+		LOG_WRN("P2P-FIND-STOPPED not received, continuing anyway");
+	}
 
-	/* Find peer by MAC filter (if configured). Otherwise use highest RSSI. */
+	/* Find peer by MAC filter (if configured). Otherwise use the best score. */
 	if (CONFIG_P2P_TARGET_PEER_MAC[0] == '\0') {
-		int best_idx = -1;
-		int best_rssi = INT_MIN;
+		int best_idx;
 
 		if (discovered_peer_count > 1) {
-			LOG_WRN("Multiple P2P peers found. Auto-selecting highest RSSI; set CONFIG_P2P_TARGET_PEER_MAC to force a specific peer.");
-		}
-
-		for (int i = 0; i < discovered_peer_count; i++) {
-			if (discovered_peers[i].rssi > best_rssi) {
-				best_rssi = discovered_peers[i].rssi;
-				best_idx = i;
-			}
+			LOG_WRN("Multiple P2P peers found. Auto-selecting by link quality; set CONFIG_P2P_TARGET_PEER_MAC to force a specific peer.");
 		}
 
+		best_idx = peer_score_select(discovered_peers, discovered_peer_count);
 		target_peer = (best_idx >= 0) ? &discovered_peers[best_idx] : NULL;
 	} else {
 		target_peer = wifi_p2p_find_peer_by_mac(discovered_peers,
@@ -365,25 +1049,48 @@ static void p2p_connect_handler(struct k_work *work)
 			LOG_INF("  [%d] %s", i,
 				format_mac_addr(discovered_peers[i].mac, mac_str, sizeof(mac_str)));
 		}
+		bringup_enter(BRINGUP_FAILED);
 		p2p_pairing_in_progress = false;
 		return;
 	}
 
 	uint8_t *peer_mac = target_peer->mac;
+
+	memcpy(p2p_peer_mac, peer_mac, WIFI_MAC_ADDR_LEN);
 	uint8_t go_intent = CONFIG_P2P_GO_INTENT;
 	uint32_t freq = CONFIG_P2P_OPERATING_FREQUENCY;
 
+	/* The future GO picks the channel; a pure Client leaves it open so
+	 * both sides do not force different frequencies
+	 */
+	if (IS_ENABLED(CONFIG_P2P_CHANNEL_AUTO)) {
+		if (go_intent > 0) {
+			ret = channel_select_best(&freq);
+			if (ret < 0) {
+				LOG_WRN("Channel selection failed (%d), using %d MHz",
+					ret, CONFIG_P2P_OPERATING_FREQUENCY);
+				freq = CONFIG_P2P_OPERATING_FREQUENCY;
+			}
+		} else {
+			freq = 0;
+		}
+	}
+
 	LOG_INF("Attempting P2P connection with peer...");
 	LOG_INF("Peer: %s", target_peer->device_name);
 	LOG_INF("GO Intent: %d (15=GO, 0=Client)", go_intent);
 
 	/* If we are CLI, wait for GO negotiation request before connecting.
 	 * The wifi shell shows P2P-GO-NEG-REQUEST before the CLI initiates
-	 * wifi p2p connect. This delay mirrors that sequence.
+	 * wifi p2p connect. Connect as soon as the request arrives.
 	 */
-	if (go_intent == 0) {
+	if (go_intent == 0 && !IS_ENABLED(CONFIG_P2P_JOIN_GROUP)) {
+		bringup_enter(BRINGUP_GO_NEG_WAIT);
 		LOG_INF("Waiting for GO negotiation request...");
-		k_sleep(K_MSEC(CONFIG_P2P_GO_NEG_REQUEST_WAIT_MS));
+		ret = wifi_p2p_wait_for_go_neg_request(CONFIG_P2P_GO_NEG_REQUEST_WAIT_MS);
+		if (ret < 0) {
+			LOG_INF("No GO negotiation request yet, connecting anyway");
+		}
 	}
 
 	/* NOTE: Do NOT configure IP or call net_if_up() before P2P connect!
@@ -394,9 +1101,16 @@ static void p2p_connect_handler(struct k_work *work)
 	 * wifi p2p connect - IP is configured manually AFTER the P2P group forms.
 	 */
 
-	ret = wifi_p2p_connect(peer_mac, go_intent, freq);
+	bringup_enter(BRINGUP_GROUP_FORMATION);
+	if (IS_ENABLED(CONFIG_P2P_JOIN_GROUP)) {
+		/* The GO's group is already up, provision and join it */
+		ret = wifi_p2p_join(peer_mac);
+	} else {
+		ret = wifi_p2p_connect(peer_mac, go_intent, freq);
+	}
 	if (ret < 0) {
 		LOG_ERR("P2P connect failed: %d", ret);
+		bringup_enter(BRINGUP_FAILED);
 		p2p_pairing_in_progress = false;
 		return;
 	}
@@ -406,60 +1120,118 @@ static void p2p_connect_handler(struct k_work *work)
 	ret = wifi_p2p_wait_for_group_formation(CONFIG_P2P_GROUP_FORMATION_TIMEOUT_MS);
 	if (ret < 0) {
 		LOG_ERR("P2P group formation failed or timed out: %d", ret);
+		bringup_enter(BRINGUP_FAILED);
 		p2p_pairing_in_progress = false;
 		return;
 	}
 
-	/* Check the role we got from the negotiation */
-	LOG_INF("P2P group formed!");
-	LOG_INF("Role: %s", wifi_p2p_role_txt(ctx->role));
+	persist_reinvoked = false;
+	p2p_group_ready();
+}
 
-	/* Handle based on actual role (determined by negotiation) */
-	if (ctx->role == WIFI_P2P_ROLE_GO) {
-		/* We became Group Owner - wait for AP-STA-CONNECTED and 4-way handshake */
-		LOG_INF("Waiting for AP-STA-CONNECTED...");
-		ret = wifi_p2p_wait_for_ap_sta_connected(
-			CONFIG_P2P_AP_STA_CONNECTED_TIMEOUT_MS);
+/* Bring the group up at boot and serve Clients as they join, so no GO
+ * negotiation is needed per Client
+ */
+static void p2p_go_start_handler(struct k_work *work)
+{
+	uint32_t freq = CONFIG_P2P_OPERATING_FREQUENCY;
+	int ret;
+
+	if (p2p_pairing_in_progress || autonomous_go) {
+		return;
+	}
+
+	p2p_pairing_in_progress = true;
+	bringup_prof_begin(BRINGUP_PROF_PATH_AUTONOMOUS);
+
+	LOG_INF("========================================");
+	LOG_INF("Starting autonomous P2P group...");
+	LOG_INF("========================================");
+
+	if (IS_ENABLED(CONFIG_P2P_CHANNEL_AUTO)) {
+		ret = channel_select_best(&freq);
 		if (ret < 0) {
-			LOG_WRN("AP-STA-CONNECTED not received, continuing anyway");
+			LOG_WRN("Channel selection failed (%d), using %d MHz",
+				ret, CONFIG_P2P_OPERATING_FREQUENCY);
+			freq = CONFIG_P2P_OPERATING_FREQUENCY;
 		}
+	}
 
-		LOG_INF("Waiting for EAPOL 4-way handshake to complete...");
-		k_sleep(K_MSEC(CONFIG_P2P_4WAY_HANDSHAKE_WAIT_MS));
+	bringup_enter(BRINGUP_GROUP_FORMATION);
+	ret = wifi_p2p_group_add(freq);
+	if (ret < 0) {
+		bringup_enter(BRINGUP_FAILED);
+		p2p_pairing_in_progress = false;
+		return;
+	}
 
-		/* Now configure GO network and start DHCP server */
-		setup_go_network();
-	} else if (ctx->role == WIFI_P2P_ROLE_CLI) {
-		/* We became Client - get IP from GO's DHCP server */
-		struct net_if *iface = net_utils_get_wifi_iface();
+	ret = wifi_p2p_wait_for_group_formation(CONFIG_P2P_GROUP_FORMATION_TIMEOUT_MS);
+	if (ret < 0) {
+		LOG_ERR("Autonomous group start failed or timed out: %d", ret);
+		bringup_enter(BRINGUP_FAILED);
+		p2p_pairing_in_progress = false;
+		return;
+	}
 
-		LOG_INF("P2P connection complete - starting DHCP client to get IP from GO...");
+	autonomous_go = true;
+	persist_reinvoked = false;
+	p2p_group_ready();
+}
 
-#if CONFIG_P2P_DHCP_START_DELAY_MS > 0
-		/* Optional delay to wait for GO to start DHCP server */
-		LOG_INF("Waiting %d ms for GO to start DHCP server...",
-			CONFIG_P2P_DHCP_START_DELAY_MS);
-		k_sleep(K_MSEC(CONFIG_P2P_DHCP_START_DELAY_MS));
-#endif
+static void wps_pbc_handler(struct k_work *work)
+{
+	wifi_p2p_wps_pbc();
+}
 
-		/* Register DHCP callback BEFORE starting DHCP client
-		 * to ensure we don't miss the DHCP_BOUND event
-		 */
-		dhcp_bound_handled = false;
-		dhcp_bound_iface = iface;
-		net_utils_set_dhcp_bound_cb(dhcp_bound_cb);
-		net_utils_register_dhcp_callback();
-
-		/* Start DHCP client to get IP from GO */
-		net_dhcpv4_start(iface);
-		LOG_INF("DHCP client started - waiting for DHCP bound event...");
+static void echo_stop_handler(struct k_work *work)
+{
+	stop_udp_echo();
+}
+
+static void p2p_leave_group(void)
+{
+	k_work_cancel_delayable(&dhcp_retry_work);
+
+	if (persist_reinvoked) {
+		wifi_p2p_group_reinvoke_abort();
 	} else {
-		LOG_WRN("P2P role undetermined after connection");
+		wifi_p2p_group_remove();
 	}
 
-	wifi_p2p_print_status();
-	update_leds();
-	p2p_pairing_in_progress = false;
+	persist_reinvoked = false;
+	bringup_reset();
+}
+
+/* Called by the link health monitor on the Client, from CTRL_WQ like the
+ * echo start/stop and pairing work it would otherwise race with
+ */
+static void link_recover(enum link_health_action action)
+{
+	stop_udp_echo();
+
+	if (action == LINK_HEALTH_REBIND) {
+		start_udp_echo_client(P2P_ECHO_SERVER_ADDR);
+		return;
+	}
+
+	/* Rejoin goes through the normal pairing start, which reinvokes
+	 * the persistent group first; re-form skips straight to discovery.
+	 */
+	if (wifi_p2p_get_context()->connected) {
+		p2p_leave_group();
+	}
+	link_reform = action == LINK_HEALTH_REFORM;
+	k_work_submit_to_queue(CTRL_WQ, &p2p_start_work);
+}
+
+/* GO side of link health: the last Client is gone, wait for it to come
+ * back the same way it left
+ */
+static void link_rearm_handler(struct k_work *work)
+{
+	LOG_INF("Link health: re-arming pairing for the Client");
+	p2p_leave_group();
+	k_work_submit_to_queue(CTRL_WQ, &p2p_start_work);
 }
 
 static void p2p_event_handler(enum wifi_p2p_event event, struct wifi_p2p_context *ctx)
@@ -472,6 +1244,7 @@ static void p2p_event_handler(enum wifi_p2p_event event, struct wifi_p2p_context
 	switch (event) {
 	case WIFI_P2P_EVENT_DEVICE_FOUND:
 		LOG_INF("Event: P2P device found");
+		peer_score_observe(&ctx->found_peer);
 		break;
 	case WIFI_P2P_EVENT_GROUP_STARTED:
 		LOG_INF("Event: P2P group started (we are GO)");
@@ -487,14 +1260,35 @@ static void p2p_event_handler(enum wifi_p2p_event event, struct wifi_p2p_context
 		break;
 	case WIFI_P2P_EVENT_AP_STA_CONNECTED:
 		LOG_INF("Event: AP-STA-CONNECTED received");
+		if (autonomous_go) {
+			/* The push button is consumed, reopen it for the next one */
+			k_work_submit_to_queue(CTRL_WQ, &wps_pbc_work);
+		}
 		break;
 	case WIFI_P2P_EVENT_PEER_LEFT:
-		LOG_INF("Event: Peer left our group");
-		stop_udp_echo();
+		LOG_INF("Event: Peer left our group (%d remaining)",
+			ctx->client_count);
+		peer_table_remove_mac(ctx->event_mac);
+		if (ctx->client_count == 0 && !autonomous_go) {
+			k_work_submit_to_queue(CTRL_WQ, &echo_stop_work);
+			bringup_reset();
+			if (IS_ENABLED(CONFIG_LINK_HEALTH)) {
+				k_work_submit_to_queue(CTRL_WQ, &link_rearm_work);
+			}
+		}
 		break;
 	case WIFI_P2P_EVENT_DISCONNECTED:
 		LOG_INF("Event: Disconnected from P2P group");
-		stop_udp_echo();
+		k_work_cancel_delayable(&dhcp_retry_work);
+		k_work_submit_to_queue(CTRL_WQ, &echo_stop_work);
+		bench_set_server(NULL);
+		bringup_reset();
+		bringup_prof_fail();
+		autonomous_go = false;
+		if (IS_ENABLED(CONFIG_LINK_HEALTH)) {
+			link_health_stop(false);
+			link_health_link_lost();
+		}
 		break;
 	default:
 		break;
@@ -515,7 +1309,9 @@ static void p2p_start_handler(struct k_work *work)
 	}
 
 	p2p_pairing_in_progress = true;
+	bringup_prof_begin(BRINGUP_PROF_PATH_PAIRING);
 	discovered_peer_count = 0;
+	peer_score_reset();
 
 	LOG_INF("========================================");
 	LOG_INF("Starting Wi-Fi Direct P2P Pairing...");
@@ -527,28 +1323,39 @@ static void p2p_start_handler(struct k_work *work)
 	/* Start LED blinking */
 	k_work_schedule(&led_blink_work, K_NO_WAIT);
 
+	/* Reinvoke the stored group first, skipping discovery, GO
+	 * negotiation and WPS when the peer still has it.
+	 */
+	if (IS_ENABLED(CONFIG_P2P_PERSISTENT_GROUP) && !link_reform &&
+	    p2p_reinvoke_group()) {
+		return;
+	}
+	link_reform = false;
+
+	bringup_enter(BRINGUP_DISCOVERY);
+
 	/* Start P2P discovery */
 	ret = wifi_p2p_find(CONFIG_P2P_DISCOVERY_TIMEOUT);
 	if (ret < 0) {
 		LOG_ERR("Failed to start P2P discovery: %d", ret);
+		bringup_enter(BRINGUP_FAILED);
 		p2p_pairing_in_progress = false;
 		return;
 	}
 
-	/* Wait for peer discovery - use full timeout to find target peer
-	 * In environments with multiple P2P devices, we need to wait long enough
-	 * to discover the specific target peer, not just any peer.
+	/* Wait for peer discovery. With a MAC filter or RSSI threshold the
+	 * wait ends as soon as a matching peer is reported; otherwise the
+	 * full window is used so the best of several peers can be chosen.
 	 */
-	LOG_INF("Searching for P2P peers (waiting %d ms)...",
+	LOG_INF("Searching for P2P peers (up to %d ms)...",
 		CONFIG_P2P_DISCOVERY_WAIT_MS);
 
-	/* Wait for the full discovery period */
-	k_sleep(K_MSEC(CONFIG_P2P_DISCOVERY_WAIT_MS));
-
-	/* Get discovered peers */
-	ret = wifi_p2p_get_peers(discovered_peers, CONFIG_WIFI_P2P_MAX_PEERS,
-				 &discovered_peer_count);
-	if (ret < 0) {
+	ret = wifi_p2p_discover_peers(discovered_peers, CONFIG_WIFI_P2P_MAX_PEERS,
+				      &discovered_peer_count,
+				      CONFIG_P2P_TARGET_PEER_MAC,
+				      CONFIG_P2P_DISCOVERY_RSSI_THRESHOLD,
+				      CONFIG_P2P_DISCOVERY_WAIT_MS);
+	if (ret < 0 && ret != -ETIMEDOUT) {
 		LOG_WRN("Failed to get peer list: %d", ret);
 	}
 
@@ -568,9 +1375,10 @@ static void p2p_start_handler(struct k_work *work)
 	/* If peers found, initiate connection */
 	if (discovered_peer_count > 0 || ctx->state == WIFI_P2P_STATE_FOUND) {
 		LOG_INF("Peer found! Initiating connection...");
-		k_work_submit(&p2p_connect_work);
+		k_work_submit_to_queue(CTRL_WQ, &p2p_connect_work);
 	} else {
 		LOG_INF("No peers found. Press BUTTON 0 on both devices simultaneously.");
+		bringup_enter(BRINGUP_FAILED);
 		p2p_pairing_in_progress = false;
 	}
 }
@@ -580,22 +1388,48 @@ static void button_handler(uint32_t button_state, uint32_t has_changed)
 	if ((has_changed & BUTTON_P2P_START) && (button_state & BUTTON_P2P_START)) {
 		struct wifi_p2p_context *ctx = wifi_p2p_get_context();
 
-		if (!ctx->connected) {
+		if (IS_ENABLED(CONFIG_P2P_AUTONOMOUS_GO)) {
+			if (!autonomous_go) {
+				LOG_INF("BUTTON 0 pressed - Starting autonomous group");
+				k_work_submit_to_queue(CTRL_WQ, &p2p_go_start_work);
+			} else {
+				/* Let another Client join, show who is connected */
+				LOG_INF("BUTTON 0 pressed - Accept Client / Print peers");
+				k_work_submit_to_queue(CTRL_WQ, &wps_pbc_work);
+				peer_table_print();
+			}
+		} else if (!ctx->connected) {
 			LOG_INF("BUTTON 0 pressed - Starting P2P pairing");
-			k_work_submit(&p2p_start_work);
+			k_work_submit_to_queue(CTRL_WQ, &p2p_start_work);
 		} else {
 			LOG_INF("BUTTON 0 pressed - Print UDP Echo stats");
 			if (ctx->role == WIFI_P2P_ROLE_GO) {
-				LOG_INF("GO is echo server only. Check CLI device for UDP Echo statistics.");
+				peer_table_print();
 			} else {
 				udp_echo_print_stats(&echo_stats);
 			}
+			bringup_prof_print();
+			power_mgr_print();
+			thread_stats_print();
 		}
 	}
 
 	if ((has_changed & BUTTON_STOP_ECHO) && (button_state & BUTTON_STOP_ECHO)) {
+		struct wifi_p2p_context *ctx = wifi_p2p_get_context();
+
+		if (IS_ENABLED(CONFIG_P2P_PERSISTENT_GROUP) && !ctx->connected &&
+		    !p2p_pairing_in_progress) {
+			LOG_INF("BUTTON 1 pressed - Forget persistent group");
+			p2p_persist_clear();
+			return;
+		}
+
 		LOG_INF("BUTTON 1 pressed - Stop UDP Echo");
-		stop_udp_echo();
+		if (IS_ENABLED(CONFIG_LINK_HEALTH)) {
+			/* Stopped on purpose, do not recover */
+			link_health_stop(true);
+		}
+		k_work_submit_to_queue(CTRL_WQ, &echo_stop_work);
 	}
 }
 
@@ -687,6 +1521,21 @@ void start_wifi_thread(void)
 		/* Register P2P event callback */
 		wifi_p2p_register_event_callback(p2p_event_handler);
 
+		/* Power save until pairing starts */
+		power_mgr_init();
+
+		ret = peer_score_init();
+		if (ret) {
+			LOG_WRN("Peer history unavailable: %d", ret);
+		}
+
+		if (IS_ENABLED(CONFIG_P2P_PERSISTENT_GROUP)) {
+			ret = p2p_persist_init();
+			if (ret) {
+				LOG_WRN("Persistent group unavailable: %d", ret);
+			}
+		}
+
 		LOG_INF("============================================");
 		LOG_INF("Nordic Wi-Fi Direct P2P Echo Demo Ready");
 		LOG_INF("============================================");
@@ -700,6 +1549,9 @@ void start_wifi_thread(void)
 		LOG_INF("");
 		LOG_INF("BUTTON 0: Start pairing / Print stats");
 		LOG_INF("BUTTON 1: Stop UDP Echo");
+		if (IS_ENABLED(CONFIG_P2P_PERSISTENT_GROUP)) {
+			LOG_INF("          (when idle: forget persistent group)");
+		}
 		LOG_INF("");
 		LOG_INF("LED0: P2P Discovery (on during pairing)");
 		LOG_INF("LED1: P2P Connected");
@@ -710,6 +1562,14 @@ void start_wifi_thread(void)
 		LOG_INF(">>> Please press BUTTON 0 on two devices at the same time to start pairing <<<");
 		LOG_INF("");
 
+		if (IS_ENABLED(CONFIG_P2P_AUTONOMOUS_GO)) {
+			LOG_INF(">>> Autonomous GO: group starts now, Clients join with BUTTON 0 <<<");
+			k_work_submit_to_queue(CTRL_WQ, &p2p_go_start_work);
+		} else if (IS_ENABLED(CONFIG_P2P_AUTO_START)) {
+			LOG_INF(">>> Auto start: pairing starts now <<<");
+			k_work_submit_to_queue(CTRL_WQ, &p2p_start_work);
+		}
+
 		/* Keep running and wait for button press or Wi-Fi state change */
 		ret = k_sem_take(&wifi_ready_sem, K_FOREVER);
 		if (ret) {
@@ -726,11 +1586,25 @@ int main(void)
 	LOG_INF("Starting Nordic Wi-Fi Direct P2P Echo Demo");
 	LOG_INF("Board: %s", CONFIG_BOARD);
 
+#if defined(CONFIG_P2P_CONTROL_WORKQ)
+	k_work_queue_start(&ctrl_wq, ctrl_wq_stack,
+			   K_THREAD_STACK_SIZEOF(ctrl_wq_stack),
+			   CONFIG_P2P_CONTROL_WORKQ_PRIORITY,
+			   &(struct k_work_queue_config){ .name = "p2p_ctrl" });
+#endif
+
 	/* Initialize work items */
 	k_work_init(&p2p_start_work, p2p_start_handler);
 	k_work_init(&p2p_connect_work, p2p_connect_handler);
+	k_work_init(&p2p_go_start_work, p2p_go_start_handler);
+	k_work_init(&wps_pbc_work, wps_pbc_handler);
+	k_work_init(&link_rearm_work, link_rearm_handler);
+	k_work_init(&echo_stop_work, echo_stop_handler);
+	udp_echo_stop_init(&echo_stop);
 	k_work_init(&dhcp_bound_work, dhcp_bound_handler);
+	k_work_init_delayable(&dhcp_retry_work, dhcp_retry_handler);
 	k_work_init_delayable(&led_blink_work, led_blink_handler);
+	thread_stats_init();
 
 	/* Initialize LEDs and buttons */
 	ret = init_leds_and_buttons();
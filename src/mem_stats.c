@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net_buf.h>
+#include <zephyr/sys/sys_heap.h>
+#include <string.h>
+
+#include "mem_stats.h"
+
+LOG_MODULE_REGISTER(mem_stats, CONFIG_LOG_DEFAULT_LEVEL);
+
+/* Defined by the kernel for k_malloc() */
+extern struct k_heap _system_heap;
+
+static atomic_t alloc_failures;
+static atomic_t buffer_waits;
+static struct k_spinlock wait_lock;
+static uint64_t buffer_wait_us;
+
+void mem_stats_alloc_failed(void)
+{
+	atomic_inc(&alloc_failures);
+}
+
+void mem_stats_buffer_wait(uint32_t wait_us)
+{
+	k_spinlock_key_t key = k_spin_lock(&wait_lock);
+
+	buffer_wait_us += wait_us;
+	k_spin_unlock(&wait_lock, key);
+
+	atomic_inc(&buffer_waits);
+}
+
+static void mem_stats_slab(struct k_mem_slab *slab, struct mem_pool_usage *usage)
+{
+	usage->used = k_mem_slab_num_used_get(slab);
+	usage->size = usage->used + k_mem_slab_num_free_get(slab);
+	usage->max_used = k_mem_slab_max_used_get(slab);
+}
+
+static void mem_stats_pool(struct net_buf_pool *pool, struct mem_pool_usage *usage)
+{
+	usage->size = pool->buf_count;
+	usage->used = pool->buf_count - atomic_get(&pool->avail_count);
+	usage->max_used = pool->max_used;
+}
+
+void mem_stats_get(struct mem_stats *stats)
+{
+	struct k_mem_slab *rx_slab, *tx_slab;
+	struct net_buf_pool *rx_pool, *tx_pool;
+	struct sys_memory_stats heap = { 0 };
+	k_spinlock_key_t key;
+
+	memset(stats, 0, sizeof(*stats));
+
+	net_pkt_get_info(&rx_slab, &tx_slab, &rx_pool, &tx_pool);
+	mem_stats_slab(rx_slab, &stats->rx_pkt);
+	mem_stats_slab(tx_slab, &stats->tx_pkt);
+	mem_stats_pool(rx_pool, &stats->rx_buf);
+	mem_stats_pool(tx_pool, &stats->tx_buf);
+
+	if (sys_heap_runtime_stats_get(&_system_heap.heap, &heap) == 0) {
+		stats->heap_size = heap.free_bytes + heap.allocated_bytes;
+		stats->heap_used = heap.allocated_bytes;
+		stats->heap_max_used = heap.max_allocated_bytes;
+	}
+
+	stats->alloc_failures = atomic_get(&alloc_failures);
+	stats->buffer_waits = atomic_get(&buffer_waits);
+
+	key = k_spin_lock(&wait_lock);
+	stats->buffer_wait_us = buffer_wait_us;
+	k_spin_unlock(&wait_lock, key);
+}
+
+void mem_stats_reset(void)
+{
+	struct k_mem_slab *rx_slab, *tx_slab;
+	struct net_buf_pool *rx_pool, *tx_pool;
+	k_spinlock_key_t key;
+
+	net_pkt_get_info(&rx_slab, &tx_slab, &rx_pool, &tx_pool);
+	(void)k_mem_slab_runtime_stats_reset_max(rx_slab);
+	(void)k_mem_slab_runtime_stats_reset_max(tx_slab);
+	/* The pools have no reset call; racing allocations only make the
+	 * mark slightly low until the next one
+	 */
+	rx_pool->max_used = rx_pool->buf_count - atomic_get(&rx_pool->avail_count);
+	tx_pool->max_used = tx_pool->buf_count - atomic_get(&tx_pool->avail_count);
+	(void)sys_heap_runtime_stats_reset_max(&_system_heap.heap);
+
+	atomic_clear(&alloc_failures);
+	atomic_clear(&buffer_waits);
+
+	key = k_spin_lock(&wait_lock);
+	buffer_wait_us = 0;
+	k_spin_unlock(&wait_lock, key);
+}
+
+static void mem_stats_print_pool(const char *label, const struct mem_pool_usage *usage)
+{
+	LOG_INF("%-17s %u/%u used, max %u%s", label, usage->used, usage->size,
+		usage->max_used, usage->max_used >= usage->size ? " (exhausted)" : "");
+}
+
+void mem_stats_print(void)
+{
+	struct mem_stats stats;
+
+	mem_stats_get(&stats);
+
+	LOG_INF("=== Memory Usage ===");
+	mem_stats_print_pool("RX packets:", &stats.rx_pkt);
+	mem_stats_print_pool("TX packets:", &stats.tx_pkt);
+	mem_stats_print_pool("RX buffers:", &stats.rx_buf);
+	mem_stats_print_pool("TX buffers:", &stats.tx_buf);
+	LOG_INF("%-17s %u/%u bytes, max %u", "System heap:",
+		(uint32_t)stats.heap_used, (uint32_t)stats.heap_size,
+		(uint32_t)stats.heap_max_used);
+	LOG_INF("%-17s %u", "Alloc failures:", stats.alloc_failures);
+	LOG_INF("%-17s %u (%u.%03u ms)", "Buffer waits:", stats.buffer_waits,
+		(uint32_t)(stats.buffer_wait_us / 1000),
+		(uint32_t)(stats.buffer_wait_us % 1000));
+	LOG_INF("====================");
+}
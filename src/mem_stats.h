@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef MEM_STATS_H_
+#define MEM_STATS_H_
+
+#include <zephyr/kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Network buffer and heap usage instrumentation
+ *
+ * Reports current and high-water usage of the net_pkt slabs, the net_buf
+ * data pools and the system heap, together with the send attempts that
+ * failed for lack of buffers and the time the echo paths spent backing
+ * off until buffers were available again. Used to size the buffer
+ * profiles in prj.conf and the overlay-mem-*.conf files.
+ */
+
+/** Usage of one fixed-size pool */
+struct mem_pool_usage {
+	/** Total blocks or buffers */
+	uint32_t size;
+	/** Currently in use */
+	uint32_t used;
+	/** High-water mark since boot or the last reset */
+	uint32_t max_used;
+};
+
+/** Memory usage snapshot */
+struct mem_stats {
+	/** RX net_pkt slab (CONFIG_NET_PKT_RX_COUNT) */
+	struct mem_pool_usage rx_pkt;
+	/** TX net_pkt slab (CONFIG_NET_PKT_TX_COUNT) */
+	struct mem_pool_usage tx_pkt;
+	/** RX data buffers (CONFIG_NET_BUF_RX_COUNT) */
+	struct mem_pool_usage rx_buf;
+	/** TX data buffers (CONFIG_NET_BUF_TX_COUNT) */
+	struct mem_pool_usage tx_buf;
+	/** System heap size in bytes */
+	size_t heap_size;
+	/** System heap bytes allocated */
+	size_t heap_used;
+	/** System heap high-water mark in bytes */
+	size_t heap_max_used;
+	/** Sends that failed with -ENOMEM, -ENOBUFS or -EAGAIN */
+	uint32_t alloc_failures;
+	/** Backoffs taken after such a failure */
+	uint32_t buffer_waits;
+	/** Total time spent in those backoffs in microseconds */
+	uint64_t buffer_wait_us;
+};
+
+#if defined(CONFIG_UDP_ECHO_MEM_STATS)
+
+/**
+ * @brief Count a send that failed for lack of buffers
+ */
+void mem_stats_alloc_failed(void);
+
+/**
+ * @brief Account a backoff spent waiting for buffers
+ *
+ * @param wait_us Backoff duration in microseconds
+ */
+void mem_stats_buffer_wait(uint32_t wait_us);
+
+/**
+ * @brief Take a memory usage snapshot
+ *
+ * @param stats Output snapshot
+ */
+void mem_stats_get(struct mem_stats *stats);
+
+/**
+ * @brief Clear the counters and restart the high-water marks from the
+ *        current usage
+ */
+void mem_stats_reset(void);
+
+/**
+ * @brief Log a memory usage snapshot
+ */
+void mem_stats_print(void);
+
+#else
+
+static inline void mem_stats_alloc_failed(void)
+{
+}
+
+static inline void mem_stats_buffer_wait(uint32_t wait_us)
+{
+	ARG_UNUSED(wait_us);
+}
+
+static inline void mem_stats_get(struct mem_stats *stats)
+{
+	ARG_UNUSED(stats);
+}
+
+static inline void mem_stats_reset(void)
+{
+}
+
+static inline void mem_stats_print(void)
+{
+}
+
+#endif /* CONFIG_UDP_ECHO_MEM_STATS */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MEM_STATS_H_ */
@@ -13,9 +13,12 @@ LOG_MODULE_REGISTER(p2p_net_utils, CONFIG_LOG_DEFAULT_LEVEL);
 #include <zephyr/net/wifi_mgmt.h>
 #include <zephyr/net/dhcpv4_server.h>
 #include <zephyr/net/net_event.h>
+#include <zephyr/settings/settings.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "net_utils.h"
+#include "bringup_prof.h"
 
 /* Helper function to format MAC address as string */
 static inline char *format_mac_addr(const uint8_t *mac, char *buf, size_t buf_len)
@@ -35,12 +38,56 @@ static K_SEM_DEFINE(dhcp_bound_sem, 0, 1);
 static struct net_mgmt_event_callback net_mgmt_cb;
 static net_utils_dhcp_bound_cb_t dhcp_bound_cb;
 
+/* IPv4 address added (link-local wait) */
+static K_SEM_DEFINE(ipv4_addr_sem, 0, 1);
+static struct net_mgmt_event_callback ipv4_addr_cb;
+
+#if defined(CONFIG_P2P_CLI_LEASE_CACHE)
+/* Cached DHCP lease, stored as "p2p_lease/last" */
+struct lease_record {
+	uint8_t go_mac[WIFI_MAC_ADDR_LEN];
+	struct in_addr addr;
+} __packed;
+
+static struct lease_record cached_lease;
+static bool cached_lease_valid;
+static bool cached_lease_loaded;
+
+static int lease_settings_set(const char *name, size_t len,
+			      settings_read_cb read_cb, void *cb_arg)
+{
+	const char *next;
+	int ret;
+
+	if (!settings_name_steq(name, "last", &next) || next) {
+		return -ENOENT;
+	}
+
+	if (len != sizeof(cached_lease)) {
+		return 0;
+	}
+
+	ret = read_cb(cb_arg, &cached_lease, sizeof(cached_lease));
+	if (ret < 0) {
+		return ret;
+	}
+
+	cached_lease_valid = true;
+
+	return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(p2p_lease, "p2p_lease", NULL,
+			       lease_settings_set, NULL, NULL);
+#endif /* CONFIG_P2P_CLI_LEASE_CACHE */
+
 static void net_mgmt_event_handler(struct net_mgmt_event_callback *cb,
 				   uint64_t mgmt_event, struct net_if *iface)
 {
 	switch (mgmt_event) {
 	case NET_EVENT_IPV4_DHCP_BOUND:
 		LOG_INF("DHCP bound - IP address obtained");
+		bringup_prof_mark(BRINGUP_PROF_DHCP_BOUND);
 		k_sem_give(&dhcp_bound_sem);
 		if (dhcp_bound_cb) {
 			dhcp_bound_cb(iface);
@@ -58,6 +105,12 @@ struct net_if *net_utils_get_wifi_iface(void)
 
 int net_utils_configure_go_ip(struct net_if *iface, const char *ip_addr,
 			      const char *netmask)
+{
+	return net_utils_configure_ip(iface, ip_addr, netmask);
+}
+
+int net_utils_configure_ip(struct net_if *iface, const char *ip_addr,
+			   const char *netmask)
 {
 	struct in_addr addr;
 	struct in_addr mask;
@@ -100,13 +153,138 @@ int net_utils_configure_go_ip(struct net_if *iface, const char *ip_addr,
 
 	/* Set netmask */
 	net_if_ipv4_set_netmask_by_addr(iface, &addr, &mask);
+	bringup_prof_mark(BRINGUP_PROF_IP_CONFIGURED);
 
 	char ip_str[NET_IPV4_ADDR_LEN];
 
 	net_addr_ntop(AF_INET, &addr, ip_str, sizeof(ip_str));
-	LOG_INF("Configured GO IP address: %s", ip_str);
+	LOG_INF("Configured IP address: %s", ip_str);
+
+	return 0;
+}
+
+static void ipv4_addr_event_handler(struct net_mgmt_event_callback *cb,
+				    uint64_t mgmt_event, struct net_if *iface)
+{
+	k_sem_give(&ipv4_addr_sem);
+}
+
+static bool find_link_local(struct net_if *iface, struct in_addr *addr)
+{
+	struct net_if_ipv4 *ipv4 = iface->config.ip.ipv4;
+
+	if (!ipv4) {
+		return false;
+	}
+
+	for (int i = 0; i < NET_IF_MAX_IPV4_ADDR; i++) {
+		if (ipv4->unicast[i].ipv4.is_used &&
+		    net_ipv4_is_ll_addr(&ipv4->unicast[i].ipv4.address.in_addr)) {
+			*addr = ipv4->unicast[i].ipv4.address.in_addr;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+int net_utils_wait_for_link_local(struct net_if *iface, uint32_t timeout_ms,
+				  struct in_addr *addr)
+{
+	char ip_str[NET_IPV4_ADDR_LEN];
+	int64_t start = k_uptime_get();
+	int64_t remaining;
+	struct in_addr ll_addr;
+	int ret = 0;
+
+	if (!iface) {
+		iface = net_if_get_first_wifi();
+	}
+
+	if (!iface) {
+		LOG_ERR("No Wi-Fi interface found");
+		return -ENODEV;
+	}
+
+	k_sem_reset(&ipv4_addr_sem);
+	net_mgmt_init_event_callback(&ipv4_addr_cb, ipv4_addr_event_handler,
+				     NET_EVENT_IPV4_ADDR_ADD);
+	net_mgmt_add_event_callback(&ipv4_addr_cb);
+
+	LOG_INF("Waiting for IPv4 link-local address...");
+
+	while (!find_link_local(iface, &ll_addr)) {
+		remaining = start + timeout_ms - k_uptime_get();
+		if (remaining <= 0) {
+			LOG_ERR("No link-local address after %d ms", timeout_ms);
+			ret = -ETIMEDOUT;
+			goto out;
+		}
+
+		k_sem_take(&ipv4_addr_sem, K_MSEC(remaining));
+	}
+
+	bringup_prof_mark(BRINGUP_PROF_IP_CONFIGURED);
+	net_addr_ntop(AF_INET, &ll_addr, ip_str, sizeof(ip_str));
+	LOG_INF("Link-local address: %s", ip_str);
+
+	if (addr) {
+		*addr = ll_addr;
+	}
+
+out:
+	net_mgmt_del_event_callback(&ipv4_addr_cb);
+
+	return ret;
+}
+
+int net_utils_lease_get(const uint8_t *go_mac, struct in_addr *addr)
+{
+#if defined(CONFIG_P2P_CLI_LEASE_CACHE)
+	if (!cached_lease_loaded) {
+		cached_lease_loaded = true;
+		if (settings_subsys_init() == 0) {
+			settings_load_subtree("p2p_lease");
+		}
+	}
+
+	if (!cached_lease_valid ||
+	    memcmp(cached_lease.go_mac, go_mac, WIFI_MAC_ADDR_LEN) != 0) {
+		return -ENOENT;
+	}
+
+	*addr = cached_lease.addr;
 
 	return 0;
+#else
+	return -ENOENT;
+#endif
+}
+
+int net_utils_lease_save(const uint8_t *go_mac, const struct in_addr *addr)
+{
+#if defined(CONFIG_P2P_CLI_LEASE_CACHE)
+	int ret;
+
+	if (cached_lease_valid && cached_lease.addr.s_addr == addr->s_addr &&
+	    memcmp(cached_lease.go_mac, go_mac, WIFI_MAC_ADDR_LEN) == 0) {
+		return 0;
+	}
+
+	memcpy(cached_lease.go_mac, go_mac, WIFI_MAC_ADDR_LEN);
+	cached_lease.addr = *addr;
+	cached_lease_valid = true;
+
+	ret = settings_save_one("p2p_lease/last", &cached_lease,
+				sizeof(cached_lease));
+	if (ret) {
+		LOG_WRN("Failed to cache DHCP lease: %d", ret);
+	}
+
+	return ret;
+#else
+	return -ENOTSUP;
+#endif
 }
 
 int net_utils_start_dhcp_server(struct net_if *iface, const char *pool_start)
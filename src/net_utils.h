@@ -14,6 +14,17 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Configure a static IPv4 address
+ *
+ * @param iface Network interface to configure
+ * @param ip_addr IP address string (e.g., "192.168.88.2")
+ * @param netmask Netmask string (e.g., "255.255.255.0")
+ * @return 0 on success, negative error code on failure
+ */
+int net_utils_configure_ip(struct net_if *iface, const char *ip_addr,
+			   const char *netmask);
+
 /**
  * @brief Configure static IP address for GO role
  *
@@ -25,6 +36,38 @@ extern "C" {
 int net_utils_configure_go_ip(struct net_if *iface, const char *ip_addr,
 			      const char *netmask);
 
+/**
+ * @brief Wait for an IPv4 link-local (169.254/16) address
+ *
+ * Requires CONFIG_NET_IPV4_AUTO, which claims the address on its own
+ * once the interface is up. Returns immediately if one is assigned.
+ *
+ * @param iface Network interface
+ * @param timeout_ms Upper bound for the wait
+ * @param addr Output: link-local address (can be NULL)
+ * @return 0 on success, -ETIMEDOUT on timeout, negative error code on failure
+ */
+int net_utils_wait_for_link_local(struct net_if *iface, uint32_t timeout_ms,
+				  struct in_addr *addr);
+
+/**
+ * @brief Get the DHCP lease cached from the last session with a GO
+ *
+ * @param go_mac MAC address of the Group Owner the lease must come from
+ * @param addr Output: cached address
+ * @return 0 on success, -ENOENT if no lease from this GO is cached
+ */
+int net_utils_lease_get(const uint8_t *go_mac, struct in_addr *addr);
+
+/**
+ * @brief Cache a DHCP lease for the next session with the same GO
+ *
+ * @param go_mac MAC address of the Group Owner that assigned the lease
+ * @param addr Leased address
+ * @return 0 on success, negative error code on failure
+ */
+int net_utils_lease_save(const uint8_t *go_mac, const struct in_addr *addr);
+
 /**
  * @brief Start DHCP server for P2P GO role
  *
@@ -0,0 +1,373 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(p2p_persist, CONFIG_LOG_DEFAULT_LEVEL);
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/random/random.h>
+#include <zephyr/settings/settings.h>
+#include <string.h>
+
+#include "p2p_persist.h"
+#include "echo_proto.h"
+#include "time_utils.h"
+
+/* Layout version of the stored record, bump on any change */
+#define P2P_PERSIST_VERSION 1
+
+/* Settings key of the stored record */
+#define P2P_PERSIST_KEY "p2p/group"
+
+/* Length of the generated passphrase */
+#define P2P_PERSIST_PSK_LEN 16
+
+/* Interval between credential requests (ms) */
+#define P2P_PERSIST_RETRY_MS 250
+
+/* How long the GO offers credentials after the group is up (ms) */
+#define P2P_PERSIST_SERVE_TIMEOUT_MS 30000
+
+#define P2P_PERSIST_STACK_SIZE 2048
+
+/* Stored record */
+struct p2p_persist_record {
+	uint8_t version;
+	struct p2p_persist_group group;
+} __packed;
+
+/* Credential reply payload, follows the echo_proto header */
+struct p2p_persist_msg {
+	uint8_t channel;
+	uint8_t ssid_len;
+	uint8_t psk_len;
+	char ssid[WIFI_SSID_MAX_LEN];
+	char psk[WIFI_PSK_MAX_LEN];
+} __packed;
+
+static struct p2p_persist_group stored_group;
+static bool stored_valid;
+
+/* Credentials being handed out by the GO */
+static struct p2p_persist_group offer_group;
+
+static K_THREAD_STACK_DEFINE(p2p_persist_stack, P2P_PERSIST_STACK_SIZE);
+static struct k_thread p2p_persist_thread;
+static bool p2p_persist_thread_started;
+
+static int p2p_persist_settings_set(const char *name, size_t len,
+				    settings_read_cb read_cb, void *cb_arg)
+{
+	struct p2p_persist_record record;
+	const char *next;
+	int ret;
+
+	if (!settings_name_steq(name, "group", &next) || next) {
+		return -ENOENT;
+	}
+
+	if (len != sizeof(record)) {
+		LOG_WRN("Ignoring stored group with unexpected size %zu", len);
+		return 0;
+	}
+
+	ret = read_cb(cb_arg, &record, sizeof(record));
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (record.version != P2P_PERSIST_VERSION) {
+		LOG_WRN("Ignoring stored group version %d", record.version);
+		return 0;
+	}
+
+	stored_group = record.group;
+	stored_group.ssid[WIFI_SSID_MAX_LEN] = '\0';
+	stored_group.psk[WIFI_PSK_MAX_LEN] = '\0';
+	stored_valid = true;
+
+	return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(p2p_persist, "p2p", NULL,
+			       p2p_persist_settings_set, NULL, NULL);
+
+int p2p_persist_init(void)
+{
+	int ret;
+
+	ret = settings_subsys_init();
+	if (ret) {
+		LOG_ERR("Failed to initialize settings: %d", ret);
+		return ret;
+	}
+
+	ret = settings_load_subtree("p2p");
+	if (ret) {
+		LOG_ERR("Failed to load persistent group: %d", ret);
+		return ret;
+	}
+
+	if (stored_valid) {
+		LOG_INF("Persistent group: %s as %s on channel %d",
+			stored_group.ssid,
+			wifi_p2p_role_txt(stored_group.role),
+			stored_group.channel);
+	}
+
+	return 0;
+}
+
+int p2p_persist_get(struct p2p_persist_group *group)
+{
+	if (!stored_valid) {
+		return -ENOENT;
+	}
+
+	*group = stored_group;
+
+	return 0;
+}
+
+int p2p_persist_save(const struct p2p_persist_group *group)
+{
+	struct p2p_persist_record record = {
+		.version = P2P_PERSIST_VERSION,
+		.group = *group,
+	};
+	int ret;
+
+	ret = settings_save_one(P2P_PERSIST_KEY, &record, sizeof(record));
+	if (ret) {
+		LOG_ERR("Failed to store persistent group: %d", ret);
+		return ret;
+	}
+
+	stored_group = *group;
+	stored_valid = true;
+
+	LOG_INF("Persistent group stored (%s as %s)", group->ssid,
+		wifi_p2p_role_txt(group->role));
+
+	return 0;
+}
+
+int p2p_persist_clear(void)
+{
+	int ret;
+
+	stored_valid = false;
+
+	ret = settings_delete(P2P_PERSIST_KEY);
+	if (ret) {
+		LOG_ERR("Failed to delete persistent group: %d", ret);
+		return ret;
+	}
+
+	LOG_INF("Persistent group forgotten");
+
+	return 0;
+}
+
+static void random_chars(char *buf, size_t len)
+{
+	static const char charset[] =
+		"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
+
+	sys_rand_get(buf, len);
+
+	for (size_t i = 0; i < len; i++) {
+		buf[i] = charset[(uint8_t)buf[i] % (sizeof(charset) - 1)];
+	}
+
+	buf[len] = '\0';
+}
+
+static void p2p_persist_serve_fn(void *p1, void *p2, void *p3)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(CONFIG_P2P_PERSIST_PORT),
+		.sin_addr.s_addr = htonl(INADDR_ANY),
+	};
+	struct zsock_pollfd pfd = {
+		.events = ZSOCK_POLLIN,
+	};
+	int timeout_ms = P2P_PERSIST_SERVE_TIMEOUT_MS;
+	char buf[ECHO_PROTO_HDR_LEN + sizeof(struct p2p_persist_msg)];
+	struct p2p_persist_msg *msg = (void *)&buf[ECHO_PROTO_HDR_LEN];
+	struct sockaddr_in client;
+	socklen_t client_len;
+	struct echo_proto_hdr hdr;
+	int sock;
+	int ret;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	sock = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (sock < 0) {
+		LOG_ERR("Failed to create credential socket: %d", errno);
+		return;
+	}
+
+	if (zsock_bind(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		LOG_ERR("Failed to bind credential socket: %d", errno);
+		zsock_close(sock);
+		return;
+	}
+
+	pfd.fd = sock;
+
+	while (zsock_poll(&pfd, 1, timeout_ms) > 0) {
+		client_len = sizeof(client);
+		ret = zsock_recvfrom(sock, buf, sizeof(buf), ZSOCK_MSG_DONTWAIT,
+				     (struct sockaddr *)&client, &client_len);
+		if (ret < 0) {
+			continue;
+		}
+
+		if (echo_proto_parse(buf, ret, &hdr) != 0 ||
+		    hdr.type != ECHO_PROTO_TYPE_GROUP) {
+			continue;
+		}
+
+		memset(msg, 0, sizeof(*msg));
+		msg->channel = offer_group.channel;
+		msg->ssid_len = strlen(offer_group.ssid);
+		msg->psk_len = strlen(offer_group.psk);
+		memcpy(msg->ssid, offer_group.ssid, msg->ssid_len);
+		memcpy(msg->psk, offer_group.psk, msg->psk_len);
+
+		echo_proto_write(buf, sizeof(buf), ECHO_PROTO_TYPE_GROUP,
+				 ECHO_PROTO_FLAG_FULL_CRC, hdr.seq,
+				 time_utils_now());
+
+		ret = zsock_sendto(sock, buf, sizeof(buf), 0,
+				   (struct sockaddr *)&client, client_len);
+		if (ret < 0) {
+			LOG_WRN("Failed to send group credentials: %d", errno);
+			continue;
+		}
+
+		/* Replies may be lost, so keep answering retries for a
+		 * while; storing the same group again is harmless.
+		 */
+		offer_group.client_ip = client.sin_addr;
+		if (!stored_valid ||
+		    memcmp(&stored_group, &offer_group, sizeof(offer_group)) != 0) {
+			p2p_persist_save(&offer_group);
+		}
+
+		timeout_ms = P2P_PERSIST_RETRY_MS * 4;
+	}
+
+	if (timeout_ms == P2P_PERSIST_SERVE_TIMEOUT_MS) {
+		LOG_WRN("Client did not request group credentials");
+	}
+
+	zsock_close(sock);
+}
+
+int p2p_persist_serve(const uint8_t *peer_mac, uint8_t channel)
+{
+	if (p2p_persist_thread_started &&
+	    k_thread_join(&p2p_persist_thread, K_NO_WAIT) != 0) {
+		return -EBUSY;
+	}
+
+	memset(&offer_group, 0, sizeof(offer_group));
+	offer_group.role = WIFI_P2P_ROLE_GO;
+	offer_group.channel = channel;
+	memcpy(offer_group.peer_mac, peer_mac, WIFI_MAC_ADDR_LEN);
+
+	/* P2P group SSIDs are "DIRECT-" followed by two random characters */
+	strcpy(offer_group.ssid, "DIRECT-");
+	random_chars(&offer_group.ssid[sizeof("DIRECT-") - 1], 2);
+	strcat(offer_group.ssid, "-nRF");
+	random_chars(offer_group.psk, P2P_PERSIST_PSK_LEN);
+
+	k_thread_create(&p2p_persist_thread, p2p_persist_stack,
+			K_THREAD_STACK_SIZEOF(p2p_persist_stack),
+			p2p_persist_serve_fn, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(10), 0, K_NO_WAIT);
+	k_thread_name_set(&p2p_persist_thread, "p2p_persist");
+	p2p_persist_thread_started = true;
+
+	return 0;
+}
+
+int p2p_persist_fetch(const struct in_addr *go_addr, const uint8_t *peer_mac,
+		      const struct in_addr *client_ip, uint32_t timeout_ms,
+		      struct udp_echo_stop *stop)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(CONFIG_P2P_PERSIST_PORT),
+		.sin_addr = *go_addr,
+	};
+	struct zsock_pollfd pfds[] = {
+		{ .events = ZSOCK_POLLIN },
+		{ .fd = stop ? stop->efd : -1, .events = ZSOCK_POLLIN },
+	};
+	char buf[ECHO_PROTO_HDR_LEN + sizeof(struct p2p_persist_msg)];
+	const struct p2p_persist_msg *msg = (const void *)&buf[ECHO_PROTO_HDR_LEN];
+	struct p2p_persist_group group = {0};
+	struct echo_proto_hdr hdr;
+	int64_t start = k_uptime_get();
+	uint32_t nonce = sys_rand32_get();
+	int ret;
+
+	pfds[0].fd = zsock_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (pfds[0].fd < 0) {
+		LOG_ERR("Failed to create credential socket: %d", errno);
+		return -errno;
+	}
+
+	ret = -ETIMEDOUT;
+
+	while (k_uptime_get() - start < timeout_ms) {
+		if (stop && stop->flag) {
+			ret = -ECANCELED;
+			break;
+		}
+
+		echo_proto_write(buf, ECHO_PROTO_HDR_LEN, ECHO_PROTO_TYPE_GROUP,
+				 0, nonce, time_utils_now());
+		zsock_sendto(pfds[0].fd, buf, ECHO_PROTO_HDR_LEN, 0,
+			     (struct sockaddr *)&addr, sizeof(addr));
+
+		if (zsock_poll(pfds, ARRAY_SIZE(pfds), P2P_PERSIST_RETRY_MS) <= 0 ||
+		    !(pfds[0].revents & ZSOCK_POLLIN)) {
+			continue;
+		}
+
+		ret = zsock_recv(pfds[0].fd, buf, sizeof(buf), ZSOCK_MSG_DONTWAIT);
+		if (ret != sizeof(buf) || echo_proto_parse(buf, ret, &hdr) != 0 ||
+		    hdr.type != ECHO_PROTO_TYPE_GROUP || hdr.seq != nonce ||
+		    msg->ssid_len == 0 || msg->ssid_len > WIFI_SSID_MAX_LEN ||
+		    msg->psk_len < WIFI_PSK_MIN_LEN || msg->psk_len > WIFI_PSK_MAX_LEN) {
+			ret = -ETIMEDOUT;
+			continue;
+		}
+
+		group.role = WIFI_P2P_ROLE_CLI;
+		group.channel = msg->channel;
+		memcpy(group.peer_mac, peer_mac, WIFI_MAC_ADDR_LEN);
+		memcpy(group.ssid, msg->ssid, msg->ssid_len);
+		memcpy(group.psk, msg->psk, msg->psk_len);
+		group.client_ip = *client_ip;
+
+		ret = p2p_persist_save(&group);
+		break;
+	}
+
+	zsock_close(pfds[0].fd);
+
+	return ret;
+}
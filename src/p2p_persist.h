@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef P2P_PERSIST_H_
+#define P2P_PERSIST_H_
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/wifi.h>
+
+#include "wifi_p2p_utils.h"
+#include "udp_utils.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Persistent P2P group for fast reconnect
+ *
+ * After the first negotiated connection the GO hands the Client a set of
+ * group credentials over the new link, and both sides store them with
+ * the settings subsystem. Later pairings reinvoke that group directly
+ * (see wifi_p2p_group_reinvoke()), skipping discovery, GO negotiation,
+ * WPS and DHCP.
+ */
+
+/** Stored persistent group */
+struct p2p_persist_group {
+	/** Our role in the group (enum wifi_p2p_role) */
+	uint8_t role;
+	/** Operating channel */
+	uint8_t channel;
+	/** MAC address of the peer */
+	uint8_t peer_mac[WIFI_MAC_ADDR_LEN];
+	/** Group SSID, NUL-terminated */
+	char ssid[WIFI_SSID_MAX_LEN + 1];
+	/** Group passphrase, NUL-terminated */
+	char psk[WIFI_PSK_MAX_LEN + 1];
+	/** Client address assigned in the group */
+	struct in_addr client_ip;
+};
+
+/**
+ * @brief Load the stored group from settings
+ *
+ * @return 0 on success, negative error code on failure
+ */
+int p2p_persist_init(void);
+
+/**
+ * @brief Get the stored group
+ *
+ * @param group Output: stored group
+ * @return 0 on success, -ENOENT if no group is stored
+ */
+int p2p_persist_get(struct p2p_persist_group *group);
+
+/**
+ * @brief Store a group, replacing any previous one
+ *
+ * @param group Group to store
+ * @return 0 on success, negative error code on failure
+ */
+int p2p_persist_save(const struct p2p_persist_group *group);
+
+/**
+ * @brief Forget the stored group
+ *
+ * @return 0 on success, negative error code on failure
+ */
+int p2p_persist_clear(void);
+
+/**
+ * @brief Hand out group credentials to the Client (GO side)
+ *
+ * Generates fresh credentials and starts a thread that answers one
+ * credential request on CONFIG_P2P_PERSIST_PORT. Once the Client has
+ * them, the group is stored with the Client's address.
+ *
+ * @param peer_mac MAC address of the connected Client
+ * @param channel Operating channel of the group
+ * @return 0 on success, negative error code on failure
+ */
+int p2p_persist_serve(const uint8_t *peer_mac, uint8_t channel);
+
+/**
+ * @brief Request group credentials from the GO and store them (CLI side)
+ *
+ * @param go_addr GO address
+ * @param peer_mac MAC address of the GO
+ * @param client_ip Our address in the group
+ * @param timeout_ms Upper bound for the exchange
+ * @param stop Stop signal that ends the exchange early (can be NULL)
+ * @return 0 on success, -ETIMEDOUT if the GO did not answer, -ECANCELED
+ *         if stopped, or negative error code on failure
+ */
+int p2p_persist_fetch(const struct in_addr *go_addr, const uint8_t *peer_mac,
+		      const struct in_addr *client_ip, uint32_t timeout_ms,
+		      struct udp_echo_stop *stop);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* P2P_PERSIST_H_ */
@@ -0,0 +1,311 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/util.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(CONFIG_SETTINGS)
+#include <zephyr/settings/settings.h>
+#endif
+
+#include "peer_score.h"
+
+LOG_MODULE_REGISTER(peer_score, CONFIG_LOG_DEFAULT_LEVEL);
+
+/* Helper function to format MAC address as string */
+static inline char *format_mac_addr(const uint8_t *mac, char *buf, size_t buf_len)
+{
+	snprintf(buf, buf_len, "%02x:%02x:%02x:%02x:%02x:%02x",
+		 mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+	return buf;
+}
+
+/* P2P Capability attribute bits (Wi-Fi P2P spec, 4.1.4) */
+#define P2P_DEV_CAPAB_DEVICE_LIMIT  BIT(4)
+#define P2P_GROUP_CAPAB_GROUP_OWNER BIT(0)
+#define P2P_GROUP_CAPAB_GROUP_LIMIT BIT(2)
+
+/* RSSI smoothing: new report weighs 1/4, state scaled by 16 */
+#define RSSI_EWMA_SHIFT 2
+#define RSSI_SCALE_SHIFT 4
+
+/* Score adjustments, in dB of equivalent RSSI */
+#define SCORE_SINGLE_REPORT   (-3)
+#define SCORE_GO_ELSEWHERE    (-10)
+#define SCORE_LIMIT_REACHED   (-50)
+#define SCORE_PER_SUCCESS     5
+#define SCORE_PER_FAILURE     (-10)
+#define SCORE_HISTORY_CAP     3
+
+/* Reports of the running discovery */
+struct peer_obs {
+	uint8_t mac[WIFI_MAC_ADDR_LEN];
+	/* Smoothed RSSI and mean deviation, scaled by 16 */
+	int32_t rssi_q4;
+	int32_t dev_q4;
+	uint16_t reports;
+	uint8_t dev_capab;
+	uint8_t group_capab;
+};
+
+/* Persisted session outcome, most recently used first */
+struct peer_hist {
+	uint8_t mac[WIFI_MAC_ADDR_LEN];
+	uint8_t success;
+	uint8_t failure;
+} __packed;
+
+static struct peer_obs obs[CONFIG_WIFI_P2P_MAX_PEERS];
+static int obs_count;
+static struct k_spinlock obs_lock;
+
+static struct peer_hist hist[MAX(CONFIG_P2P_PEER_SCORE_HISTORY, 1)];
+static int hist_count;
+
+#if defined(CONFIG_SETTINGS)
+static int peer_score_settings_set(const char *name, size_t len,
+				   settings_read_cb read_cb, void *cb_arg)
+{
+	const char *next;
+	int ret;
+
+	if (!settings_name_steq(name, "hist", &next) || next) {
+		return -ENOENT;
+	}
+
+	/* History size may have changed since the record was written */
+	len = MIN(len, sizeof(hist[0]) * CONFIG_P2P_PEER_SCORE_HISTORY);
+	len -= len % sizeof(hist[0]);
+
+	ret = read_cb(cb_arg, hist, len);
+	if (ret < 0) {
+		return ret;
+	}
+
+	hist_count = ret / sizeof(hist[0]);
+
+	return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(p2p_score, "p2p_score", NULL,
+			       peer_score_settings_set, NULL, NULL);
+#endif
+
+int peer_score_init(void)
+{
+#if defined(CONFIG_SETTINGS)
+	int ret;
+
+	if (CONFIG_P2P_PEER_SCORE_HISTORY == 0) {
+		return 0;
+	}
+
+	ret = settings_subsys_init();
+	if (ret) {
+		LOG_ERR("Failed to initialize settings: %d", ret);
+		return ret;
+	}
+
+	ret = settings_load_subtree("p2p_score");
+	if (ret) {
+		LOG_WRN("Failed to load peer history: %d", ret);
+		return ret;
+	}
+
+	LOG_INF("Loaded session history for %d peer(s)", hist_count);
+#endif
+	return 0;
+}
+
+void peer_score_reset(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&obs_lock);
+
+	obs_count = 0;
+
+	k_spin_unlock(&obs_lock, key);
+}
+
+void peer_score_observe(const struct wifi_p2p_device_info *info)
+{
+	struct peer_obs *o = NULL;
+	int32_t sample = (int32_t)info->rssi << RSSI_SCALE_SHIFT;
+	int32_t diff;
+	k_spinlock_key_t key;
+	int i;
+
+	key = k_spin_lock(&obs_lock);
+
+	for (i = 0; i < obs_count; i++) {
+		if (memcmp(obs[i].mac, info->mac, WIFI_MAC_ADDR_LEN) == 0) {
+			o = &obs[i];
+			break;
+		}
+	}
+
+	if (!o) {
+		if (obs_count == ARRAY_SIZE(obs)) {
+			k_spin_unlock(&obs_lock, key);
+			return;
+		}
+
+		o = &obs[obs_count++];
+		memcpy(o->mac, info->mac, WIFI_MAC_ADDR_LEN);
+		o->rssi_q4 = sample;
+		o->dev_q4 = 0;
+		o->reports = 0;
+	}
+
+	if (o->reports > 0) {
+		diff = sample - o->rssi_q4;
+		o->rssi_q4 += diff >> RSSI_EWMA_SHIFT;
+		o->dev_q4 += ((diff < 0 ? -diff : diff) - o->dev_q4) >> RSSI_EWMA_SHIFT;
+	}
+
+	if (o->reports < UINT16_MAX) {
+		o->reports++;
+	}
+	o->dev_capab = info->dev_capab;
+	o->group_capab = info->group_capab;
+
+	k_spin_unlock(&obs_lock, key);
+}
+
+static int peer_hist_find(const uint8_t *mac)
+{
+	int i;
+
+	for (i = 0; i < hist_count; i++) {
+		if (memcmp(hist[i].mac, mac, WIFI_MAC_ADDR_LEN) == 0) {
+			return i;
+		}
+	}
+
+	return -ENOENT;
+}
+
+static int peer_score_of(const struct wifi_p2p_device_info *peer)
+{
+	struct peer_obs o = {
+		.rssi_q4 = (int32_t)peer->rssi << RSSI_SCALE_SHIFT,
+		.dev_capab = peer->dev_capab,
+		.group_capab = peer->group_capab,
+	};
+	k_spinlock_key_t key;
+	int score;
+	int i;
+
+	key = k_spin_lock(&obs_lock);
+	for (i = 0; i < obs_count; i++) {
+		if (memcmp(obs[i].mac, peer->mac, WIFI_MAC_ADDR_LEN) == 0) {
+			o = obs[i];
+			break;
+		}
+	}
+	k_spin_unlock(&obs_lock, key);
+
+	/* Rank by the lower edge of the observed RSSI spread */
+	score = (o.rssi_q4 - o.dev_q4) >> RSSI_SCALE_SHIFT;
+
+	if (o.reports < 2) {
+		score += SCORE_SINGLE_REPORT;
+	}
+
+	/* A GO of another group runs on its own channel and can only be
+	 * joined, not negotiated onto ours; a full group cannot be joined
+	 * at all.
+	 */
+	if (IS_ENABLED(CONFIG_P2P_JOIN_GROUP)) {
+		/* Joining needs a running group */
+		if (!(o.group_capab & P2P_GROUP_CAPAB_GROUP_OWNER)) {
+			score += SCORE_LIMIT_REACHED;
+		}
+	} else if (o.group_capab & P2P_GROUP_CAPAB_GROUP_OWNER) {
+		score += SCORE_GO_ELSEWHERE;
+	}
+	if ((o.group_capab & P2P_GROUP_CAPAB_GROUP_LIMIT) ||
+	    (o.dev_capab & P2P_DEV_CAPAB_DEVICE_LIMIT)) {
+		score += SCORE_LIMIT_REACHED;
+	}
+
+	i = peer_hist_find(peer->mac);
+	if (i >= 0) {
+		score += SCORE_PER_SUCCESS * MIN(hist[i].success, SCORE_HISTORY_CAP);
+		score += SCORE_PER_FAILURE * MIN(hist[i].failure, SCORE_HISTORY_CAP);
+	}
+
+	return score;
+}
+
+int peer_score_select(const struct wifi_p2p_device_info *peers, int count)
+{
+	char mac_str[sizeof("xx:xx:xx:xx:xx:xx")];
+	int best_idx = -ENOENT;
+	int best_score = INT_MIN;
+	int score;
+	int i;
+
+	for (i = 0; i < count; i++) {
+		score = peer_score_of(&peers[i]);
+
+		LOG_INF("Peer %s (%s): score %d",
+			format_mac_addr(peers[i].mac, mac_str, sizeof(mac_str)),
+			peers[i].device_name, score);
+
+		if (score > best_score) {
+			best_score = score;
+			best_idx = i;
+		}
+	}
+
+	return best_idx;
+}
+
+void peer_score_session_end(const uint8_t *mac, bool success)
+{
+	struct peer_hist entry = { 0 };
+	int idx;
+
+	if (CONFIG_P2P_PEER_SCORE_HISTORY == 0) {
+		return;
+	}
+
+	idx = peer_hist_find(mac);
+	if (idx >= 0) {
+		entry = hist[idx];
+	} else {
+		memcpy(entry.mac, mac, WIFI_MAC_ADDR_LEN);
+		idx = MIN(hist_count, CONFIG_P2P_PEER_SCORE_HISTORY - 1);
+		hist_count = idx + 1;
+	}
+
+	/* A success clears earlier failures; failures age out successes */
+	if (success) {
+		entry.success = MIN(entry.success + 1, UINT8_MAX);
+		entry.failure = 0;
+	} else {
+		entry.failure = MIN(entry.failure + 1, UINT8_MAX);
+		if (entry.success > 0) {
+			entry.success--;
+		}
+	}
+
+	/* Move to the front; the least recently used peer falls off */
+	memmove(&hist[1], &hist[0], idx * sizeof(hist[0]));
+	hist[0] = entry;
+
+#if defined(CONFIG_SETTINGS)
+	int ret = settings_save_one("p2p_score/hist", hist,
+				    hist_count * sizeof(hist[0]));
+
+	if (ret) {
+		LOG_WRN("Failed to save peer history: %d", ret);
+	}
+#endif
+}
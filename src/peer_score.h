@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef PEER_SCORE_H_
+#define PEER_SCORE_H_
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/wifi.h>
+#include <zephyr/net/wifi_mgmt.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Peer selection from link quality history
+ *
+ * Ranks discovered peers by a score built from:
+ * - the smoothed RSSI of all device-found reports in the current
+ *   discovery, less its mean deviation, so a single lucky report does
+ *   not win,
+ * - the peer's advertised P2P capabilities (already a GO elsewhere,
+ *   group or device limit reached),
+ * - the outcome of earlier sessions with that peer, persisted across
+ *   reboots when settings are enabled.
+ */
+
+/**
+ * @brief Load the session history from settings
+ *
+ * @return 0 on success, negative error code on failure
+ */
+int peer_score_init(void);
+
+/**
+ * @brief Forget the reports of the previous discovery
+ */
+void peer_score_reset(void);
+
+/**
+ * @brief Account one device-found report
+ *
+ * @param info Reported peer
+ */
+void peer_score_observe(const struct wifi_p2p_device_info *info);
+
+/**
+ * @brief Pick the best-scoring peer
+ *
+ * Peers without device-found reports are scored on their listed RSSI.
+ *
+ * @param peers Discovered peers
+ * @param count Number of entries in @p peers
+ * @return Index of the selected peer, or -ENOENT if @p count is 0
+ */
+int peer_score_select(const struct wifi_p2p_device_info *peers, int count);
+
+/**
+ * @brief Record the outcome of a session with a peer
+ *
+ * @param mac MAC address of the peer
+ * @param success Whether the bring-up reached the data plane
+ */
+void peer_score_session_end(const uint8_t *mac, bool success);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PEER_SCORE_H_ */
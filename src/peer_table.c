@@ -0,0 +1,406 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/sys/util.h>
+#include <string.h>
+
+#if defined(CONFIG_NET_DHCPV4_SERVER)
+#include <zephyr/net/dhcpv4_server.h>
+#endif
+
+#include "peer_table.h"
+
+LOG_MODULE_REGISTER(peer_table, CONFIG_LOG_DEFAULT_LEVEL);
+
+/* Open-addressing index at most half full, so probe chains stay short */
+#define PEER_HASH_BITS LOG2CEIL(2 * CONFIG_UDP_ECHO_MAX_PEERS)
+#define PEER_HASH_SIZE BIT(PEER_HASH_BITS)
+#define PEER_HASH_MASK (PEER_HASH_SIZE - 1)
+
+/* Token bucket scale: one datagram costs this many tokens */
+#define PEER_TOKEN_SCALE 1000
+/* Bucket depth: one second worth of datagrams */
+#define PEER_TOKEN_MAX ((int64_t)CONFIG_UDP_ECHO_PEER_RATE_PPS * PEER_TOKEN_SCALE)
+
+struct peer_entry {
+	struct peer_info info;
+	/* Rate limiter state */
+	int64_t tokens;
+	int64_t refill_time;
+	bool in_use;
+};
+
+static struct peer_entry entries[CONFIG_UDP_ECHO_MAX_PEERS];
+/* Entry index + 1 per slot, 0 marks an empty slot */
+static uint8_t index_tbl[PEER_HASH_SIZE];
+static int entry_count;
+static struct k_spinlock lock;
+
+BUILD_ASSERT(CONFIG_UDP_ECHO_MAX_PEERS < UINT8_MAX,
+	     "Peer index does not fit the hash slots");
+
+static inline uint32_t peer_hash(uint32_t key)
+{
+	/* Fibonacci hashing: the low octet varies most between peers */
+	return (key * 2654435761U) >> (32 - PEER_HASH_BITS) & PEER_HASH_MASK;
+}
+
+static inline uint32_t slot_key(uint32_t slot)
+{
+	return entries[index_tbl[slot] - 1].info.addr.s_addr;
+}
+
+/* Must be called with the lock held */
+static int peer_find_slot(uint32_t key)
+{
+	uint32_t slot = peer_hash(key);
+
+	while (index_tbl[slot] != 0) {
+		if (slot_key(slot) == key) {
+			return slot;
+		}
+		slot = (slot + 1) & PEER_HASH_MASK;
+	}
+
+	return -ENOENT;
+}
+
+/* Must be called with the lock held. Backward-shift deletion keeps probe
+ * chains intact without tombstones.
+ */
+static void peer_remove_slot(uint32_t slot)
+{
+	uint32_t hole = slot;
+	uint32_t next = slot;
+	uint32_t home;
+
+	entries[index_tbl[slot] - 1].in_use = false;
+	entry_count--;
+
+	for (;;) {
+		next = (next + 1) & PEER_HASH_MASK;
+		if (index_tbl[next] == 0) {
+			break;
+		}
+
+		home = peer_hash(slot_key(next));
+
+		/* Leave the entry where it is if its home slot lies
+		 * cyclically in (hole, next]
+		 */
+		if (hole <= next ? (hole < home && home <= next) :
+				   (hole < home || home <= next)) {
+			continue;
+		}
+
+		index_tbl[hole] = index_tbl[next];
+		hole = next;
+	}
+
+	index_tbl[hole] = 0;
+}
+
+/* Must be called with the lock held */
+static void peer_expire_idle(int64_t now)
+{
+	int slot;
+	int i;
+
+	if (CONFIG_UDP_ECHO_PEER_IDLE_TIMEOUT_MS == 0) {
+		return;
+	}
+
+	for (i = 0; i < ARRAY_SIZE(entries); i++) {
+		if (!entries[i].in_use ||
+		    now - entries[i].info.last_seen <
+		    CONFIG_UDP_ECHO_PEER_IDLE_TIMEOUT_MS) {
+			continue;
+		}
+
+		slot = peer_find_slot(entries[i].info.addr.s_addr);
+		if (slot >= 0) {
+			peer_remove_slot(slot);
+		}
+	}
+}
+
+/* Must be called with the lock held */
+static struct peer_entry *peer_insert(const struct in_addr *addr, int64_t now)
+{
+	struct peer_entry *entry = NULL;
+	uint32_t slot;
+	int i;
+
+	if (entry_count == ARRAY_SIZE(entries)) {
+		peer_expire_idle(now);
+		if (entry_count == ARRAY_SIZE(entries)) {
+			return NULL;
+		}
+	}
+
+	for (i = 0; i < ARRAY_SIZE(entries); i++) {
+		if (!entries[i].in_use) {
+			entry = &entries[i];
+			break;
+		}
+	}
+
+	memset(entry, 0, sizeof(*entry));
+	entry->in_use = true;
+	entry->info.addr = *addr;
+	entry->info.first_seen = now;
+	entry->tokens = PEER_TOKEN_MAX;
+	entry->refill_time = now;
+
+	slot = peer_hash(addr->s_addr);
+	while (index_tbl[slot] != 0) {
+		slot = (slot + 1) & PEER_HASH_MASK;
+	}
+	index_tbl[slot] = (uint8_t)(i + 1);
+	entry_count++;
+
+	return entry;
+}
+
+/* Must be called with the lock held */
+static bool peer_rate_allow(struct peer_entry *entry, int64_t now)
+{
+	if (CONFIG_UDP_ECHO_PEER_RATE_PPS == 0) {
+		return true;
+	}
+
+	entry->tokens += (now - entry->refill_time) *
+			 CONFIG_UDP_ECHO_PEER_RATE_PPS * PEER_TOKEN_SCALE /
+			 MSEC_PER_SEC;
+	entry->tokens = MIN(entry->tokens, PEER_TOKEN_MAX);
+	entry->refill_time = now;
+
+	if (entry->tokens < PEER_TOKEN_SCALE) {
+		return false;
+	}
+
+	entry->tokens -= PEER_TOKEN_SCALE;
+	return true;
+}
+
+void peer_table_reset(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	memset(entries, 0, sizeof(entries));
+	memset(index_tbl, 0, sizeof(index_tbl));
+	entry_count = 0;
+
+	k_spin_unlock(&lock, key);
+}
+
+int peer_table_rx(const struct in_addr *addr, const uint8_t *mac, size_t len,
+		  bool corrupt)
+{
+	struct peer_entry *entry;
+	int64_t now = k_uptime_get();
+	bool created = false;
+	k_spinlock_key_t key;
+	int slot;
+	int ret = 0;
+
+	key = k_spin_lock(&lock);
+
+	slot = peer_find_slot(addr->s_addr);
+	if (slot >= 0) {
+		entry = &entries[index_tbl[slot] - 1];
+	} else {
+		entry = peer_insert(addr, now);
+		if (!entry) {
+			k_spin_unlock(&lock, key);
+			return -ENOSPC;
+		}
+		created = true;
+	}
+
+	if (mac && !entry->info.mac_known) {
+		memcpy(entry->info.mac, mac, WIFI_MAC_ADDR_LEN);
+		entry->info.mac_known = true;
+	}
+
+	entry->info.last_seen = now;
+	entry->info.stats.packets_received++;
+	entry->info.stats.bytes_received += len;
+	if (corrupt) {
+		entry->info.stats.packets_corrupt++;
+	}
+
+	if (!peer_rate_allow(entry, now)) {
+		entry->info.stats.packets_dropped++;
+		ret = -EBUSY;
+	}
+
+	k_spin_unlock(&lock, key);
+
+	if (created) {
+		char ip_str[NET_IPV4_ADDR_LEN];
+
+		zsock_inet_ntop(AF_INET, addr, ip_str, sizeof(ip_str));
+		LOG_INF("New echo peer %s", ip_str);
+	}
+
+	return ret;
+}
+
+void peer_table_tx(const struct in_addr *addr, size_t len)
+{
+	struct peer_entry *entry;
+	k_spinlock_key_t key;
+	int slot;
+
+	key = k_spin_lock(&lock);
+
+	slot = peer_find_slot(addr->s_addr);
+	if (slot >= 0) {
+		entry = &entries[index_tbl[slot] - 1];
+		entry->info.stats.packets_sent++;
+		entry->info.stats.bytes_sent += len;
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+static int peer_remove_addr(const struct in_addr *addr)
+{
+	k_spinlock_key_t key;
+	int slot;
+
+	key = k_spin_lock(&lock);
+
+	slot = peer_find_slot(addr->s_addr);
+	if (slot >= 0) {
+		peer_remove_slot(slot);
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return slot >= 0 ? 0 : -ENOENT;
+}
+
+#if defined(CONFIG_NET_DHCPV4_SERVER)
+struct lease_match {
+	const uint8_t *mac;
+	struct in_addr addr;
+	bool found;
+};
+
+static void lease_match_cb(struct net_if *iface, struct dhcpv4_addr_slot *lease,
+			   void *user_data)
+{
+	struct lease_match *match = user_data;
+	const struct dhcpv4_client_id *id = &lease->client_id;
+
+	ARG_UNUSED(iface);
+
+	/* Client ID is the hardware type followed by the MAC address,
+	 * unless the client sent its own identifier
+	 */
+	if (match->found || lease->state == DHCPV4_SERVER_ADDR_FREE ||
+	    id->len < WIFI_MAC_ADDR_LEN ||
+	    memcmp(&id->buf[id->len - WIFI_MAC_ADDR_LEN], match->mac,
+		   WIFI_MAC_ADDR_LEN) != 0) {
+		return;
+	}
+
+	match->addr = lease->addr;
+	match->found = true;
+}
+#endif
+
+int peer_table_remove_mac(const uint8_t *mac)
+{
+	struct in_addr addr;
+	bool found = false;
+	k_spinlock_key_t key;
+	int i;
+
+	/* MAC learned from the datagram itself (zero-copy path) */
+	key = k_spin_lock(&lock);
+	for (i = 0; i < ARRAY_SIZE(entries); i++) {
+		if (entries[i].in_use && entries[i].info.mac_known &&
+		    memcmp(entries[i].info.mac, mac, WIFI_MAC_ADDR_LEN) == 0) {
+			addr = entries[i].info.addr;
+			found = true;
+			break;
+		}
+	}
+	k_spin_unlock(&lock, key);
+
+#if defined(CONFIG_NET_DHCPV4_SERVER)
+	/* Otherwise map the MAC to the address we leased to it */
+	if (!found) {
+		struct lease_match match = { .mac = mac };
+
+		net_dhcpv4_server_foreach_lease(NULL, lease_match_cb, &match);
+		addr = match.addr;
+		found = match.found;
+	}
+#endif
+
+	if (!found || peer_remove_addr(&addr) < 0) {
+		return -ENOENT;
+	}
+
+	return 0;
+}
+
+int peer_table_count(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+	int count = entry_count;
+
+	k_spin_unlock(&lock, key);
+
+	return count;
+}
+
+int peer_table_get(struct peer_info *info, int max)
+{
+	k_spinlock_key_t key;
+	int count = 0;
+	int i;
+
+	key = k_spin_lock(&lock);
+	for (i = 0; i < ARRAY_SIZE(entries) && count < max; i++) {
+		if (entries[i].in_use) {
+			info[count++] = entries[i].info;
+		}
+	}
+	k_spin_unlock(&lock, key);
+
+	return count;
+}
+
+void peer_table_print(void)
+{
+	static struct peer_info info[CONFIG_UDP_ECHO_MAX_PEERS];
+	int64_t now = k_uptime_get();
+	char ip_str[NET_IPV4_ADDR_LEN];
+	int count;
+	int i;
+
+	count = peer_table_get(info, ARRAY_SIZE(info));
+
+	LOG_INF("=== Echo Peers (%d/%d) ===", count, CONFIG_UDP_ECHO_MAX_PEERS);
+	for (i = 0; i < count; i++) {
+		zsock_inet_ntop(AF_INET, &info[i].addr, ip_str, sizeof(ip_str));
+		LOG_INF("%s: rx %u (%llu B), tx %u (%llu B), dropped %u, corrupt %u, "
+			"idle %lld ms",
+			ip_str, info[i].stats.packets_received,
+			info[i].stats.bytes_received, info[i].stats.packets_sent,
+			info[i].stats.bytes_sent, info[i].stats.packets_dropped,
+			info[i].stats.packets_corrupt, now - info[i].last_seen);
+	}
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef PEER_TABLE_H_
+#define PEER_TABLE_H_
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/wifi.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Per-peer flow table for the echo server
+ *
+ * Fixed-size table of CONFIG_UDP_ECHO_MAX_PEERS entries, keyed by the
+ * peer's IPv4 address through an open-addressing hash, so lookups cost
+ * the same regardless of how many peers are active. Each entry holds the
+ * peer's own counters, rate limiter and last-seen time. Entries are
+ * created by the first datagram from an address and removed when the
+ * peer leaves the group or has been idle for
+ * CONFIG_UDP_ECHO_PEER_IDLE_TIMEOUT_MS.
+ */
+
+/** Per-peer counters */
+struct peer_stats {
+	/** Datagrams received */
+	uint32_t packets_received;
+	/** Datagrams echoed */
+	uint32_t packets_sent;
+	/** Datagrams dropped by the rate limiter */
+	uint32_t packets_dropped;
+	/** Datagrams whose echo_proto header failed the CRC check */
+	uint32_t packets_corrupt;
+	/** Bytes received */
+	uint64_t bytes_received;
+	/** Bytes echoed */
+	uint64_t bytes_sent;
+};
+
+/** Snapshot of one table entry */
+struct peer_info {
+	/** Peer IPv4 address */
+	struct in_addr addr;
+	/** Peer MAC address, valid if mac_known */
+	uint8_t mac[WIFI_MAC_ADDR_LEN];
+	/** Whether the MAC address has been learned */
+	bool mac_known;
+	/** Uptime of the first datagram (ms) */
+	int64_t first_seen;
+	/** Uptime of the last datagram (ms) */
+	int64_t last_seen;
+	/** Counters */
+	struct peer_stats stats;
+};
+
+/**
+ * @brief Remove all entries
+ */
+void peer_table_reset(void);
+
+/**
+ * @brief Account a received datagram and decide whether to echo it
+ *
+ * Creates the peer's entry on its first datagram.
+ *
+ * @param addr Source address
+ * @param mac Source MAC address if known (can be NULL)
+ * @param len Datagram length
+ * @param corrupt Whether the datagram failed the CRC check
+ * @return 0 to echo, -EBUSY if the peer exceeds its rate limit,
+ *         -ENOSPC if the table is full
+ */
+int peer_table_rx(const struct in_addr *addr, const uint8_t *mac, size_t len,
+		  bool corrupt);
+
+/**
+ * @brief Account an echoed datagram
+ *
+ * @param addr Destination address
+ * @param len Datagram length
+ */
+void peer_table_tx(const struct in_addr *addr, size_t len);
+
+/**
+ * @brief Remove the entry of a peer that left the group
+ *
+ * @param mac MAC address of the peer
+ * @return 0 if an entry was removed, -ENOENT otherwise
+ */
+int peer_table_remove_mac(const uint8_t *mac);
+
+/**
+ * @brief Number of active entries
+ *
+ * @return Number of peers in the table
+ */
+int peer_table_count(void);
+
+/**
+ * @brief Copy the active entries
+ *
+ * @param info Output array
+ * @param max Capacity of @p info
+ * @return Number of entries copied
+ */
+int peer_table_get(struct peer_info *info, int max);
+
+/**
+ * @brief Log one line per active peer
+ */
+void peer_table_print(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PEER_TABLE_H_ */
@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/net_mgmt.h>
+#include <zephyr/net/wifi_mgmt.h>
+#include <string.h>
+
+#include "power_mgr.h"
+#include "wifi_p2p_utils.h"
+
+LOG_MODULE_REGISTER(power_mgr, CONFIG_LOG_DEFAULT_LEVEL);
+
+/* What the radio was last set to, per role */
+enum pm_target {
+	PM_TARGET_NONE,
+	PM_TARGET_STA,
+	PM_TARGET_GO,
+};
+
+struct pm_mode_acc {
+	int64_t time_ms;
+	uint64_t packets;
+	uint64_t rtt_samples;
+	uint64_t rtt_total_us;
+};
+
+static const char *const mode_txt[] = {
+	[POWER_MGR_LOW_LATENCY] = "low-latency",
+	[POWER_MGR_POWER_SAVE] = "power-save",
+};
+
+static const uint32_t mode_ua[] = {
+	[POWER_MGR_LOW_LATENCY] = CONFIG_P2P_POWER_ACTIVE_UA,
+	[POWER_MGR_POWER_SAVE] = CONFIG_P2P_POWER_SAVE_UA,
+};
+
+/* Mutex rather than spinlock: the stats snapshot can sleep while the
+ * echo thread is mid-update. All callers run in thread context.
+ */
+static K_MUTEX_DEFINE(pm_lock);
+static const struct udp_echo_stats *pm_stats;
+static struct udp_echo_stats pm_snapshot;
+static uint64_t last_received;
+static uint64_t last_rtt_total_us;
+static int64_t last_traffic;
+static int64_t last_account;
+static atomic_t holds;
+
+static enum power_mgr_mode mode = POWER_MGR_LOW_LATENCY;
+static enum pm_target applied_target;
+static struct pm_mode_acc acc[POWER_MGR_MODE_COUNT];
+static uint32_t switches;
+static int last_err;
+
+static void pm_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(pm_work, pm_work_handler);
+
+/* Called with pm_lock held */
+static void pm_account(int64_t now)
+{
+	uint64_t received, rtt_total_us;
+
+	acc[mode].time_ms += now - last_account;
+	last_account = now;
+
+	if (!pm_stats) {
+		return;
+	}
+
+	udp_echo_stats_snapshot(pm_stats, &pm_snapshot);
+	if (pm_snapshot.packets_received < last_received) {
+		/* Statistics were reset for a new session */
+		last_received = 0;
+		last_rtt_total_us = 0;
+	}
+	received = pm_snapshot.packets_received - last_received;
+	rtt_total_us = pm_snapshot.rtt_total_us - last_rtt_total_us;
+	last_received = pm_snapshot.packets_received;
+	last_rtt_total_us = pm_snapshot.rtt_total_us;
+
+	if (received == 0) {
+		return;
+	}
+
+	last_traffic = now;
+	acc[mode].packets += received;
+
+	/* Only the Client measures RTT */
+	if (rtt_total_us > 0) {
+		acc[mode].rtt_samples += received;
+		acc[mode].rtt_total_us += rtt_total_us;
+	}
+}
+
+static int pm_apply_sta(bool power_save)
+{
+	struct net_if *iface = net_if_get_first_wifi();
+	struct wifi_ps_params params = { 0 };
+	int ret;
+
+	if (CONFIG_P2P_POWER_LISTEN_INTERVAL > 0 && power_save) {
+		params.type = WIFI_PS_PARAM_WAKEUP_MODE;
+		params.wakeup_mode = WIFI_PS_WAKEUP_MODE_LISTEN_INTERVAL;
+		ret = net_mgmt(NET_REQUEST_WIFI_PS, iface, &params, sizeof(params));
+		if (ret) {
+			return ret;
+		}
+
+		params.type = WIFI_PS_PARAM_LISTEN_INTERVAL;
+		params.listen_interval = CONFIG_P2P_POWER_LISTEN_INTERVAL;
+		ret = net_mgmt(NET_REQUEST_WIFI_PS, iface, &params, sizeof(params));
+		if (ret) {
+			return ret;
+		}
+	}
+
+	params.type = WIFI_PS_PARAM_STATE;
+	params.enabled = power_save ? WIFI_PS_ENABLED : WIFI_PS_DISABLED;
+
+	return net_mgmt(NET_REQUEST_WIFI_PS, iface, &params, sizeof(params));
+}
+
+static int pm_apply_go(bool power_save)
+{
+	struct net_if *iface = net_if_get_first_wifi();
+	struct wifi_p2p_params params = { 0 };
+
+	if (!IS_ENABLED(CONFIG_P2P_POWER_GO_PS)) {
+		/* The GO always stays awake for its Clients */
+		return power_save ? -ENOTSUP : 0;
+	}
+
+	params.oper = WIFI_P2P_POWER_SAVE;
+	params.power_save = power_save;
+
+	return net_mgmt(NET_REQUEST_WIFI_P2P_OPER, iface, &params, sizeof(params));
+}
+
+static void pm_work_handler(struct k_work *work)
+{
+	enum pm_target target = wifi_p2p_get_context()->role == WIFI_P2P_ROLE_GO ?
+				PM_TARGET_GO : PM_TARGET_STA;
+	enum power_mgr_mode want = POWER_MGR_POWER_SAVE;
+	int64_t now = k_uptime_get();
+	bool sampling;
+	int ret;
+
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&pm_lock, K_FOREVER);
+	pm_account(now);
+	if (atomic_get(&holds) ||
+	    (pm_stats && now - last_traffic < CONFIG_P2P_POWER_IDLE_MS)) {
+		want = POWER_MGR_LOW_LATENCY;
+	}
+	sampling = pm_stats != NULL;
+	k_mutex_unlock(&pm_lock);
+
+	if (want != mode || target != applied_target) {
+		ret = target == PM_TARGET_GO ? pm_apply_go(want == POWER_MGR_POWER_SAVE) :
+					       pm_apply_sta(want == POWER_MGR_POWER_SAVE);
+		if (ret == 0) {
+			k_mutex_lock(&pm_lock, K_FOREVER);
+			if (want != mode) {
+				switches++;
+			}
+			mode = want;
+			k_mutex_unlock(&pm_lock);
+			applied_target = target;
+			last_err = 0;
+			LOG_INF("Power mode: %s", mode_txt[want]);
+		} else if (ret != last_err) {
+			/* Retried on the next sample, logged once */
+			last_err = ret;
+			LOG_WRN("Power mode %s not applied on the %s: %d",
+				mode_txt[want], target == PM_TARGET_GO ? "GO" : "Client",
+				ret);
+		}
+	}
+
+	if (sampling) {
+		k_work_schedule(&pm_work, K_MSEC(CONFIG_P2P_POWER_SAMPLE_MS));
+	}
+}
+
+void power_mgr_init(void)
+{
+	k_mutex_lock(&pm_lock, K_FOREVER);
+
+	last_account = k_uptime_get();
+	applied_target = PM_TARGET_NONE;
+	k_mutex_unlock(&pm_lock);
+
+	k_work_reschedule(&pm_work, K_NO_WAIT);
+}
+
+void power_mgr_start(const struct udp_echo_stats *stats)
+{
+	k_mutex_lock(&pm_lock, K_FOREVER);
+
+	pm_account(k_uptime_get());
+	pm_stats = stats;
+	last_received = 0;
+	last_rtt_total_us = 0;
+	last_traffic = k_uptime_get();
+	k_mutex_unlock(&pm_lock);
+
+	k_work_reschedule(&pm_work, K_NO_WAIT);
+}
+
+void power_mgr_stop(void)
+{
+	k_mutex_lock(&pm_lock, K_FOREVER);
+
+	pm_account(k_uptime_get());
+	pm_stats = NULL;
+	k_mutex_unlock(&pm_lock);
+
+	k_work_reschedule(&pm_work, K_NO_WAIT);
+}
+
+void power_mgr_hold(enum power_mgr_hold_reason reason, bool hold)
+{
+	atomic_val_t old;
+
+	old = hold ? atomic_or(&holds, reason) : atomic_and(&holds, ~reason);
+
+	/* Only a change of the hold set can change the mode */
+	if ((old & reason) != (hold ? reason : 0)) {
+		k_work_reschedule(&pm_work, K_NO_WAIT);
+	}
+}
+
+void power_mgr_print(void)
+{
+	struct pm_mode_acc snap[POWER_MGR_MODE_COUNT];
+	int64_t total_ms = 0;
+	uint64_t charge_total = 0;
+	uint32_t switch_cnt;
+	int i;
+
+	k_mutex_lock(&pm_lock, K_FOREVER);
+	pm_account(k_uptime_get());
+	memcpy(snap, acc, sizeof(snap));
+	switch_cnt = switches;
+	k_mutex_unlock(&pm_lock);
+
+	for (i = 0; i < POWER_MGR_MODE_COUNT; i++) {
+		total_ms += snap[i].time_ms;
+	}
+
+	LOG_INF("=== Power Modes ===");
+
+	for (i = 0; i < POWER_MGR_MODE_COUNT; i++) {
+		/* uAh = uA * ms / 3.6e6 */
+		uint64_t charge_uah = (uint64_t)mode_ua[i] * snap[i].time_ms / 3600000U;
+		uint32_t avg_rtt_us = snap[i].rtt_samples ?
+			(uint32_t)(snap[i].rtt_total_us / snap[i].rtt_samples) : 0;
+
+		charge_total += (uint64_t)mode_ua[i] * snap[i].time_ms;
+
+		LOG_INF("%-11s %lld ms (%u%%), %llu packets, RTT avg %u us, ~%llu uAh",
+			mode_txt[i], snap[i].time_ms,
+			total_ms ? (uint32_t)(snap[i].time_ms * 100 / total_ms) : 0,
+			snap[i].packets, avg_rtt_us, charge_uah);
+	}
+
+	LOG_INF("Switches: %u, estimated average current: %llu uA", switch_cnt,
+		total_ms ? charge_total / total_ms : 0);
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef POWER_MGR_H_
+#define POWER_MGR_H_
+
+#include <zephyr/kernel.h>
+
+#include "udp_utils.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Traffic-driven Wi-Fi power save management
+ *
+ * Keeps the radio in low-latency mode while echo or throughput traffic
+ * flows, a bring-up is in progress or a benchmark runs, and returns it
+ * to power save once the link was idle for CONFIG_P2P_POWER_IDLE_MS.
+ * On the Client this toggles 802.11 power save; on the GO it toggles
+ * P2P power save (CONFIG_P2P_POWER_GO_PS). For each mode the time spent,
+ * the replies and their average RTT, and a charge estimate from
+ * CONFIG_P2P_POWER_ACTIVE_UA and CONFIG_P2P_POWER_SAVE_UA are reported.
+ */
+
+/** Power modes */
+enum power_mgr_mode {
+	/** Power save disabled */
+	POWER_MGR_LOW_LATENCY,
+	/** Power save enabled */
+	POWER_MGR_POWER_SAVE,
+	POWER_MGR_MODE_COUNT,
+};
+
+/** Reasons to stay in low-latency mode regardless of traffic */
+enum power_mgr_hold_reason {
+	/** Connection bring-up in progress */
+	POWER_MGR_HOLD_BRINGUP = BIT(0),
+	/** Shell benchmark running */
+	POWER_MGR_HOLD_BENCH = BIT(1),
+};
+
+#if defined(CONFIG_P2P_POWER_MGR)
+
+/**
+ * @brief Apply the initial mode
+ *
+ * Called once the Wi-Fi interface is ready. The radio stays in power
+ * save until a bring-up, a session or a benchmark needs low latency.
+ */
+void power_mgr_init(void);
+
+/**
+ * @brief Follow the traffic of an echo session
+ *
+ * Switches to low-latency mode and samples @p stats every
+ * CONFIG_P2P_POWER_SAMPLE_MS to detect an idle link.
+ *
+ * @param stats Live statistics of the echo client or server
+ */
+void power_mgr_start(const struct udp_echo_stats *stats);
+
+/**
+ * @brief Stop following the session and return to power save
+ */
+void power_mgr_stop(void);
+
+/**
+ * @brief Set or clear a low-latency hold
+ *
+ * @param reason Hold reason
+ * @param hold True to hold low-latency mode, false to release it
+ */
+void power_mgr_hold(enum power_mgr_hold_reason reason, bool hold);
+
+/**
+ * @brief Log the time, RTT and charge estimate of each mode
+ */
+void power_mgr_print(void);
+
+#else
+
+static inline void power_mgr_init(void)
+{
+}
+
+static inline void power_mgr_start(const struct udp_echo_stats *stats)
+{
+	ARG_UNUSED(stats);
+}
+
+static inline void power_mgr_stop(void)
+{
+}
+
+static inline void power_mgr_hold(enum power_mgr_hold_reason reason, bool hold)
+{
+	ARG_UNUSED(reason);
+	ARG_UNUSED(hold);
+}
+
+static inline void power_mgr_print(void)
+{
+}
+
+#endif /* CONFIG_P2P_POWER_MGR */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* POWER_MGR_H_ */
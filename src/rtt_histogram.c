@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <string.h>
+
+#include "rtt_histogram.h"
+
+static uint32_t bucket_index(uint32_t value)
+{
+	uint32_t msb;
+	uint32_t idx;
+
+	/* Values below one octave's worth of sub-buckets map 1:1 */
+	if (value < RTT_HISTOGRAM_SUB_COUNT) {
+		return value;
+	}
+
+	msb = 31 - __builtin_clz(value);
+	idx = (msb - RTT_HISTOGRAM_SUB_BITS + 1) * RTT_HISTOGRAM_SUB_COUNT +
+	      ((value >> (msb - RTT_HISTOGRAM_SUB_BITS)) &
+	       (RTT_HISTOGRAM_SUB_COUNT - 1));
+
+	return MIN(idx, RTT_HISTOGRAM_BUCKETS - 1);
+}
+
+static uint32_t bucket_midpoint(uint32_t idx)
+{
+	uint32_t octave;
+	uint32_t sub;
+	uint32_t shift;
+
+	if (idx < RTT_HISTOGRAM_SUB_COUNT) {
+		return idx;
+	}
+
+	octave = idx / RTT_HISTOGRAM_SUB_COUNT;
+	sub = idx % RTT_HISTOGRAM_SUB_COUNT;
+	shift = octave - 1;
+
+	/* Lower bound plus half the bucket width */
+	return ((RTT_HISTOGRAM_SUB_COUNT + sub) << shift) + ((1U << shift) >> 1);
+}
+
+void rtt_histogram_reset(struct rtt_histogram *hist)
+{
+	memset(hist, 0, sizeof(*hist));
+}
+
+void rtt_histogram_add(struct rtt_histogram *hist, uint32_t value_us)
+{
+	hist->buckets[bucket_index(value_us)]++;
+	hist->count++;
+}
+
+uint32_t rtt_histogram_percentile(const struct rtt_histogram *hist,
+				  uint32_t permyriad)
+{
+	uint64_t rank;
+	uint64_t seen = 0;
+
+	if (hist->count == 0) {
+		return 0;
+	}
+
+	/* Smallest value with at least permyriad/10000 of samples at or below */
+	rank = ((uint64_t)hist->count * permyriad + 9999) / 10000;
+	if (rank == 0) {
+		rank = 1;
+	}
+
+	for (uint32_t i = 0; i < RTT_HISTOGRAM_BUCKETS; i++) {
+		seen += hist->buckets[i];
+		if (seen >= rank) {
+			return bucket_midpoint(i);
+		}
+	}
+
+	return bucket_midpoint(RTT_HISTOGRAM_BUCKETS - 1);
+}
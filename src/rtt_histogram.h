@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef RTT_HISTOGRAM_H_
+#define RTT_HISTOGRAM_H_
+
+#include <zephyr/kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Log-linear latency histogram.
+ *
+ * Every power-of-two range of microseconds is split into
+ * 2^RTT_HISTOGRAM_SUB_BITS linear sub-buckets, which bounds the relative
+ * error of a reported percentile to 1 / 2^RTT_HISTOGRAM_SUB_BITS.
+ * Values up to 2^RTT_HISTOGRAM_MAX_BITS us (~67 s) are tracked; larger
+ * values land in the last bucket.
+ */
+#define RTT_HISTOGRAM_SUB_BITS 3
+#define RTT_HISTOGRAM_SUB_COUNT (1U << RTT_HISTOGRAM_SUB_BITS)
+#define RTT_HISTOGRAM_MAX_BITS 26
+#define RTT_HISTOGRAM_BUCKETS \
+	((RTT_HISTOGRAM_MAX_BITS - RTT_HISTOGRAM_SUB_BITS + 1) * RTT_HISTOGRAM_SUB_COUNT)
+
+/** Fixed-size RTT histogram (no heap use) */
+struct rtt_histogram {
+	/** Sample count per bucket */
+	uint32_t buckets[RTT_HISTOGRAM_BUCKETS];
+	/** Total number of samples */
+	uint32_t count;
+};
+
+/**
+ * @brief Clear all samples
+ *
+ * @param hist Histogram
+ */
+void rtt_histogram_reset(struct rtt_histogram *hist);
+
+/**
+ * @brief Add one sample
+ *
+ * @param hist Histogram
+ * @param value_us Sample value in microseconds
+ */
+void rtt_histogram_add(struct rtt_histogram *hist, uint32_t value_us);
+
+/**
+ * @brief Get a percentile
+ *
+ * @param hist Histogram
+ * @param permyriad Percentile in hundredths of a percent (9990 = p99.9)
+ * @return Estimated value in microseconds (midpoint of the bucket holding
+ *         the percentile), 0 if the histogram is empty
+ */
+uint32_t rtt_histogram_percentile(const struct rtt_histogram *hist,
+				  uint32_t permyriad);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RTT_HISTOGRAM_H_ */
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef SEQLOCK_H_
+#define SEQLOCK_H_
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/barrier.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Single-writer sequence lock
+ *
+ * Lets one writer thread update a multi-word structure without ever
+ * blocking, while any number of reader threads take consistent copies.
+ * The sequence is odd while an update is in progress; readers retry if
+ * it changed while they were copying.
+ *
+ * Must not be used from ISRs, and only one thread may write a given
+ * structure.
+ */
+
+/**
+ * @brief Start an update
+ *
+ * @param seq Sequence counter of the protected structure
+ */
+static inline void seqlock_write_begin(atomic_t *seq)
+{
+	atomic_inc(seq);
+	barrier_dmem_fence_full();
+}
+
+/**
+ * @brief Finish an update
+ *
+ * @param seq Sequence counter of the protected structure
+ */
+static inline void seqlock_write_end(atomic_t *seq)
+{
+	barrier_dmem_fence_full();
+	atomic_inc(seq);
+}
+
+/**
+ * @brief Start a read
+ *
+ * Waits for an in-progress update to finish. The reader sleeps for a
+ * tick rather than spinning so that a lower priority writer can run.
+ *
+ * @param seq Sequence counter of the protected structure
+ * @return Sequence value to pass to seqlock_read_retry()
+ */
+static inline atomic_val_t seqlock_read_begin(const atomic_t *seq)
+{
+	atomic_val_t start;
+
+	while ((start = atomic_get(seq)) & 1) {
+		k_sleep(K_TICKS(1));
+	}
+
+	barrier_dmem_fence_full();
+
+	return start;
+}
+
+/**
+ * @brief Check whether a read must be repeated
+ *
+ * @param seq Sequence counter of the protected structure
+ * @param start Value returned by seqlock_read_begin()
+ * @return true if the structure changed during the read
+ */
+static inline bool seqlock_read_retry(const atomic_t *seq, atomic_val_t start)
+{
+	barrier_dmem_fence_full();
+
+	return atomic_get(seq) != start;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SEQLOCK_H_ */
@@ -0,0 +1,718 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/posix/fcntl.h>
+#include <zephyr/sys/byteorder.h>
+#include <errno.h>
+#include <string.h>
+
+#include "tcp_utils.h"
+#include "time_utils.h"
+#include "seqlock.h"
+#include "tx_sched.h"
+
+LOG_MODULE_REGISTER(tcp_utils, CONFIG_LOG_DEFAULT_LEVEL);
+
+/* Poll period without a stop eventfd, as in the UDP loops */
+#define TCP_POLL_MS 2000
+
+/* Handshake limit, as the stack's blocking connect */
+#define TCP_CONNECT_TIMEOUT_MS 3000
+
+/* Length prefix of each record */
+#define TCP_LEN_SIZE sizeof(uint16_t)
+
+/* Largest record either side sends */
+#define TCP_RECORD_MAX \
+	MAX(CONFIG_UDP_ECHO_MAX_PACKET_SIZE, CONFIG_UDP_THROUGHPUT_PACKET_SIZE)
+
+BUILD_ASSERT(TCP_RECORD_MAX <= UINT16_MAX, "Records must fit the length prefix");
+
+/* Records with their length prefix, kept off the thread stacks */
+static uint8_t server_buf[TCP_LEN_SIZE + TCP_RECORD_MAX];
+static uint8_t client_buf[TCP_LEN_SIZE + TCP_RECORD_MAX];
+
+/* The client loops keep their state in statics, so only one may run */
+static atomic_t client_active;
+
+/* Send timestamps of the requests in flight, by sequence */
+static uint64_t tx_stamps[CONFIG_UDP_ECHO_WINDOW_MAX];
+
+static void tcp_set_opts(int sock)
+{
+	int val;
+
+	if (IS_ENABLED(CONFIG_TCP_ECHO_NODELAY)) {
+		val = 1;
+		if (zsock_setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &val,
+				     sizeof(val)) < 0) {
+			LOG_WRN("Failed to set TCP_NODELAY: %d", errno);
+		}
+	}
+
+	if (CONFIG_TCP_ECHO_SNDBUF > 0) {
+		val = CONFIG_TCP_ECHO_SNDBUF;
+		if (zsock_setsockopt(sock, SOL_SOCKET, SO_SNDBUF, &val,
+				     sizeof(val)) < 0) {
+			LOG_WRN("Failed to set SO_SNDBUF: %d", errno);
+		}
+	}
+
+	if (CONFIG_TCP_ECHO_RCVBUF > 0) {
+		val = CONFIG_TCP_ECHO_RCVBUF;
+		if (zsock_setsockopt(sock, SOL_SOCKET, SO_RCVBUF, &val,
+				     sizeof(val)) < 0) {
+			LOG_WRN("Failed to set SO_RCVBUF: %d", errno);
+		}
+	}
+}
+
+/**
+ * @brief Wait until @p sock is ready for @p events
+ *
+ * @return 1 when ready, 0 on timeout, -ECANCELED if stopped, or negative
+ *         error code on failure
+ */
+static int tcp_wait(int sock, short events, struct udp_echo_stop *stop,
+		    int timeout_ms)
+{
+	struct zsock_pollfd pfds[] = {
+		{ .fd = sock, .events = events },
+		{ .fd = stop->efd, .events = ZSOCK_POLLIN },
+	};
+	int ret;
+
+	if (stop->flag) {
+		return -ECANCELED;
+	}
+
+	ret = zsock_poll(pfds, ARRAY_SIZE(pfds), timeout_ms);
+	if (ret < 0) {
+		return -errno;
+	}
+
+	if (stop->flag) {
+		return -ECANCELED;
+	}
+
+	if (pfds[0].revents & (ZSOCK_POLLERR | ZSOCK_POLLHUP | ZSOCK_POLLNVAL)) {
+		/* Let the following send or receive report the error */
+		return 1;
+	}
+
+	return (pfds[0].revents & events) ? 1 : 0;
+}
+
+/* Send all of @p buf, waiting for window space without blocking a stop */
+static int tcp_send_all(int sock, const uint8_t *buf, size_t len,
+			struct udp_echo_stop *stop)
+{
+	size_t sent = 0;
+	int ret;
+
+	while (sent < len) {
+		ret = zsock_send(sock, buf + sent, len - sent, ZSOCK_MSG_DONTWAIT);
+		if (ret > 0) {
+			sent += ret;
+			continue;
+		}
+
+		if (ret < 0 && errno != EAGAIN && errno != ENOMEM && errno != ENOBUFS) {
+			return -errno;
+		}
+
+		ret = tcp_wait(sock, ZSOCK_POLLOUT, stop, TCP_POLL_MS);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+/* Receive exactly @p len bytes; -ENOTCONN once the peer closed */
+static int tcp_recv_all(int sock, uint8_t *buf, size_t len,
+			struct udp_echo_stop *stop)
+{
+	size_t received = 0;
+	int ret;
+
+	while (received < len) {
+		ret = zsock_recv(sock, buf + received, len - received,
+				 ZSOCK_MSG_DONTWAIT);
+		if (ret > 0) {
+			received += ret;
+			continue;
+		}
+
+		if (ret == 0) {
+			return -ENOTCONN;
+		}
+
+		if (errno != EAGAIN) {
+			return -errno;
+		}
+
+		ret = tcp_wait(sock, ZSOCK_POLLIN, stop, TCP_POLL_MS);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Receive one length-prefixed record into @p buf
+ *
+ * @return Record length, or negative error code
+ */
+static int tcp_recv_record(int sock, uint8_t *buf, struct udp_echo_stop *stop)
+{
+	uint16_t len;
+	int ret;
+
+	ret = tcp_recv_all(sock, buf, TCP_LEN_SIZE, stop);
+	if (ret < 0) {
+		return ret;
+	}
+
+	len = sys_get_le16(buf);
+	if (len < ECHO_PROTO_HDR_LEN || len > TCP_RECORD_MAX) {
+		/* The byte stream cannot be resynchronized */
+		LOG_ERR("Bad TCP record length %u", len);
+		return -EBADMSG;
+	}
+
+	ret = tcp_recv_all(sock, buf + TCP_LEN_SIZE, len, stop);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return len;
+}
+
+static int tcp_connect(const struct sockaddr_in *server_addr,
+		       struct udp_echo_stop *stop)
+{
+	char ip_str[INET_ADDRSTRLEN];
+	socklen_t err_len = sizeof(int);
+	int sock, flags, err;
+	int ret;
+
+	sock = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (sock < 0) {
+		LOG_ERR("Failed to create TCP socket: %d", errno);
+		return -errno;
+	}
+
+	/* Set before connecting so the window is advertised in the SYN */
+	tcp_set_opts(sock);
+
+	zsock_inet_ntop(AF_INET, &server_addr->sin_addr, ip_str, sizeof(ip_str));
+
+	/* Connect in the background so a stop request ends the handshake */
+	flags = zsock_fcntl(sock, F_GETFL, 0);
+	if (flags < 0 || zsock_fcntl(sock, F_SETFL, flags | O_NONBLOCK) < 0) {
+		ret = -errno;
+		goto fail;
+	}
+
+	ret = zsock_connect(sock, (const struct sockaddr *)server_addr,
+			    sizeof(*server_addr));
+	if (ret < 0 && errno != EINPROGRESS) {
+		ret = -errno;
+		goto fail;
+	}
+
+	if (ret < 0) {
+		ret = tcp_wait(sock, ZSOCK_POLLOUT, stop, TCP_CONNECT_TIMEOUT_MS);
+		if (ret == 0) {
+			ret = -ETIMEDOUT;
+		}
+		if (ret < 0) {
+			goto fail;
+		}
+
+		if (zsock_getsockopt(sock, SOL_SOCKET, SO_ERROR, &err, &err_len) < 0) {
+			ret = -errno;
+			goto fail;
+		}
+		if (err) {
+			ret = -err;
+			goto fail;
+		}
+	}
+
+	/* The loops pass ZSOCK_MSG_DONTWAIT themselves */
+	(void)zsock_fcntl(sock, F_SETFL, flags);
+
+	LOG_INF("TCP connected to %s:%d", ip_str, ntohs(server_addr->sin_port));
+
+	return sock;
+
+fail:
+	if (ret != -ECANCELED) {
+		LOG_ERR("TCP connect to %s:%d failed: %d", ip_str,
+			ntohs(server_addr->sin_port), ret);
+	}
+	zsock_close(sock);
+	return ret;
+}
+
+static void tcp_serve(int conn, struct udp_echo_stop *stop)
+{
+	struct echo_proto_hdr hdr;
+	uint32_t echoed = 0;
+	uint32_t streamed = 0;
+	uint64_t bytes = 0;
+	int len;
+	int ret;
+
+	while (true) {
+		len = tcp_recv_record(conn, server_buf, stop);
+		if (len < 0) {
+			ret = len;
+			break;
+		}
+
+		bytes += len;
+
+		ret = echo_proto_parse(server_buf + TCP_LEN_SIZE, len, &hdr);
+		if (ret == 0 && hdr.type == ECHO_PROTO_TYPE_STREAM) {
+			udp_stream_rx_packet(UDP_STREAM_RX_TCP, &hdr, len);
+			streamed++;
+			continue;
+		}
+
+		/* Corrupt and foreign records are echoed too, as over UDP */
+		ret = tcp_send_all(conn, server_buf, TCP_LEN_SIZE + len, stop);
+		if (ret < 0) {
+			break;
+		}
+		echoed++;
+	}
+
+	if (ret != -ENOTCONN && ret != -ECANCELED) {
+		LOG_WRN("TCP connection error: %d", ret);
+	}
+
+	LOG_INF("TCP connection closed: %u echoed, %u stream records, %llu bytes",
+		echoed, streamed, (unsigned long long)bytes);
+}
+
+int tcp_echo_server_run(uint16_t port, struct udp_echo_stop *stop)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(port),
+		.sin_addr.s_addr = INADDR_ANY,
+	};
+	struct sockaddr_in peer;
+	socklen_t peer_len;
+	char ip_str[INET_ADDRSTRLEN];
+	int lsock, conn;
+	int val = 1;
+	int ret;
+
+	lsock = zsock_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (lsock < 0) {
+		LOG_ERR("Failed to create TCP socket: %d", errno);
+		return -errno;
+	}
+
+	/* Rebind right away after a restart of the server */
+	(void)zsock_setsockopt(lsock, SOL_SOCKET, SO_REUSEADDR, &val, sizeof(val));
+
+	/* Also on the listener, for the window advertised in the SYN-ACK */
+	tcp_set_opts(lsock);
+
+	if (zsock_bind(lsock, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+	    zsock_listen(lsock, 1) < 0) {
+		ret = -errno;
+		LOG_ERR("Failed to listen on TCP port %d: %d", port, ret);
+		zsock_close(lsock);
+		return ret;
+	}
+
+	LOG_INF("TCP Echo Server listening on port %d", port);
+
+	while (true) {
+		ret = tcp_wait(lsock, ZSOCK_POLLIN, stop, TCP_POLL_MS);
+		if (ret == 0) {
+			continue;
+		}
+		if (ret < 0) {
+			break;
+		}
+
+		peer_len = sizeof(peer);
+		conn = zsock_accept(lsock, (struct sockaddr *)&peer, &peer_len);
+		if (conn < 0) {
+			LOG_WRN("TCP accept failed: %d", errno);
+			continue;
+		}
+
+		tcp_set_opts(conn);
+
+		zsock_inet_ntop(AF_INET, &peer.sin_addr, ip_str, sizeof(ip_str));
+		LOG_INF("TCP connection from %s:%d", ip_str, ntohs(peer.sin_port));
+
+		tcp_serve(conn, stop);
+		zsock_close(conn);
+	}
+
+	zsock_close(lsock);
+
+	LOG_INF("TCP Echo Server stopped");
+	return ret == -ECANCELED ? 0 : ret;
+}
+
+static void tcp_fill_record(uint8_t *buf, size_t len, enum echo_proto_type type,
+			    uint16_t flags, uint32_t seq, uint64_t tx_time)
+{
+	sys_put_le16(len, buf);
+	echo_proto_write(buf + TCP_LEN_SIZE, len, type, flags, seq, tx_time);
+}
+
+static uint64_t tcp_echo_period_ns(const struct udp_echo_client_params *params)
+{
+	if (params->rate_pps > 0) {
+		return NSEC_PER_SEC / params->rate_pps;
+	}
+
+	return (uint64_t)params->interval_ms * NSEC_PER_MSEC;
+}
+
+/* Match a reply with the oldest request in flight */
+static int tcp_echo_handle_reply(int sock, uint32_t expected_seq,
+				 bool verbose, struct udp_echo_stats *stats,
+				 struct udp_echo_stop *stop)
+{
+	static uint8_t reply_buf[TCP_LEN_SIZE + TCP_RECORD_MAX];
+	struct echo_proto_hdr hdr;
+	uint32_t rtt_us;
+	uint64_t rx_time;
+	int len;
+	int ret;
+
+	len = tcp_recv_record(sock, reply_buf, stop);
+	if (len < 0) {
+		return len;
+	}
+
+	rx_time = time_utils_now();
+	rtt_us = time_utils_delta_us(tx_stamps[expected_seq % CONFIG_UDP_ECHO_WINDOW_MAX],
+				     rx_time);
+
+	ret = echo_proto_parse(reply_buf + TCP_LEN_SIZE, len, &hdr);
+	if (ret == 0 && (hdr.type != ECHO_PROTO_TYPE_ECHO || hdr.seq != expected_seq)) {
+		ret = -EINVAL;
+	}
+
+	if (stats) {
+		seqlock_write_begin(&stats->seq);
+		stats->packets_received++;
+		stats->bytes_received += len;
+		if (ret < 0) {
+			stats->packets_corrupt++;
+		}
+		udp_echo_stats_add_rtt(stats, rtt_us);
+		seqlock_write_end(&stats->seq);
+	}
+
+	if (ret < 0) {
+		LOG_WRN("Unexpected TCP echo reply (%d bytes): %d", len, ret);
+	} else if (verbose) {
+		LOG_INF("TCP echo reply: seq=%u, bytes=%d, RTT=%u.%03u ms",
+			hdr.seq, len, rtt_us / 1000, rtt_us % 1000);
+	} else {
+		LOG_DBG("TCP echo reply: seq=%u, bytes=%d, RTT=%u.%03u ms",
+			hdr.seq, len, rtt_us / 1000, rtt_us % 1000);
+	}
+
+	return 0;
+}
+
+/* Send one request from client_buf. While the send window is full, also
+ * take replies: the server blocks on echoing into a full receive window,
+ * and would stop reading our requests.
+ */
+static int tcp_echo_send_request(int sock, size_t len, uint32_t next_seq,
+				 uint32_t *in_flight, bool verbose,
+				 struct udp_echo_stats *stats,
+				 struct udp_echo_stop *stop)
+{
+	size_t sent = 0;
+	int ret;
+
+	while (sent < len) {
+		ret = zsock_send(sock, client_buf + sent, len - sent,
+				 ZSOCK_MSG_DONTWAIT);
+		if (ret > 0) {
+			sent += ret;
+			continue;
+		}
+
+		if (ret < 0 && errno != EAGAIN && errno != ENOMEM && errno != ENOBUFS) {
+			return -errno;
+		}
+
+		ret = tcp_wait(sock, ZSOCK_POLLOUT | (*in_flight ? ZSOCK_POLLIN : 0),
+			       stop, TCP_POLL_MS);
+		if (ret < 0) {
+			return ret;
+		}
+
+		if (ret == 0 || *in_flight == 0 ||
+		    tcp_wait(sock, ZSOCK_POLLIN, stop, 0) != 1) {
+			continue;
+		}
+
+		ret = tcp_echo_handle_reply(sock, next_seq - *in_flight, verbose,
+					    stats, stop);
+		if (ret < 0) {
+			return ret;
+		}
+		(*in_flight)--;
+	}
+
+	return 0;
+}
+
+static int tcp_echo_client_loop(int sock, const struct udp_echo_client_params *params,
+				size_t packet_size, uint32_t window,
+				struct udp_echo_stats *stats,
+				struct udp_echo_stop *stop)
+{
+	struct tx_sched sched;
+	uint32_t next_seq = 0;
+	uint32_t in_flight = 0;
+	/* Stop-and-wait keeps one log line per reply */
+	bool verbose = (window == 1);
+	int ret;
+
+	tx_sched_init(&sched, params->pattern, tcp_echo_period_ns(params),
+		      params->burst);
+
+	for (size_t i = ECHO_PROTO_HDR_LEN; i < packet_size; i++) {
+		client_buf[TCP_LEN_SIZE + i] = 'A' + (i % 26);
+	}
+
+	while (!stop->flag) {
+		bool more_to_send = params->count == 0 || next_seq < params->count;
+		int timeout_ms = TCP_POLL_MS;
+		bool send_ready = false;
+		uint64_t now;
+
+		if (!more_to_send && in_flight == 0) {
+			LOG_INF("Completed %d TCP echo requests", params->count);
+			break;
+		}
+
+		/* Send on the scheduler's deadline if the window has room */
+		if (more_to_send && in_flight < window) {
+			uint64_t deadline = tx_sched_deadline(&sched);
+
+			now = time_utils_now();
+			if (now >= deadline) {
+				tx_stamps[next_seq % CONFIG_UDP_ECHO_WINDOW_MAX] = now;
+				tcp_fill_record(client_buf, packet_size, ECHO_PROTO_TYPE_ECHO,
+						0, next_seq, now);
+
+				ret = tcp_echo_send_request(sock, TCP_LEN_SIZE + packet_size,
+							    next_seq, &in_flight, verbose,
+							    stats, stop);
+				if (ret < 0) {
+					return ret;
+				}
+
+				in_flight++;
+				next_seq++;
+				tx_sched_advance(&sched);
+
+				if (stats) {
+					seqlock_write_begin(&stats->seq);
+					stats->packets_sent++;
+					stats->bytes_sent += packet_size;
+					seqlock_write_end(&stats->seq);
+				}
+				continue;
+			}
+
+			/* Sub-millisecond remainders are slept by tx_sched_wait() */
+			timeout_ms = time_utils_delta_us(now, deadline) / USEC_PER_MSEC;
+			send_ready = true;
+		}
+
+		/* With nothing in flight only the stop signal can wake us */
+		ret = tcp_wait(sock, in_flight ? ZSOCK_POLLIN : 0, stop, timeout_ms);
+		if (ret < 0) {
+			return ret == -ECANCELED ? 0 : ret;
+		}
+
+		if (ret == 0 || in_flight == 0) {
+			if (send_ready && timeout_ms == 0) {
+				tx_sched_wait(&sched);
+			}
+			continue;
+		}
+
+		ret = tcp_echo_handle_reply(sock, next_seq - in_flight, verbose,
+					    stats, stop);
+		if (ret < 0) {
+			return ret == -ECANCELED ? 0 : ret;
+		}
+		in_flight--;
+	}
+
+	if (sched.missed > 0) {
+		LOG_WRN("%u send deadlines missed (window full or sender too slow)",
+			sched.missed);
+	}
+
+	return 0;
+}
+
+int tcp_echo_client_run(const struct sockaddr_in *server_addr,
+			const struct udp_echo_client_params *params,
+			struct udp_echo_stats *stats,
+			struct udp_echo_stop *stop)
+{
+	size_t packet_size = CLAMP(params->packet_size, ECHO_PROTO_HDR_LEN,
+				   TCP_RECORD_MAX);
+	uint32_t window = CLAMP(params->window, 1, CONFIG_UDP_ECHO_WINDOW_MAX);
+	int sock;
+	int ret;
+
+	if (!atomic_cas(&client_active, 0, 1)) {
+		LOG_ERR("Another TCP client is running");
+		return -EBUSY;
+	}
+
+	LOG_INF("TCP Echo Client started");
+	LOG_INF("  Packet size: %d bytes, window: %u, nodelay: %s", packet_size,
+		window, IS_ENABLED(CONFIG_TCP_ECHO_NODELAY) ? "on" : "off");
+
+	sock = tcp_connect(server_addr, stop);
+	if (sock < 0) {
+		atomic_clear(&client_active);
+		return sock == -ECANCELED ? 0 : sock;
+	}
+
+	ret = tcp_echo_client_loop(sock, params, packet_size, window, stats, stop);
+	if (ret < 0) {
+		LOG_ERR("TCP echo client error: %d", ret);
+	}
+
+	zsock_close(sock);
+	atomic_clear(&client_active);
+
+	LOG_INF("TCP Echo Client stopped");
+	return ret;
+}
+
+int tcp_stream_client_run(const struct sockaddr_in *server_addr,
+			  const struct udp_stream_params *params,
+			  struct udp_echo_stats *stats,
+			  struct udp_echo_stop *stop)
+{
+	size_t packet_size = CLAMP(params->packet_size, ECHO_PROTO_HDR_LEN,
+				   TCP_RECORD_MAX);
+	struct tx_sched sched;
+	uint64_t period_ns = 0;
+	uint64_t start_us, now_us;
+	uint64_t bytes_sent = 0;
+	uint32_t seq = 0;
+	int sock;
+	int ret = 0;
+
+	if (!atomic_cas(&client_active, 0, 1)) {
+		LOG_ERR("Another TCP client is running");
+		return -EBUSY;
+	}
+
+	if (params->rate_kbps > 0) {
+		period_ns = (packet_size * 8ULL * NSEC_PER_MSEC) / params->rate_kbps;
+	}
+
+	LOG_INF("TCP Throughput Stream started");
+	LOG_INF("  Packet size: %d bytes", packet_size);
+	LOG_INF("  Target rate: %s%u kbit/s", params->rate_kbps ? "" : "max, ",
+		params->rate_kbps);
+	LOG_INF("  Duration: %u ms", params->duration_ms);
+
+	sock = tcp_connect(server_addr, stop);
+	if (sock < 0) {
+		atomic_clear(&client_active);
+		return sock == -ECANCELED ? 0 : sock;
+	}
+
+	memset(client_buf + TCP_LEN_SIZE, 'S', packet_size);
+
+	tx_sched_init(&sched, TX_SCHED_PERIODIC, period_ns, 1);
+	start_us = time_utils_to_us(time_utils_now());
+
+	while (!stop->flag) {
+		now_us = time_utils_to_us(time_utils_now());
+
+		if (params->duration_ms > 0 &&
+		    now_us - start_us >= params->duration_ms * 1000ULL) {
+			break;
+		}
+
+		tx_sched_wait(&sched);
+
+		tcp_fill_record(client_buf, packet_size, ECHO_PROTO_TYPE_STREAM, 0,
+				seq, time_utils_now());
+
+		/* Blocks while the send window is full */
+		ret = tcp_send_all(sock, client_buf, TCP_LEN_SIZE + packet_size, stop);
+		if (ret < 0) {
+			break;
+		}
+
+		bytes_sent += packet_size;
+		seq++;
+		tx_sched_advance(&sched);
+
+		if (stats) {
+			seqlock_write_begin(&stats->seq);
+			stats->packets_sent++;
+			stats->bytes_sent += packet_size;
+			seqlock_write_end(&stats->seq);
+		}
+	}
+
+	if (ret == -ECANCELED) {
+		ret = 0;
+	} else if (ret < 0) {
+		LOG_ERR("TCP stream send error: %d", ret);
+	} else {
+		/* Tell the receiver to print its totals; TCP delivers it */
+		tcp_fill_record(client_buf, ECHO_PROTO_HDR_LEN, ECHO_PROTO_TYPE_STREAM,
+				ECHO_PROTO_FLAG_END, seq, time_utils_now());
+		(void)tcp_send_all(sock, client_buf, TCP_LEN_SIZE + ECHO_PROTO_HDR_LEN,
+				   stop);
+	}
+
+	now_us = time_utils_to_us(time_utils_now());
+	if (now_us > start_us) {
+		LOG_INF("TCP stream sent %u packets, %llu bytes in %u ms (%u kbit/s)",
+			seq, (unsigned long long)bytes_sent,
+			(uint32_t)((now_us - start_us) / 1000),
+			(uint32_t)((bytes_sent * 8 * 1000) / (now_us - start_us)));
+	}
+
+	zsock_close(sock);
+	atomic_clear(&client_active);
+
+	LOG_INF("TCP Throughput Stream stopped");
+	return ret;
+}
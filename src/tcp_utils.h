@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef TCP_UTILS_H_
+#define TCP_UTILS_H_
+
+#include <zephyr/kernel.h>
+#include <zephyr/net/socket.h>
+
+#include "udp_utils.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief TCP echo and throughput stream, for comparison with UDP
+ *
+ * The same echo requests and stream packets as the UDP modes are sent
+ * over a TCP connection, each preceded by its 16-bit little-endian length
+ * since TCP has no datagram boundaries. Requests are paced by the same
+ * scheduler and replies feed the same statistics and RTT histogram, so
+ * the results compare directly with a UDP run. Stream packets are
+ * accounted by the UDP stream receiver. CONFIG_TCP_ECHO_NODELAY,
+ * CONFIG_TCP_ECHO_SNDBUF and CONFIG_TCP_ECHO_RCVBUF apply to both ends.
+ */
+
+/**
+ * @brief Run TCP echo server (blocks and loops back records)
+ *
+ * Serves one connection at a time; further Clients wait in the listen
+ * backlog. Echo requests are echoed, stream packets are accounted as in
+ * udp_echo_server_run().
+ *
+ * @param port Port number to listen on
+ * @param stop Stop signal
+ * @return 0 on success, negative error code on failure
+ */
+int tcp_echo_server_run(uint16_t port, struct udp_echo_stop *stop);
+
+/**
+ * @brief Run TCP echo client (sends requests and measures RTT)
+ *
+ * Keeps up to @p params->window requests in flight; TCP returns the
+ * replies in order. Only one TCP client runs at a time.
+ *
+ * @param server_addr Server address, with the TCP echo port
+ * @param params Client parameters (packet size, interval, count, window)
+ * @param stats Pointer to statistics structure (can be NULL)
+ * @param stop Stop signal
+ * @return 0 on success, -EBUSY if another TCP client is running, or
+ *         negative error code on failure
+ */
+int tcp_echo_client_run(const struct sockaddr_in *server_addr,
+			const struct udp_echo_client_params *params,
+			struct udp_echo_stats *stats,
+			struct udp_echo_stop *stop);
+
+/**
+ * @brief Run TCP throughput stream sender
+ *
+ * Sends stream packets at the requested rate, or as fast as the
+ * connection accepts them, and ends the stream so the server logs its
+ * totals. Only one TCP client runs at a time.
+ *
+ * @param server_addr Server address, with the TCP echo port
+ * @param params Stream parameters
+ * @param stats Pointer to statistics structure (can be NULL)
+ * @param stop Stop signal
+ * @return 0 on success, -EBUSY if another TCP client is running, or
+ *         negative error code on failure
+ */
+int tcp_stream_client_run(const struct sockaddr_in *server_addr,
+			  const struct udp_stream_params *params,
+			  struct udp_echo_stats *stats,
+			  struct udp_echo_stop *stop);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TCP_UTILS_H_ */
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "thread_stats.h"
+
+LOG_MODULE_REGISTER(thread_stats, CONFIG_LOG_DEFAULT_LEVEL);
+
+#define TS_MAX CONFIG_P2P_THREAD_STATS_MAX
+#define TS_NAME_LEN 16
+
+struct ts_sample {
+	k_tid_t tid;
+	uint64_t cycles;
+};
+
+struct ts_thread {
+	struct ts_sample sample;
+	char name[TS_NAME_LEN];
+	int prio;
+	size_t unused;
+	int stack_err;
+};
+
+struct ts_collect {
+	struct ts_thread *threads;
+	size_t count;
+	size_t dropped;
+};
+
+/* Serializes reports, which can come from the button, echo stop and timer */
+static K_MUTEX_DEFINE(ts_lock);
+static struct ts_thread cur[TS_MAX];
+static struct ts_sample prev[TS_MAX];
+static size_t prev_count;
+static int64_t prev_time;
+
+#if CONFIG_P2P_THREAD_STATS_INTERVAL_MS > 0
+static void ts_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(ts_work, ts_work_handler);
+#endif
+
+static void ts_collect_cb(const struct k_thread *thread, void *user_data)
+{
+	struct ts_collect *col = user_data;
+	k_tid_t tid = (k_tid_t)thread;
+	struct ts_thread *t;
+	k_thread_runtime_stats_t rt;
+	const char *name;
+
+	if (col->count >= TS_MAX) {
+		col->dropped++;
+		return;
+	}
+
+	if (k_thread_runtime_stats_get(tid, &rt) != 0) {
+		return;
+	}
+
+	t = &col->threads[col->count++];
+	t->sample.tid = tid;
+	t->sample.cycles = rt.execution_cycles;
+	t->prio = k_thread_priority_get(tid);
+	t->stack_err = k_thread_stack_space_get(thread, &t->unused);
+
+	name = k_thread_name_get(tid);
+	if (name && name[0]) {
+		strncpy(t->name, name, sizeof(t->name) - 1);
+		t->name[sizeof(t->name) - 1] = '\0';
+	} else {
+		snprintf(t->name, sizeof(t->name), "%p", (void *)tid);
+	}
+}
+
+static uint64_t ts_prev_cycles(k_tid_t tid)
+{
+	for (size_t i = 0; i < prev_count; i++) {
+		if (prev[i].tid == tid) {
+			return prev[i].cycles;
+		}
+	}
+
+	/* Started since the previous report */
+	return 0;
+}
+
+void thread_stats_print(void)
+{
+	struct ts_collect col = { .threads = cur };
+	uint64_t delta[TS_MAX];
+	uint64_t total = 0;
+	uint64_t idle = 0;
+	int64_t now;
+	bool first;
+
+	k_mutex_lock(&ts_lock, K_FOREVER);
+
+	/* Stack scans take a while; don't hold the thread list lock for them */
+	k_thread_foreach_unlocked(ts_collect_cb, &col);
+	now = k_uptime_get();
+	first = prev_time == 0;
+
+	for (size_t i = 0; i < col.count; i++) {
+		uint64_t before = ts_prev_cycles(cur[i].sample.tid);
+
+		delta[i] = cur[i].sample.cycles >= before ?
+			   cur[i].sample.cycles - before : cur[i].sample.cycles;
+		total += delta[i];
+		if (cur[i].prio == K_IDLE_PRIO) {
+			idle += delta[i];
+		}
+	}
+
+	if (first) {
+		LOG_INF("=== Threads (since boot, %lld ms) ===", now);
+	} else {
+		LOG_INF("=== Threads (last %lld ms) ===", now - prev_time);
+	}
+
+	for (size_t i = 0; i < col.count; i++) {
+		/* Tenths of a percent */
+		uint32_t cpu = total ? (uint32_t)(delta[i] * 1000U / total) : 0;
+
+		if (cur[i].stack_err == 0) {
+			LOG_INF("%-16s prio %3d  cpu %3u.%u%%  stack free %zu B",
+				cur[i].name, cur[i].prio, cpu / 10, cpu % 10,
+				cur[i].unused);
+		} else {
+			LOG_INF("%-16s prio %3d  cpu %3u.%u%%", cur[i].name,
+				cur[i].prio, cpu / 10, cpu % 10);
+		}
+	}
+
+	if (col.dropped) {
+		LOG_WRN("%zu threads not shown, raise CONFIG_P2P_THREAD_STATS_MAX",
+			col.dropped);
+	}
+
+	if (total) {
+		uint32_t headroom = (uint32_t)(idle * 1000U / total);
+
+		LOG_INF("CPU headroom: %u.%u%% idle", headroom / 10, headroom % 10);
+	}
+
+	for (size_t i = 0; i < col.count; i++) {
+		prev[i] = cur[i].sample;
+	}
+	prev_count = col.count;
+	prev_time = now;
+
+	k_mutex_unlock(&ts_lock);
+}
+
+#if CONFIG_P2P_THREAD_STATS_INTERVAL_MS > 0
+static void ts_work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	thread_stats_print();
+	k_work_schedule(&ts_work, K_MSEC(CONFIG_P2P_THREAD_STATS_INTERVAL_MS));
+}
+#endif
+
+void thread_stats_init(void)
+{
+#if CONFIG_P2P_THREAD_STATS_INTERVAL_MS > 0
+	k_work_schedule(&ts_work, K_MSEC(CONFIG_P2P_THREAD_STATS_INTERVAL_MS));
+#endif
+}
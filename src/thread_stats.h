@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef THREAD_STATS_H_
+#define THREAD_STATS_H_
+
+#include <zephyr/kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Per-thread CPU usage and stack statistics
+ *
+ * Each report lists every thread with its priority, its share of the CPU
+ * time since the previous report (since boot for the first one) and its
+ * unused stack, followed by the idle share as CPU headroom. Time spent
+ * in interrupts is counted towards the interrupted thread. Reports are
+ * logged on demand and, with CONFIG_P2P_THREAD_STATS_INTERVAL_MS, also
+ * periodically.
+ */
+
+#if defined(CONFIG_P2P_THREAD_STATS)
+
+/**
+ * @brief Start the periodic report, if configured
+ */
+void thread_stats_init(void);
+
+/**
+ * @brief Log the thread statistics
+ */
+void thread_stats_print(void);
+
+#else
+
+static inline void thread_stats_init(void)
+{
+}
+
+static inline void thread_stats_print(void)
+{
+}
+
+#endif /* CONFIG_P2P_THREAD_STATS */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* THREAD_STATS_H_ */
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef TIME_UTILS_H_
+#define TIME_UTILS_H_
+
+#include <zephyr/kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief High-resolution timestamps for latency measurement
+ *
+ * Timestamps are kept in the raw unit of the selected backend (hardware
+ * cycles or system ticks) so that taking one costs a single counter read.
+ * Conversion to microseconds only happens when a delta is reported.
+ */
+
+/**
+ * @brief Get the current timestamp in backend units
+ *
+ * @return Current timestamp
+ */
+static inline uint64_t time_utils_now(void)
+{
+#if defined(CONFIG_UDP_ECHO_TIMING_CYCLES)
+	return k_cycle_get_64();
+#else
+	return (uint64_t)k_uptime_ticks();
+#endif
+}
+
+/**
+ * @brief Convert a timestamp delta to microseconds
+ *
+ * @param delta Timestamp delta in backend units
+ * @return Delta in microseconds
+ */
+static inline uint64_t time_utils_to_us(uint64_t delta)
+{
+#if defined(CONFIG_UDP_ECHO_TIMING_CYCLES)
+	return k_cyc_to_us_near64(delta);
+#else
+	return k_ticks_to_us_near64(delta);
+#endif
+}
+
+/**
+ * @brief Convert a timestamp to nanoseconds
+ *
+ * @param t Timestamp in backend units
+ * @return Time in nanoseconds
+ */
+static inline uint64_t time_utils_to_ns(uint64_t t)
+{
+#if defined(CONFIG_UDP_ECHO_TIMING_CYCLES)
+	return k_cyc_to_ns_near64(t);
+#else
+	return k_ticks_to_ns_near64(t);
+#endif
+}
+
+/**
+ * @brief Build an absolute kernel timeout that expires at a timestamp
+ *
+ * Rounded up to the next system tick, so a sleep never ends early.
+ *
+ * @param t Timestamp in backend units
+ * @return Absolute timeout
+ */
+static inline k_timeout_t time_utils_timeout_abs(uint64_t t)
+{
+#if defined(CONFIG_UDP_ECHO_TIMING_CYCLES)
+	return K_TIMEOUT_ABS_TICKS(k_cyc_to_ticks_ceil64(t));
+#else
+	return K_TIMEOUT_ABS_TICKS(t);
+#endif
+}
+
+/**
+ * @brief Convert a system-clock time in nanoseconds to backend units
+ *
+ * Used to bring socket-layer packet timestamps into the same time base as
+ * time_utils_now().
+ *
+ * @param ns Time in nanoseconds since boot
+ * @return Timestamp in backend units
+ */
+static inline uint64_t time_utils_from_ns(uint64_t ns)
+{
+#if defined(CONFIG_UDP_ECHO_TIMING_CYCLES)
+	return k_ns_to_cyc_near64(ns);
+#else
+	return k_ns_to_ticks_near64(ns);
+#endif
+}
+
+/**
+ * @brief Rate of the backend, in units per second
+ *
+ * Sent in readiness probes so a host peer can convert stream timestamps.
+ *
+ * @return Cycle rate, or CONFIG_SYS_CLOCK_TICKS_PER_SEC for uptime ticks
+ */
+static inline uint32_t time_utils_hz(void)
+{
+#if defined(CONFIG_UDP_ECHO_TIMING_CYCLES)
+	return sys_clock_hw_cycles_per_sec();
+#else
+	return CONFIG_SYS_CLOCK_TICKS_PER_SEC;
+#endif
+}
+
+/**
+ * @brief Microseconds elapsed between two timestamps
+ *
+ * @param start Earlier timestamp
+ * @param end Later timestamp
+ * @return Elapsed time in microseconds, saturated to UINT32_MAX
+ */
+static inline uint32_t time_utils_delta_us(uint64_t start, uint64_t end)
+{
+	uint64_t us;
+
+	if (end <= start) {
+		return 0;
+	}
+
+	us = time_utils_to_us(end - start);
+
+	return us > UINT32_MAX ? UINT32_MAX : (uint32_t)us;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TIME_UTILS_H_ */
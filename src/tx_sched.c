@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/random/random.h>
+#include <math.h>
+#include <string.h>
+
+#include "tx_sched.h"
+#include "time_utils.h"
+
+void tx_sched_init(struct tx_sched *sched, enum tx_sched_pattern pattern,
+		   uint64_t period_ns, uint32_t burst)
+{
+	memset(sched, 0, sizeof(*sched));
+	sched->pattern = pattern;
+	sched->period_ns = period_ns;
+	sched->burst = MAX(burst, 1);
+	sched->burst_left = sched->burst;
+	sched->next_ns = time_utils_to_ns(time_utils_now());
+}
+
+static uint64_t tx_sched_gap_ns(struct tx_sched *sched)
+{
+	float u;
+
+	switch (sched->pattern) {
+	case TX_SCHED_POISSON:
+		/* Inverse transform sampling, u uniform in [0, 1) */
+		u = (float)(sys_rand32_get() >> 8) / (float)BIT(24);
+		return (uint64_t)(-logf(1.0f - u) * (float)sched->period_ns);
+	case TX_SCHED_BURST:
+		if (--sched->burst_left > 0) {
+			return 0;
+		}
+		sched->burst_left = sched->burst;
+		return sched->period_ns * sched->burst;
+	case TX_SCHED_PERIODIC:
+	default:
+		return sched->period_ns;
+	}
+}
+
+uint64_t tx_sched_deadline(const struct tx_sched *sched)
+{
+	return time_utils_from_ns(sched->next_ns);
+}
+
+void tx_sched_advance(struct tx_sched *sched)
+{
+	uint64_t now_ns;
+	uint64_t skip;
+
+	if (sched->period_ns == 0) {
+		return;
+	}
+
+	sched->next_ns += tx_sched_gap_ns(sched);
+
+	now_ns = time_utils_to_ns(time_utils_now());
+	if (now_ns <= sched->next_ns + sched->period_ns) {
+		return;
+	}
+
+	/* Stay on the original grid, minus the slots that could not be met */
+	skip = (now_ns - sched->next_ns) / sched->period_ns;
+	sched->next_ns += skip * sched->period_ns;
+	sched->missed += (uint32_t)skip;
+	sched->burst_left = sched->burst;
+}
+
+void tx_sched_wait(const struct tx_sched *sched)
+{
+	uint64_t deadline = tx_sched_deadline(sched);
+
+	if (deadline > time_utils_now()) {
+		k_sleep(time_utils_timeout_abs(deadline));
+	}
+}
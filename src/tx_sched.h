@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef TX_SCHED_H_
+#define TX_SCHED_H_
+
+#include <zephyr/kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Absolute-deadline transmit scheduler
+ *
+ * Deadlines are advanced from the previous deadline rather than from the
+ * time a packet was actually sent, so send latency, reply latency and
+ * sleep overshoot never accumulate into the offered rate. Deadlines are
+ * kept in nanoseconds so that periods which are not a whole number of
+ * timer units do not drift either.
+ */
+
+/** Send patterns */
+enum tx_sched_pattern {
+	/** Constant gap of one period */
+	TX_SCHED_PERIODIC = 0,
+	/** Exponentially distributed gaps with a mean of one period */
+	TX_SCHED_POISSON,
+	/** Back-to-back bursts, spaced so the mean gap is one period */
+	TX_SCHED_BURST,
+};
+
+/** Scheduler state */
+struct tx_sched {
+	enum tx_sched_pattern pattern;
+	/** Mean gap between packets in ns (0 = unpaced) */
+	uint64_t period_ns;
+	/** Packets per burst (TX_SCHED_BURST) */
+	uint32_t burst;
+	/** Packets left in the current burst */
+	uint32_t burst_left;
+	/** Next deadline in ns, time_utils time base */
+	uint64_t next_ns;
+	/** Deadlines dropped because the sender fell behind */
+	uint32_t missed;
+};
+
+/**
+ * @brief Initialize a scheduler; the first deadline is now
+ *
+ * @param sched Scheduler
+ * @param pattern Send pattern
+ * @param period_ns Mean gap between packets in nanoseconds (0 = unpaced)
+ * @param burst Packets per burst, only used with TX_SCHED_BURST
+ */
+void tx_sched_init(struct tx_sched *sched, enum tx_sched_pattern pattern,
+		   uint64_t period_ns, uint32_t burst);
+
+/**
+ * @brief Get the current deadline
+ *
+ * @param sched Scheduler
+ * @return Deadline in time_utils_now() units
+ */
+uint64_t tx_sched_deadline(const struct tx_sched *sched);
+
+/**
+ * @brief Advance to the next deadline after a packet was sent
+ *
+ * A sender that is late catches up by at most one period; older deadlines
+ * are dropped and counted in @ref tx_sched.missed so a stall does not turn
+ * into a burst.
+ *
+ * @param sched Scheduler
+ */
+void tx_sched_advance(struct tx_sched *sched);
+
+/**
+ * @brief Sleep until the current deadline
+ *
+ * Uses an absolute kernel timeout, so the wakeup resolution is one system
+ * tick. Returns immediately if the deadline has passed.
+ *
+ * @param sched Scheduler
+ */
+void tx_sched_wait(const struct tx_sched *sched);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TX_SCHED_H_ */
@@ -0,0 +1,854 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/net/socket.h>
+#include <zephyr/random/random.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/util.h>
+#include <errno.h>
+#include <string.h>
+
+#include "udp_reliable.h"
+#include "mem_stats.h"
+#include "seqlock.h"
+#include "time_utils.h"
+
+LOG_MODULE_REGISTER(udp_reliable, CONFIG_LOG_DEFAULT_LEVEL);
+
+/* Frame layouts after the echo_proto header, little-endian:
+ *
+ * DATA: session(4) base(4) payload
+ *       seq is the message, base the oldest message still retransmitted
+ * ACK:  session(4) sack(4)
+ *       seq is the next message expected in order, tx_time is echoed
+ *       from the frame being acknowledged; sack bit i stands for message
+ *       seq + 1 + i
+ * FEC:  session(4) count(1) reserved(1) len_xor(2) parity
+ *       seq is the first message of the block
+ */
+#define REL_SESSION_OFF ECHO_PROTO_HDR_LEN
+#define REL_DATA_BASE_OFF (REL_SESSION_OFF + 4)
+#define REL_DATA_HDR_LEN (REL_DATA_BASE_OFF + 4)
+#define REL_ACK_SACK_OFF (REL_SESSION_OFF + 4)
+#define REL_ACK_LEN (REL_ACK_SACK_OFF + 4)
+#define REL_FEC_COUNT_OFF (REL_SESSION_OFF + 4)
+#define REL_FEC_LEN_OFF (REL_FEC_COUNT_OFF + 2)
+#define REL_FEC_HDR_LEN (REL_FEC_LEN_OFF + 2)
+
+#define REL_SACK_BITS 32
+#define REL_WINDOW CONFIG_UDP_RELIABLE_WINDOW
+#define REL_MAX_PAYLOAD CONFIG_UDP_RELIABLE_MAX_PAYLOAD
+#define REL_FRAME_MAX (MAX(REL_DATA_HDR_LEN, REL_FEC_HDR_LEN) + REL_MAX_PAYLOAD)
+#define REL_FLAGS ECHO_PROTO_FLAG_FULL_CRC
+
+#if defined(CONFIG_UDP_RELIABLE_FEC)
+#define REL_FEC_BLOCK CONFIG_UDP_RELIABLE_FEC_BLOCK
+#else
+#define REL_FEC_BLOCK 0
+#endif
+
+/* Sender wakeup without timers pending, to check the stop flag */
+#define REL_IDLE_POLL_US (100 * USEC_PER_MSEC)
+
+/* Retransmission timeout doublings before it stays at the maximum */
+#define REL_BACKOFF_MAX 6
+
+#define US_MS(us) (uint32_t)((us) / 1000), (uint32_t)((us) % 1000)
+
+BUILD_ASSERT(REL_FRAME_MAX <= CONFIG_UDP_ECHO_MAX_PACKET_SIZE,
+	     "Reliable frames must fit the echo server buffers");
+BUILD_ASSERT(REL_FEC_BLOCK <= REL_WINDOW,
+	     "A parity block must fit the receiver window");
+
+enum rel_role {
+	REL_ROLE_NONE,
+	REL_ROLE_SENDER,
+	REL_ROLE_RECEIVER,
+};
+
+enum rel_tx_state {
+	REL_TX_FREE,
+	REL_TX_PENDING,
+	REL_TX_ACKED,
+	REL_TX_EXPIRED,
+};
+
+/* Message in the send window, indexed by seq % REL_WINDOW */
+struct rel_tx_slot {
+	uint32_t seq;
+	uint16_t len;
+	uint8_t state;
+	uint8_t retries;
+	/* The early retransmission was used */
+	bool early_sent;
+	/* time_utils_now() when queued and when last sent */
+	uint64_t queued;
+	uint64_t last_tx;
+	/* Complete DATA frame; the header is rewritten for each send */
+	uint8_t frame[REL_DATA_HDR_LEN + REL_MAX_PAYLOAD];
+};
+
+/* Received message, kept after delivery for parity recovery */
+struct rel_rx_slot {
+	uint32_t seq;
+	uint16_t len;
+	bool valid;
+	uint8_t data[REL_MAX_PAYLOAD];
+};
+
+struct rel_tx {
+	struct rel_tx_slot slots[REL_WINDOW];
+	uint32_t session;
+	/* Oldest message neither acknowledged nor given up */
+	uint32_t base;
+	uint32_t next_seq;
+	/* One past the highest message acknowledged */
+	uint32_t acked_high;
+	bool rtt_valid;
+	/* Parity block being built, as a complete FEC frame */
+	uint32_t block_first;
+	uint8_t block_count;
+	uint16_t parity_len;
+	uint16_t len_xor;
+	uint8_t fec_frame[REL_FEC_HDR_LEN + REL_MAX_PAYLOAD];
+};
+
+struct rel_rx {
+	struct rel_rx_slot slots[REL_WINDOW];
+	struct sockaddr_in peer;
+	uint32_t session;
+	/* Next message to deliver */
+	uint32_t next;
+};
+
+/* A device is either the sender or the receiver, so they share memory */
+static union {
+	struct rel_tx tx;
+	struct rel_rx rx;
+} rel;
+
+static enum rel_role rel_role;
+static atomic_t sender_active;
+
+/* Single writer: the sender or the server thread */
+static atomic_t stats_seq;
+static struct udp_rel_stats rel_stats;
+
+static void rel_stats_reset(void)
+{
+	seqlock_write_begin(&stats_seq);
+	memset(&rel_stats, 0, sizeof(rel_stats));
+	rel_stats.rto_us = CONFIG_UDP_RELIABLE_RTO_INITIAL_MS * USEC_PER_MSEC;
+	seqlock_write_end(&stats_seq);
+}
+
+static int rel_sendto(int socket, const struct sockaddr_in *addr,
+		      const void *buf, size_t len)
+{
+	int ret;
+
+	ret = zsock_sendto(socket, buf, len, 0, (const struct sockaddr *)addr,
+			   sizeof(*addr));
+	if (ret < 0) {
+		/* Lost sends are recovered like lost frames */
+		if (errno == ENOMEM || errno == ENOBUFS || errno == EAGAIN) {
+			mem_stats_alloc_failed();
+		}
+		return -errno;
+	}
+
+	return 0;
+}
+
+/* Payload of message @p seq, checked by the receiver */
+static void rel_fill_payload(uint8_t *data, size_t len, uint32_t seq)
+{
+	for (size_t i = 0; i < len; i++) {
+		data[i] = (uint8_t)(seq + i);
+	}
+}
+
+static bool rel_check_payload(const uint8_t *data, size_t len, uint32_t seq)
+{
+	for (size_t i = 0; i < len; i++) {
+		if (data[i] != (uint8_t)(seq + i)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/* RFC 6298 estimator, with the poll resolution as clock granularity */
+static void rel_rtt_sample(uint32_t rtt_us)
+{
+	struct rel_tx *tx = &rel.tx;
+	uint32_t srtt = rel_stats.srtt_us;
+	uint32_t rttvar = rel_stats.rttvar_us;
+	uint32_t err;
+
+	if (!tx->rtt_valid) {
+		srtt = rtt_us;
+		rttvar = rtt_us / 2;
+		tx->rtt_valid = true;
+	} else {
+		err = rtt_us > srtt ? rtt_us - srtt : srtt - rtt_us;
+		rttvar = (3 * rttvar + err) / 4;
+		srtt = (7 * srtt + rtt_us) / 8;
+	}
+
+	rel_stats.srtt_us = srtt;
+	rel_stats.rttvar_us = rttvar;
+	rel_stats.rto_us = CLAMP(srtt + MAX(4 * rttvar, USEC_PER_MSEC),
+				 CONFIG_UDP_RELIABLE_RTO_MIN_MS * USEC_PER_MSEC,
+				 CONFIG_UDP_RELIABLE_RTO_MAX_MS * USEC_PER_MSEC);
+}
+
+/* Retransmission timeout of a message, doubled for each retry */
+static uint32_t rel_slot_timeout_us(const struct rel_tx_slot *slot)
+{
+	uint64_t rto = (uint64_t)rel_stats.rto_us << MIN(slot->retries, REL_BACKOFF_MAX);
+
+	return MIN(rto, CONFIG_UDP_RELIABLE_RTO_MAX_MS * USEC_PER_MSEC);
+}
+
+static void rel_transmit(int socket, const struct sockaddr_in *addr,
+			 struct rel_tx_slot *slot, bool retransmit, bool early)
+{
+	size_t len = REL_DATA_HDR_LEN + slot->len;
+	int ret;
+
+	/* A failed send is retried when its timeout expires */
+	slot->last_tx = time_utils_now();
+	sys_put_le32(rel.tx.session, slot->frame + REL_SESSION_OFF);
+	sys_put_le32(rel.tx.base, slot->frame + REL_DATA_BASE_OFF);
+	echo_proto_write(slot->frame, len, ECHO_PROTO_TYPE_REL_DATA, REL_FLAGS,
+			 slot->seq, slot->last_tx);
+
+	ret = rel_sendto(socket, addr, slot->frame, len);
+	if (ret < 0) {
+		LOG_DBG("Message %u send failed: %d", slot->seq, ret);
+	}
+
+	seqlock_write_begin(&stats_seq);
+	rel_stats.transmissions++;
+	if (retransmit) {
+		rel_stats.retransmits++;
+	}
+	if (early) {
+		rel_stats.fast_retransmits++;
+	}
+	seqlock_write_end(&stats_seq);
+}
+
+static void rel_fec_flush(int socket, const struct sockaddr_in *addr)
+{
+	struct rel_tx *tx = &rel.tx;
+	size_t len = REL_FEC_HDR_LEN + tx->parity_len;
+	int ret;
+
+	if (tx->block_count == 0) {
+		return;
+	}
+
+	sys_put_le32(tx->session, tx->fec_frame + REL_SESSION_OFF);
+	tx->fec_frame[REL_FEC_COUNT_OFF] = tx->block_count;
+	tx->fec_frame[REL_FEC_COUNT_OFF + 1] = 0;
+	sys_put_le16(tx->len_xor, tx->fec_frame + REL_FEC_LEN_OFF);
+	echo_proto_write(tx->fec_frame, len, ECHO_PROTO_TYPE_REL_FEC, REL_FLAGS,
+			 tx->block_first, time_utils_now());
+
+	ret = rel_sendto(socket, addr, tx->fec_frame, len);
+	if (ret == 0) {
+		seqlock_write_begin(&stats_seq);
+		rel_stats.fec_sent++;
+		seqlock_write_end(&stats_seq);
+	}
+
+	memset(tx->fec_frame + REL_FEC_HDR_LEN, 0, tx->parity_len);
+	tx->block_count = 0;
+	tx->parity_len = 0;
+	tx->len_xor = 0;
+}
+
+static void rel_fec_add(const struct rel_tx_slot *slot)
+{
+	struct rel_tx *tx = &rel.tx;
+	uint8_t *parity = tx->fec_frame + REL_FEC_HDR_LEN;
+	const uint8_t *data = slot->frame + REL_DATA_HDR_LEN;
+
+	if (tx->block_count == 0) {
+		tx->block_first = slot->seq;
+	}
+
+	for (size_t i = 0; i < slot->len; i++) {
+		parity[i] ^= data[i];
+	}
+	tx->parity_len = MAX(tx->parity_len, slot->len);
+	tx->len_xor ^= slot->len;
+	tx->block_count++;
+}
+
+static void rel_queue(int socket, const struct sockaddr_in *addr, size_t len,
+		      struct udp_echo_stats *stats)
+{
+	struct rel_tx *tx = &rel.tx;
+	struct rel_tx_slot *slot = &tx->slots[tx->next_seq % REL_WINDOW];
+
+	slot->seq = tx->next_seq++;
+	slot->len = len;
+	slot->state = REL_TX_PENDING;
+	slot->retries = 0;
+	slot->early_sent = false;
+	slot->queued = time_utils_now();
+	rel_fill_payload(slot->frame + REL_DATA_HDR_LEN, len, slot->seq);
+
+	seqlock_write_begin(&stats_seq);
+	rel_stats.messages++;
+	seqlock_write_end(&stats_seq);
+
+	if (stats) {
+		seqlock_write_begin(&stats->seq);
+		stats->packets_sent++;
+		stats->bytes_sent += len;
+		seqlock_write_end(&stats->seq);
+	}
+
+	rel_transmit(socket, addr, slot, false, false);
+
+	if (REL_FEC_BLOCK > 0) {
+		rel_fec_add(slot);
+		if (tx->block_count == REL_FEC_BLOCK) {
+			rel_fec_flush(socket, addr);
+		}
+	}
+}
+
+/* Slide the window past acknowledged and given up messages */
+static void rel_tx_advance(void)
+{
+	struct rel_tx *tx = &rel.tx;
+
+	while (tx->base != tx->next_seq &&
+	       tx->slots[tx->base % REL_WINDOW].state != REL_TX_PENDING) {
+		tx->base++;
+	}
+}
+
+/**
+ * @brief Give up, retransmit or wait for each message in flight
+ *
+ * @return Time in microseconds until the next message is due
+ */
+static uint32_t rel_tx_service(int socket, const struct sockaddr_in *addr,
+			       struct udp_echo_stats *stats)
+{
+	struct rel_tx *tx = &rel.tx;
+	/* A later message got through after about one RTT: this one is lost */
+	uint32_t early_us = rel_stats.srtt_us + rel_stats.srtt_us / 4;
+	uint32_t wait_us = REL_IDLE_POLL_US;
+
+	for (uint32_t seq = tx->base; seq != tx->next_seq; seq++) {
+		struct rel_tx_slot *slot = &tx->slots[seq % REL_WINDOW];
+		uint64_t now = time_utils_now();
+		uint32_t age_us, since_us, timeout_us;
+		bool early;
+
+		if (slot->state != REL_TX_PENDING) {
+			continue;
+		}
+
+		age_us = time_utils_delta_us(slot->queued, now);
+		since_us = time_utils_delta_us(slot->last_tx, now);
+		timeout_us = rel_slot_timeout_us(slot);
+
+		if (age_us >= CONFIG_UDP_RELIABLE_DEADLINE_MS * USEC_PER_MSEC ||
+		    (slot->retries >= CONFIG_UDP_RELIABLE_MAX_RETRIES &&
+		     since_us >= timeout_us)) {
+			slot->state = REL_TX_EXPIRED;
+			seqlock_write_begin(&stats_seq);
+			rel_stats.expired++;
+			seqlock_write_end(&stats_seq);
+			if (stats) {
+				seqlock_write_begin(&stats->seq);
+				stats->packets_lost++;
+				seqlock_write_end(&stats->seq);
+			}
+			LOG_DBG("Message %u given up after %u retransmissions",
+				seq, slot->retries);
+			continue;
+		}
+
+		early = !slot->early_sent && tx->rtt_valid &&
+			slot->retries < CONFIG_UDP_RELIABLE_MAX_RETRIES &&
+			seq + 1 < tx->acked_high;
+
+		if (since_us >= timeout_us ||
+		    (early && since_us >= early_us)) {
+			/* The timeout wins if both are due, so it backs off */
+			early = since_us < timeout_us;
+			slot->early_sent |= early;
+			slot->retries++;
+			rel_transmit(socket, addr, slot, true, early);
+			since_us = 0;
+			timeout_us = rel_slot_timeout_us(slot);
+			early = false;
+		}
+
+		wait_us = MIN(wait_us, timeout_us - since_us);
+		if (early) {
+			wait_us = MIN(wait_us, early_us - since_us);
+		}
+		wait_us = MIN(wait_us, CONFIG_UDP_RELIABLE_DEADLINE_MS * USEC_PER_MSEC -
+				       age_us);
+	}
+
+	rel_tx_advance();
+
+	return wait_us;
+}
+
+static void rel_ack_message(struct rel_tx_slot *slot, uint64_t rx_time,
+			    struct udp_echo_stats *stats)
+{
+	struct rel_tx *tx = &rel.tx;
+	uint32_t latency_us;
+
+	if (slot->state != REL_TX_PENDING) {
+		if (slot->state == REL_TX_EXPIRED && stats) {
+			/* Arrived after the sender gave up */
+			seqlock_write_begin(&stats->seq);
+			stats->packets_late++;
+			seqlock_write_end(&stats->seq);
+			slot->state = REL_TX_ACKED;
+		}
+		return;
+	}
+
+	slot->state = REL_TX_ACKED;
+	tx->acked_high = MAX(tx->acked_high, slot->seq + 1);
+	latency_us = time_utils_delta_us(slot->queued, rx_time);
+
+	seqlock_write_begin(&stats_seq);
+	if (rel_stats.acked == 0 || latency_us < rel_stats.latency_min_us) {
+		rel_stats.latency_min_us = latency_us;
+	}
+	rel_stats.latency_max_us = MAX(rel_stats.latency_max_us, latency_us);
+	rel_stats.latency_total_us += latency_us;
+	rel_stats.acked++;
+	seqlock_write_end(&stats_seq);
+
+	if (stats) {
+		seqlock_write_begin(&stats->seq);
+		stats->packets_received++;
+		stats->bytes_received += slot->len;
+		udp_echo_stats_add_rtt(stats, latency_us);
+		seqlock_write_end(&stats->seq);
+	}
+}
+
+static void rel_handle_ack(const uint8_t *buf, int len, uint64_t rx_time,
+			   struct udp_echo_stats *stats)
+{
+	struct rel_tx *tx = &rel.tx;
+	struct echo_proto_hdr hdr;
+	uint32_t cum, sack;
+
+	if (echo_proto_parse(buf, len, &hdr) < 0 ||
+	    hdr.type != ECHO_PROTO_TYPE_REL_ACK || len < REL_ACK_LEN ||
+	    sys_get_le32(buf + REL_SESSION_OFF) != tx->session) {
+		return;
+	}
+
+	cum = hdr.seq;
+	sack = sys_get_le32(buf + REL_ACK_SACK_OFF);
+	if (cum > tx->next_seq) {
+		return;
+	}
+
+	/* The echoed send time identifies the transmission, so
+	 * retransmissions give valid samples too
+	 */
+	seqlock_write_begin(&stats_seq);
+	rel_rtt_sample(time_utils_delta_us(hdr.tx_time, rx_time));
+	seqlock_write_end(&stats_seq);
+
+	for (uint32_t seq = tx->base; seq != tx->next_seq; seq++) {
+		if (seq < cum ||
+		    (seq > cum && seq - cum - 1 < REL_SACK_BITS &&
+		     (sack & BIT(seq - cum - 1)))) {
+			rel_ack_message(&tx->slots[seq % REL_WINDOW], rx_time, stats);
+		}
+	}
+
+	rel_tx_advance();
+}
+
+static uint64_t rel_period_ns(const struct udp_echo_client_params *params)
+{
+	if (params->rate_pps > 0) {
+		return NSEC_PER_SEC / params->rate_pps;
+	}
+
+	return (uint64_t)params->interval_ms * NSEC_PER_MSEC;
+}
+
+int udp_rel_client_run(int socket, struct sockaddr_in *server_addr,
+		       const struct udp_echo_client_params *params,
+		       struct udp_echo_stats *stats,
+		       struct udp_echo_stop *stop)
+{
+	static uint8_t rx_buf[REL_FRAME_MAX];
+	struct zsock_pollfd pfds[] = {
+		{ .fd = socket, .events = ZSOCK_POLLIN },
+		{ .fd = stop->efd, .events = ZSOCK_POLLIN },
+	};
+	size_t msg_len = CLAMP(params->packet_size, 1, REL_MAX_PAYLOAD);
+	struct rel_tx *tx = &rel.tx;
+	struct tx_sched sched;
+	int ret = 0;
+
+	if (!atomic_cas(&sender_active, 0, 1)) {
+		LOG_ERR("Another reliable sender is running");
+		return -EBUSY;
+	}
+
+	rel_role = REL_ROLE_SENDER;
+	memset(tx, 0, sizeof(*tx));
+	tx->session = sys_rand32_get();
+	rel_stats_reset();
+	tx_sched_init(&sched, params->pattern, rel_period_ns(params), params->burst);
+
+	LOG_INF("Reliable transport started");
+	LOG_INF("  Message size: %u bytes, window: %u, FEC block: %u",
+		(uint32_t)msg_len, REL_WINDOW, REL_FEC_BLOCK);
+	LOG_INF("  Deadline: %u ms, retries: %u", CONFIG_UDP_RELIABLE_DEADLINE_MS,
+		CONFIG_UDP_RELIABLE_MAX_RETRIES);
+
+	while (!stop->flag) {
+		bool more_to_send = params->count == 0 || tx->next_seq < params->count;
+		uint32_t wait_us = rel_tx_service(socket, server_addr, stats);
+		int timeout_ms = DIV_ROUND_UP(wait_us, USEC_PER_MSEC);
+		bool send_ready = false;
+
+		if (!more_to_send) {
+			/* Protect the tail of a partial block too */
+			rel_fec_flush(socket, server_addr);
+			if (tx->base == tx->next_seq) {
+				LOG_INF("Completed %u reliable messages", tx->next_seq);
+				break;
+			}
+		}
+
+		/* Queue on the scheduler's deadline if the window has room */
+		if (more_to_send && tx->next_seq - tx->base < REL_WINDOW) {
+			uint64_t now = time_utils_now();
+			uint64_t deadline = tx_sched_deadline(&sched);
+
+			if (now >= deadline) {
+				rel_queue(socket, server_addr, msg_len, stats);
+				tx_sched_advance(&sched);
+				continue;
+			}
+
+			/* Sub-millisecond remainders are slept by tx_sched_wait() */
+			timeout_ms = MIN(timeout_ms,
+					 (int)(time_utils_delta_us(now, deadline) /
+					       USEC_PER_MSEC));
+			send_ready = true;
+		}
+
+		ret = zsock_poll(pfds, ARRAY_SIZE(pfds), timeout_ms);
+		if (ret < 0) {
+			ret = -errno;
+			LOG_ERR("Reliable sender poll error: %d", ret);
+			break;
+		}
+		ret = 0;
+
+		if (!(pfds[0].revents & ZSOCK_POLLIN)) {
+			if (send_ready && timeout_ms == 0) {
+				tx_sched_wait(&sched);
+			}
+			continue;
+		}
+
+		/* Drain every queued ACK before servicing the window again */
+		while (true) {
+			uint64_t rx_time;
+			int len;
+
+			len = udp_receive_timestamped(socket, (char *)rx_buf,
+						      sizeof(rx_buf), NULL,
+						      ZSOCK_MSG_DONTWAIT, &rx_time);
+			if (len <= 0) {
+				break;
+			}
+
+			rel_handle_ack(rx_buf, len, rx_time, stats);
+		}
+	}
+
+	atomic_clear(&sender_active);
+
+	LOG_INF("Reliable transport stopped");
+	return ret;
+}
+
+static void rel_rx_reset(const struct sockaddr_in *peer, uint32_t session,
+			 uint32_t base)
+{
+	struct rel_rx *rx = &rel.rx;
+	char ip_str[INET_ADDRSTRLEN];
+
+	memset(rx, 0, sizeof(*rx));
+	rx->peer = *peer;
+	rx->session = session;
+	rx->next = base;
+	rel_role = REL_ROLE_RECEIVER;
+
+	memset(&rel_stats, 0, sizeof(rel_stats));
+
+	zsock_inet_ntop(AF_INET, &peer->sin_addr, ip_str, sizeof(ip_str));
+	LOG_INF("Reliable session %08x from %s:%u", session, ip_str,
+		ntohs(peer->sin_port));
+}
+
+static void rel_rx_deliver(const struct rel_rx_slot *slot)
+{
+	if (!rel_check_payload(slot->data, slot->len, slot->seq)) {
+		rel_stats.corrupt++;
+	}
+	rel_stats.delivered++;
+}
+
+/* Skip what the sender gave up on, then deliver what became in order */
+static void rel_rx_advance(uint32_t base)
+{
+	struct rel_rx *rx = &rel.rx;
+	struct rel_rx_slot *slot;
+
+	while (rx->next < base) {
+		slot = &rx->slots[rx->next % REL_WINDOW];
+		if (slot->valid && slot->seq == rx->next) {
+			rel_rx_deliver(slot);
+		} else {
+			rel_stats.skipped++;
+		}
+		rx->next++;
+	}
+
+	while (true) {
+		slot = &rx->slots[rx->next % REL_WINDOW];
+		if (!slot->valid || slot->seq != rx->next) {
+			break;
+		}
+		rel_rx_deliver(slot);
+		rx->next++;
+	}
+}
+
+static bool rel_rx_held(uint32_t seq)
+{
+	const struct rel_rx_slot *slot = &rel.rx.slots[seq % REL_WINDOW];
+
+	return slot->valid && slot->seq == seq;
+}
+
+static void rel_rx_store(uint32_t seq, const uint8_t *data, size_t len)
+{
+	struct rel_rx *rx = &rel.rx;
+	struct rel_rx_slot *slot = &rx->slots[seq % REL_WINDOW];
+
+	if (seq < rx->next || rel_rx_held(seq)) {
+		rel_stats.duplicates++;
+		return;
+	}
+
+	if (seq - rx->next >= REL_WINDOW) {
+		/* The sender never gets this far ahead */
+		return;
+	}
+
+	memcpy(slot->data, data, len);
+	slot->len = len;
+	slot->seq = seq;
+	slot->valid = true;
+}
+
+/* Rebuild the one message of the block that is missing */
+static void rel_rx_fec(uint32_t first, uint8_t count, uint16_t len_xor,
+		       const uint8_t *parity, size_t parity_len)
+{
+	struct rel_rx *rx = &rel.rx;
+	struct rel_rx_slot *slot;
+	uint32_t missing = 0;
+	uint32_t lost = 0;
+	uint16_t len = len_xor;
+
+	if (count == 0 || count > REL_WINDOW) {
+		return;
+	}
+
+	for (uint32_t seq = first; seq != first + count; seq++) {
+		if (rel_rx_held(seq)) {
+			len ^= rx->slots[seq % REL_WINDOW].len;
+		} else {
+			missing++;
+			lost = seq;
+		}
+	}
+
+	if (missing != 1 || lost < rx->next || lost - rx->next >= REL_WINDOW ||
+	    len > parity_len) {
+		return;
+	}
+
+	slot = &rx->slots[lost % REL_WINDOW];
+	memcpy(slot->data, parity, len);
+	for (uint32_t seq = first; seq != first + count; seq++) {
+		const struct rel_rx_slot *other = &rx->slots[seq % REL_WINDOW];
+
+		if (seq == lost) {
+			continue;
+		}
+		for (size_t i = 0; i < MIN(other->len, len); i++) {
+			slot->data[i] ^= other->data[i];
+		}
+	}
+	slot->len = len;
+	slot->seq = lost;
+	slot->valid = true;
+	rel_stats.fec_recovered++;
+}
+
+static void rel_rx_send_ack(int socket, uint64_t tx_time)
+{
+	struct rel_rx *rx = &rel.rx;
+	uint8_t ack[REL_ACK_LEN];
+	uint32_t sack = 0;
+
+	for (int i = 0; i < REL_SACK_BITS; i++) {
+		if (rel_rx_held(rx->next + 1 + i)) {
+			sack |= BIT(i);
+		}
+	}
+
+	sys_put_le32(rx->session, ack + REL_SESSION_OFF);
+	sys_put_le32(sack, ack + REL_ACK_SACK_OFF);
+	echo_proto_write(ack, sizeof(ack), ECHO_PROTO_TYPE_REL_ACK, REL_FLAGS,
+			 rx->next, tx_time);
+
+	(void)rel_sendto(socket, &rx->peer, ack, sizeof(ack));
+}
+
+void udp_rel_server_input(int socket, const struct echo_proto_hdr *hdr,
+			  const struct udp_batch_msg *msg)
+{
+	const uint8_t *buf = (const uint8_t *)msg->buf;
+	struct rel_rx *rx = &rel.rx;
+	uint32_t session, base;
+	bool same;
+
+	if (msg->len < REL_SESSION_OFF + 4) {
+		return;
+	}
+
+	session = sys_get_le32(buf + REL_SESSION_OFF);
+	same = rel_role == REL_ROLE_RECEIVER && session == rx->session &&
+	       msg->addr.sin_addr.s_addr == rx->peer.sin_addr.s_addr &&
+	       msg->addr.sin_port == rx->peer.sin_port;
+
+	seqlock_write_begin(&stats_seq);
+
+	if (hdr->type == ECHO_PROTO_TYPE_REL_DATA) {
+		if (msg->len < REL_DATA_HDR_LEN ||
+		    msg->len - REL_DATA_HDR_LEN > REL_MAX_PAYLOAD) {
+			seqlock_write_end(&stats_seq);
+			return;
+		}
+
+		base = sys_get_le32(buf + REL_DATA_BASE_OFF);
+		if (!same) {
+			rel_rx_reset(&msg->addr, session, base);
+		}
+
+		rel_stats.frames++;
+		rel_rx_advance(base);
+		rel_rx_store(hdr->seq, buf + REL_DATA_HDR_LEN,
+			     msg->len - REL_DATA_HDR_LEN);
+		rel_rx_advance(rx->next);
+	} else {
+		/* Parity of an unknown session cannot be used */
+		if (!same || msg->len < REL_FEC_HDR_LEN ||
+		    msg->len - REL_FEC_HDR_LEN > REL_MAX_PAYLOAD) {
+			seqlock_write_end(&stats_seq);
+			return;
+		}
+
+		rel_rx_fec(hdr->seq, buf[REL_FEC_COUNT_OFF],
+			   sys_get_le16(buf + REL_FEC_LEN_OFF),
+			   buf + REL_FEC_HDR_LEN, msg->len - REL_FEC_HDR_LEN);
+		rel_rx_advance(rx->next);
+	}
+
+	seqlock_write_end(&stats_seq);
+
+	rel_rx_send_ack(socket, hdr->tx_time);
+}
+
+void udp_rel_get_stats(struct udp_rel_stats *stats)
+{
+	atomic_val_t seq;
+
+	do {
+		seq = seqlock_read_begin(&stats_seq);
+		memcpy(stats, &rel_stats, sizeof(*stats));
+	} while (seqlock_read_retry(&stats_seq, seq));
+}
+
+void udp_rel_print_stats(void)
+{
+	struct udp_rel_stats s;
+	uint32_t rate;
+
+	udp_rel_get_stats(&s);
+
+	if (s.messages == 0 && s.frames == 0) {
+		return;
+	}
+
+	LOG_INF("=== Reliable Transport ===");
+
+	if (s.messages > 0) {
+		/* In hundredths of a percent */
+		rate = s.transmissions ?
+		       (uint32_t)((uint64_t)s.retransmits * 10000 / s.transmissions) : 0;
+
+		LOG_INF("Messages:     %u queued, %u acked, %u given up",
+			s.messages, s.acked, s.expired);
+		LOG_INF("Frames:       %u sent, %u retransmitted (%u.%02u%%, %u early), "
+			"%u parity", s.transmissions, s.retransmits, rate / 100,
+			rate % 100, s.fast_retransmits, s.fec_sent);
+		LOG_INF("RTT:          srtt %u.%03u ms, rttvar %u.%03u ms, RTO %u.%03u ms",
+			US_MS(s.srtt_us), US_MS(s.rttvar_us), US_MS(s.rto_us));
+		if (s.acked > 0) {
+			LOG_INF("Eff. latency: min %u.%03u avg %u.%03u max %u.%03u ms",
+				US_MS(s.latency_min_us),
+				US_MS(s.latency_total_us / s.acked),
+				US_MS(s.latency_max_us));
+		}
+	}
+
+	if (s.frames > 0) {
+		LOG_INF("Received:     %u frames, %u delivered in order, %u duplicates",
+			s.frames, s.delivered, s.duplicates);
+		LOG_INF("Recovered:    %u from parity, %u skipped, %u corrupt",
+			s.fec_recovered, s.skipped, s.corrupt);
+	}
+}
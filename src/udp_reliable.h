@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef UDP_RELIABLE_H_
+#define UDP_RELIABLE_H_
+
+#include <zephyr/kernel.h>
+
+#include "udp_utils.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Reliable, ordered datagram transport over UDP
+ *
+ * Messages are numbered and kept in a send window of
+ * CONFIG_UDP_RELIABLE_WINDOW slots until acknowledged. The receiver
+ * acknowledges every frame with its cumulative sequence and a 32-frame
+ * selective ACK bitmap, and delivers messages in order. The sender
+ * retransmits on an RTT-adaptive timeout (RFC 6298) and early, after
+ * about one RTT, when a later message was acknowledged. A message that
+ * is still unacknowledged after CONFIG_UDP_RELIABLE_DEADLINE_MS or
+ * CONFIG_UDP_RELIABLE_MAX_RETRIES retransmissions is given up, and the
+ * receiver skips it, so a lost message delays the ones behind it by a
+ * bounded time only. With CONFIG_UDP_RELIABLE_FEC an XOR parity frame
+ * follows every CONFIG_UDP_RELIABLE_FEC_BLOCK messages, from which the
+ * receiver rebuilds a single lost message without waiting for the
+ * retransmission.
+ *
+ * A device runs either the sender (P2P Client) or the receiver (the
+ * Group Owner's echo server), one connection at a time.
+ */
+
+/** Reliable transport statistics */
+struct udp_rel_stats {
+	/** Messages queued by the sender */
+	uint32_t messages;
+	/** Data frames sent, including retransmissions */
+	uint32_t transmissions;
+	/** Retransmitted data frames */
+	uint32_t retransmits;
+	/** Retransmissions triggered by a selective ACK, before the timeout */
+	uint32_t fast_retransmits;
+	/** Messages acknowledged */
+	uint32_t acked;
+	/** Messages given up on (deadline or retry limit) */
+	uint32_t expired;
+	/** Parity frames sent */
+	uint32_t fec_sent;
+	/** Smoothed RTT in microseconds */
+	uint32_t srtt_us;
+	/** RTT variation in microseconds */
+	uint32_t rttvar_us;
+	/** Current retransmission timeout in microseconds */
+	uint32_t rto_us;
+	/** Minimum time from queueing a message to its ACK */
+	uint32_t latency_min_us;
+	/** Maximum time from queueing a message to its ACK */
+	uint32_t latency_max_us;
+	/** Total of the queue-to-ACK times, for averaging */
+	uint64_t latency_total_us;
+	/** Data frames received */
+	uint32_t frames;
+	/** Messages delivered in order */
+	uint32_t delivered;
+	/** Data frames received more than once */
+	uint32_t duplicates;
+	/** Messages skipped because the sender gave up on them */
+	uint32_t skipped;
+	/** Messages rebuilt from a parity frame */
+	uint32_t fec_recovered;
+	/** Delivered messages whose payload did not match */
+	uint32_t corrupt;
+};
+
+/**
+ * @brief Run the reliable transport sender
+ *
+ * Queues messages of @p params->packet_size payload bytes (at most
+ * CONFIG_UDP_RELIABLE_MAX_PAYLOAD) at the rate, pattern and count of the
+ * echo client, and returns once all of them were acknowledged or given
+ * up, or when stopped. @p stats is kept up to date like an echo run:
+ * acknowledged messages count as received with their queue-to-ACK time
+ * as RTT, given up messages as lost.
+ *
+ * Only one sender runs at a time.
+ *
+ * @param socket Client socket descriptor
+ * @param server_addr Receiver address
+ * @param params Message size, rate, pattern and count
+ * @param stats Pointer to statistics structure (can be NULL)
+ * @param stop Stop signal
+ * @return 0 on success, -EBUSY if a sender is running, or negative error
+ *         code on failure
+ */
+int udp_rel_client_run(int socket, struct sockaddr_in *server_addr,
+		       const struct udp_echo_client_params *params,
+		       struct udp_echo_stats *stats,
+		       struct udp_echo_stop *stop);
+
+/**
+ * @brief Handle a reliable transport frame on the receiver
+ *
+ * Used by echo server implementations for datagrams whose header decoded
+ * as ECHO_PROTO_TYPE_REL_DATA or ECHO_PROTO_TYPE_REL_FEC. Delivers what
+ * became in order and sends the ACK. A frame from another sender or of a
+ * new session restarts the receiver.
+ *
+ * @param socket Server socket descriptor, for the ACK
+ * @param hdr Decoded datagram header
+ * @param msg Received datagram and its source address
+ */
+void udp_rel_server_input(int socket, const struct echo_proto_hdr *hdr,
+			  const struct udp_batch_msg *msg);
+
+/**
+ * @brief Get a copy of the reliable transport statistics
+ *
+ * @param stats Output statistics
+ */
+void udp_rel_get_stats(struct udp_rel_stats *stats);
+
+/**
+ * @brief Log the reliable transport statistics
+ *
+ * Includes the retransmit rate and the effective latency, the time from
+ * queueing a message to its acknowledgement including retransmissions.
+ */
+void udp_rel_print_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UDP_RELIABLE_H_ */
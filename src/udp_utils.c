@@ -8,15 +8,103 @@
 #include <zephyr/logging/log.h>
 #include <zephyr/net/socket.h>
 #include <zephyr/posix/arpa/inet.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/zvfs/eventfd.h>
+#include <stdlib.h>
 #include <string.h>
 
+#if defined(CONFIG_UDP_ECHO_SOCKET_TIMESTAMP)
+#include <zephyr/net/ptp_time.h>
+#endif
+
 #include "udp_utils.h"
+#include "time_utils.h"
+#include "seqlock.h"
+#include "echo_trace.h"
+#include "tx_sched.h"
+#include "peer_table.h"
+#include "mem_stats.h"
+#include "bringup_prof.h"
+#include "udp_reliable.h"
 
 LOG_MODULE_REGISTER(udp_utils, CONFIG_LOG_DEFAULT_LEVEL);
 
 /* Timeout for receive operations (ms) */
 #define UDP_RECV_TIMEOUT_MS 2000
 
+/* Per-packet log output, compiled out in quiet mode. UDP_PKT_DBG also
+ * gates work done only to feed debug messages.
+ */
+#if defined(CONFIG_UDP_ECHO_QUIET)
+#define UDP_PKT_LOG_ERR(...) do { } while (0)
+#define UDP_PKT_LOG_INF(...) do { } while (0)
+#define UDP_PKT_LOG_WRN(...) do { } while (0)
+#define UDP_PKT_LOG_DBG(...) do { } while (0)
+#define UDP_PKT_DBG 0
+#else
+#define UDP_PKT_LOG_ERR(...) LOG_ERR(__VA_ARGS__)
+#define UDP_PKT_LOG_INF(...) LOG_INF(__VA_ARGS__)
+#define UDP_PKT_LOG_WRN(...) LOG_WRN(__VA_ARGS__)
+#define UDP_PKT_LOG_DBG(...) LOG_DBG(__VA_ARGS__)
+#define UDP_PKT_DBG (CONFIG_LOG_DEFAULT_LEVEL >= LOG_LEVEL_DBG)
+#endif
+
+/* Send attempts per datagram when network buffers run out */
+#define UDP_SEND_RETRIES 4
+
+/* Interval between server readiness probes (ms) */
+#define UDP_PROBE_INTERVAL_MS 50
+
+/* Number of end-of-stream markers sent (they may be lost too) */
+#define UDP_STREAM_END_MARKERS 3
+
+/* Largest datagram either side is expected to receive, plus room to
+ * detect over-long ones
+ */
+#define UDP_ECHO_BUF_SIZE \
+	ROUND_UP(MAX(CONFIG_UDP_ECHO_MAX_PACKET_SIZE, \
+		     CONFIG_UDP_THROUGHPUT_PACKET_SIZE) + 64, 4)
+
+/* The server holds a batch, the client a send and a receive buffer */
+#define UDP_ECHO_BUF_COUNT MAX(CONFIG_UDP_ECHO_BATCH_SIZE, 2)
+
+/* Largest UDP payload that fits one 1500-byte IPv4 frame */
+#define UDP_MTU_PAYLOAD 1472
+
+/* Datagram buffers, kept off the 4 KB thread stacks */
+K_MEM_SLAB_DEFINE_STATIC(udp_buf_slab, UDP_ECHO_BUF_SIZE, UDP_ECHO_BUF_COUNT, 4);
+
+/* The client loops keep their state in statics, so only one may run */
+static atomic_t client_active;
+
+/* Throughput stream receiver state (echo server side), one per transport.
+ * Each is written by a single thread: the UDP server thread or the RX
+ * thread with zero-copy, and the TCP server thread.
+ */
+struct udp_stream_rx {
+	/* Guards total against concurrent readers */
+	atomic_t seq;
+	bool active;
+	uint32_t next_seq;
+	uint64_t start_us;
+	int64_t prev_transit;
+	/* Jitter scaled by 16, as in RFC 3550 A.8 */
+	uint32_t jitter_q4;
+	/* Since stream start */
+	struct udp_stream_rx_stats total;
+	/* Since last interval report */
+	struct udp_stream_rx_stats interval;
+	uint64_t interval_start_us;
+};
+
+static struct udp_stream_rx stream_rx[UDP_STREAM_RX_SRC_COUNT];
+
+/* Log prefix, empty for UDP to keep the plain stream messages */
+static const char *const stream_rx_txt[] = {
+	[UDP_STREAM_RX_UDP] = "",
+	[UDP_STREAM_RX_TCP] = "TCP ",
+};
+
 int udp_client_init(int *socket, struct sockaddr_in *server_addr,
 		    const char *target_ip, uint16_t port)
 {
@@ -46,6 +134,18 @@ int udp_client_init(int *socket, struct sockaddr_in *server_addr,
 		}
 	}
 
+#if defined(CONFIG_UDP_ECHO_SOCKET_TIMESTAMP)
+	/* Ask the stack to attach RX timestamps to received datagrams */
+	int ts_flags = SOF_TIMESTAMPING_RX_HARDWARE;
+
+	ret = zsock_setsockopt(sock, SOL_SOCKET, SO_TIMESTAMPING,
+			       &ts_flags, sizeof(ts_flags));
+	if (ret < 0) {
+		LOG_WRN("Socket RX timestamps not available (errno=%d), "
+			"using application timestamps", errno);
+	}
+#endif
+
 	/* Configure server address */
 	server_addr->sin_family = AF_INET;
 	server_addr->sin_port = htons(port);
@@ -104,6 +204,9 @@ int udp_send(int socket, struct sockaddr_in *server_addr,
 			   (struct sockaddr *)server_addr,
 			   sizeof(*server_addr));
 	if (ret < 0) {
+		if (errno == ENOMEM || errno == ENOBUFS || errno == EAGAIN) {
+			mem_stats_alloc_failed();
+		}
 		LOG_ERR("Failed to send UDP data: %d", errno);
 		return -errno;
 	}
@@ -111,6 +214,16 @@ int udp_send(int socket, struct sockaddr_in *server_addr,
 	return ret;
 }
 
+/* Out of TX buffers: yield a tick so the stack can release some */
+static void udp_buffer_backoff(void)
+{
+	int64_t start = k_uptime_ticks();
+
+	mem_stats_alloc_failed();
+	k_sleep(K_TICKS(1));
+	mem_stats_buffer_wait(k_ticks_to_us_ceil32(k_uptime_ticks() - start));
+}
+
 int udp_receive(int socket, char *buffer, size_t buffer_size,
 		struct sockaddr_in *client_addr)
 {
@@ -135,16 +248,168 @@ int udp_receive(int socket, char *buffer, size_t buffer_size,
 	return ret;
 }
 
+int udp_receive_timestamped(int socket, char *buffer, size_t buffer_size,
+			    struct sockaddr_in *client_addr, int flags,
+			    uint64_t *rx_time)
+{
+#if defined(CONFIG_UDP_ECHO_SOCKET_TIMESTAMP)
+	uint8_t cmsg_buf[CMSG_SPACE(sizeof(struct net_ptp_time))];
+	struct iovec iov = {
+		.iov_base = buffer,
+		.iov_len = buffer_size,
+	};
+	struct msghdr msg = {
+		.msg_name = client_addr,
+		.msg_namelen = client_addr ? sizeof(*client_addr) : 0,
+		.msg_iov = &iov,
+		.msg_iovlen = 1,
+		.msg_control = cmsg_buf,
+		.msg_controllen = sizeof(cmsg_buf),
+	};
+	struct cmsghdr *cmsg;
+	int ret;
+
+	ret = zsock_recvmsg(socket, &msg, flags);
+	if (ret < 0) {
+		return -errno;
+	}
+
+	/* Fall back to an application timestamp if the stack gave none */
+	*rx_time = time_utils_now();
+
+	for (cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+		if (cmsg->cmsg_level == SOL_SOCKET &&
+		    cmsg->cmsg_type == SO_TIMESTAMPING) {
+			struct net_ptp_time ts;
+			uint64_t ns;
+
+			memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+			ns = ts.second * NSEC_PER_SEC + ts.nanosecond;
+			if (ns != 0) {
+				*rx_time = time_utils_from_ns(ns);
+			}
+			break;
+		}
+	}
+
+	return ret;
+#else
+	socklen_t addr_len = sizeof(struct sockaddr_in);
+	int ret;
+
+	ret = zsock_recvfrom(socket, buffer, buffer_size, flags,
+			     (struct sockaddr *)client_addr,
+			     client_addr ? &addr_len : NULL);
+	if (ret < 0) {
+		return -errno;
+	}
+
+	*rx_time = time_utils_now();
+
+	return ret;
+#endif
+}
+
+int udp_echo_stop_init(struct udp_echo_stop *stop)
+{
+	stop->flag = false;
+	stop->efd = zvfs_eventfd(0, ZVFS_EFD_NONBLOCK);
+	if (stop->efd < 0) {
+		LOG_WRN("No stop eventfd (%d), stopping on receive timeout", errno);
+		return -errno;
+	}
+
+	return 0;
+}
+
+void udp_echo_stop_reset(struct udp_echo_stop *stop)
+{
+	uint64_t val;
+
+	stop->flag = false;
+	if (stop->efd >= 0) {
+		/* Drain a wakeup left over from the previous stop */
+		(void)zvfs_eventfd_read(stop->efd, &val);
+	}
+}
+
+void udp_echo_stop_request(struct udp_echo_stop *stop)
+{
+	stop->flag = true;
+	if (stop->efd >= 0) {
+		(void)zvfs_eventfd_write(stop->efd, 1);
+	}
+}
+
+int udp_receive_batch(int socket, struct udp_batch_msg *msgs, size_t count)
+{
+	socklen_t addr_len;
+	size_t n = 0;
+	int ret;
+
+	while (n < count) {
+		addr_len = sizeof(msgs[n].addr);
+
+		ret = zsock_recvfrom(socket, msgs[n].buf, msgs[n].size,
+				     n == 0 ? 0 : ZSOCK_MSG_DONTWAIT,
+				     (struct sockaddr *)&msgs[n].addr,
+				     &addr_len);
+		if (ret < 0) {
+			if (n > 0) {
+				/* Queue drained */
+				break;
+			}
+			return (errno == EWOULDBLOCK) ? -EAGAIN : -errno;
+		}
+
+		msgs[n].len = ret;
+		n++;
+	}
+
+	return n;
+}
+
+int udp_send_batch(int socket, const struct udp_batch_msg *msgs, size_t count)
+{
+	size_t n;
+	int retries;
+	int ret = 0;
+
+	for (n = 0; n < count; n++) {
+		retries = UDP_SEND_RETRIES;
+
+		do {
+			ret = zsock_sendto(socket, msgs[n].buf, msgs[n].len, 0,
+					   (const struct sockaddr *)&msgs[n].addr,
+					   sizeof(msgs[n].addr));
+			if (ret >= 0) {
+				break;
+			}
+			ret = -errno;
+			if (ret != -ENOMEM && ret != -ENOBUFS && ret != -EAGAIN) {
+				break;
+			}
+			udp_buffer_backoff();
+		} while (--retries > 0);
+
+		if (ret < 0) {
+			break;
+		}
+	}
+
+	return (n == 0 && ret < 0) ? ret : (int)n;
+}
+
 int udp_echo_ping(int socket, struct sockaddr_in *server_addr,
 		  const char *data, size_t data_len,
 		  char *recv_buffer, size_t recv_buffer_size,
 		  uint32_t *rtt_us)
 {
-	int64_t start_time, end_time;
+	uint64_t start_time, end_time;
 	int ret;
 
 	/* Record start time */
-	start_time = k_uptime_get();
+	start_time = time_utils_now();
 
 	/* Send packet */
 	ret = udp_send(socket, server_addr, data, data_len);
@@ -153,228 +418,1538 @@ int udp_echo_ping(int socket, struct sockaddr_in *server_addr,
 	}
 
 	/* Receive echo response */
-	ret = udp_receive(socket, recv_buffer, recv_buffer_size, NULL);
+	ret = udp_receive_timestamped(socket, recv_buffer, recv_buffer_size,
+				      NULL, 0, &end_time);
 	if (ret <= 0) {
-		if (ret == 0) {
+		if (ret == 0 || ret == -EAGAIN || ret == -EWOULDBLOCK) {
 			/* Timeout */
 			return -ETIMEDOUT;
 		}
+		LOG_ERR("Failed to receive UDP data: %d", ret);
 		return ret;
 	}
 
 	/* Calculate RTT */
-	end_time = k_uptime_get();
 	if (rtt_us) {
-		*rtt_us = (uint32_t)((end_time - start_time) * 1000);
+		*rtt_us = time_utils_delta_us(start_time, end_time);
 	}
 
 	return ret;
 }
 
-int udp_echo_server_run(int socket, struct udp_echo_stats *stats,
-			volatile bool *stop_flag)
+static void udp_stream_print(enum udp_stream_rx_src src, const char *label,
+			     const struct udp_stream_rx_stats *st)
 {
-	char buffer[CONFIG_UDP_ECHO_PACKET_SIZE + 64];
-	struct sockaddr_in client_addr;
-	socklen_t client_addr_len;
-	int recv_len, send_len;
+	uint32_t expected = st->packets + st->lost;
+	uint32_t ms = (uint32_t)(st->elapsed_us / 1000);
+	uint32_t kbps = 0;
 
-	LOG_INF("UDP Echo Server started - waiting for packets...");
+	if (st->elapsed_us > 0) {
+		kbps = (uint32_t)((st->bytes * 8 * 1000) / st->elapsed_us);
+	}
+
+	LOG_INF("%s%s %u.%03u s: %llu bytes, %u kbit/s, lost %u/%u (%u%%), "
+		"out-of-order %u, jitter %u.%03u ms",
+		stream_rx_txt[src], label, ms / 1000, ms % 1000,
+		(unsigned long long)st->bytes, kbps,
+		st->lost, expected, expected ? (st->lost * 100) / expected : 0,
+		st->out_of_order, st->jitter_us / 1000, st->jitter_us % 1000);
+}
 
-	while (!(*stop_flag)) {
-		client_addr_len = sizeof(client_addr);
+static void udp_stream_rx_finish(enum udp_stream_rx_src src)
+{
+	struct udp_stream_rx *rx = &stream_rx[src];
 
-		/* Receive packet */
-		recv_len = zsock_recvfrom(socket, buffer, sizeof(buffer), 0,
-					  (struct sockaddr *)&client_addr,
-					  &client_addr_len);
+	seqlock_write_begin(&rx->seq);
+	rx->total.elapsed_us = time_utils_to_us(time_utils_now()) - rx->start_us;
+	rx->total.jitter_us = rx->jitter_q4 >> 4;
+	rx->active = false;
+	seqlock_write_end(&rx->seq);
 
-		if (recv_len < 0) {
-			if (errno == EAGAIN || errno == EWOULDBLOCK) {
-				/* Timeout - check stop flag and continue */
-				continue;
-			}
-			LOG_ERR("Echo server receive error: %d", errno);
-			continue;
+	udp_stream_print(src, "Stream total", &rx->total);
+}
+
+void udp_stream_rx_packet(enum udp_stream_rx_src src,
+			  const struct echo_proto_hdr *hdr, int len)
+{
+	struct udp_stream_rx *rx = &stream_rx[src];
+	uint64_t now_us, tx_us;
+	int64_t transit;
+	uint32_t delta;
+
+	if (hdr->flags & ECHO_PROTO_FLAG_END) {
+		if (rx->active) {
+			udp_stream_rx_finish(src);
 		}
+		return;
+	}
 
-		if (recv_len == 0) {
-			continue;
+	/* Both peers run the same time base, so the sender timestamp can be
+	 * converted locally.
+	 */
+	now_us = time_utils_to_us(time_utils_now());
+	tx_us = time_utils_to_us(hdr->tx_time);
+
+	seqlock_write_begin(&rx->seq);
+
+	/* Sequence 0 (re)starts a stream */
+	if (!rx->active || hdr->seq == 0) {
+		atomic_val_t seq = atomic_get(&rx->seq);
+
+		memset(rx, 0, sizeof(*rx));
+		atomic_set(&rx->seq, seq);
+		rx->active = true;
+		rx->start_us = now_us;
+		rx->interval_start_us = now_us;
+		rx->prev_transit = (int64_t)(now_us - tx_us);
+		LOG_INF("%sThroughput stream started", stream_rx_txt[src]);
+	}
+
+	if (hdr->seq >= rx->next_seq) {
+		uint32_t gap = hdr->seq - rx->next_seq;
+
+		rx->total.lost += gap;
+		rx->interval.lost += gap;
+		rx->next_seq = hdr->seq + 1;
+	} else {
+		/* Arrived after a later packet: it was counted lost */
+		rx->total.out_of_order++;
+		rx->interval.out_of_order++;
+		if (rx->total.lost > 0) {
+			rx->total.lost--;
 		}
+		if (rx->interval.lost > 0) {
+			rx->interval.lost--;
+		}
+	}
 
-		/* Update stats */
-		if (stats) {
-			stats->packets_received++;
-			stats->bytes_received += recv_len;
+	rx->total.packets++;
+	rx->total.bytes += len;
+	rx->interval.packets++;
+	rx->interval.bytes += len;
+
+	/* RFC 3550 interarrival jitter; the clock offset cancels out */
+	transit = (int64_t)(now_us - tx_us);
+	delta = (uint32_t)llabs(transit - rx->prev_transit);
+	rx->prev_transit = transit;
+	rx->jitter_q4 += delta - ((rx->jitter_q4 + 8) >> 4);
+	rx->total.jitter_us = rx->jitter_q4 >> 4;
+	rx->total.elapsed_us = now_us - rx->start_us;
+
+	seqlock_write_end(&rx->seq);
+
+	if (now_us - rx->interval_start_us >=
+	    CONFIG_UDP_THROUGHPUT_REPORT_INTERVAL_MS * 1000ULL) {
+		rx->interval.elapsed_us = now_us - rx->interval_start_us;
+		rx->interval.jitter_us = rx->jitter_q4 >> 4;
+		udp_stream_print(src, "Stream interval", &rx->interval);
+		memset(&rx->interval, 0, sizeof(rx->interval));
+		rx->interval_start_us = now_us;
+	}
+}
+
+void udp_stream_get_rx_stats(enum udp_stream_rx_src src,
+			     struct udp_stream_rx_stats *stats)
+{
+	const struct udp_stream_rx *rx = &stream_rx[src];
+	atomic_val_t seq;
+
+	do {
+		seq = seqlock_read_begin(&rx->seq);
+		*stats = rx->total;
+	} while (seqlock_read_retry(&rx->seq, seq));
+}
+
+int udp_echo_wait_server_ready(int socket, struct sockaddr_in *server_addr,
+			       uint32_t timeout_ms, struct udp_echo_stop *stop)
+{
+	struct zsock_pollfd pfds[] = {
+		{ .fd = socket, .events = ZSOCK_POLLIN },
+		{ .fd = stop ? stop->efd : -1, .events = ZSOCK_POLLIN },
+	};
+	char probe[ECHO_PROTO_PROBE_LEN];
+	char reply[ECHO_PROTO_HDR_LEN + 64];
+	struct sockaddr_in from;
+	socklen_t from_len;
+	struct echo_proto_hdr hdr;
+	int64_t start = k_uptime_get();
+	bool discover = server_addr->sin_addr.s_addr == htonl(INADDR_BROADCAST);
+	uint32_t seq = 0;
+	int ret;
+
+	if (discover) {
+		int one = 1;
+
+		/* Not every stack requires it, ignore failures */
+		(void)zsock_setsockopt(socket, SOL_SOCKET, SO_BROADCAST,
+				       &one, sizeof(one));
+	}
+
+	while (k_uptime_get() - start < timeout_ms) {
+		if (stop && stop->flag) {
+			return -ECANCELED;
 		}
 
-		/* Log received packet */
-		char ip_str[INET_ADDRSTRLEN];
-		zsock_inet_ntop(AF_INET, &client_addr.sin_addr,
-				ip_str, sizeof(ip_str));
-		LOG_DBG("Received %d bytes from %s:%d",
-			recv_len, ip_str, ntohs(client_addr.sin_port));
+		sys_put_le32(time_utils_hz(), (uint8_t *)&probe[ECHO_PROTO_HDR_LEN]);
+		echo_proto_write(probe, sizeof(probe), ECHO_PROTO_TYPE_PROBE, 0,
+				 seq++, time_utils_now());
 
-		/* Echo back the packet */
-		send_len = zsock_sendto(socket, buffer, recv_len, 0,
-					(struct sockaddr *)&client_addr,
-					client_addr_len);
+		ret = udp_send(socket, server_addr, probe, sizeof(probe));
+		if (ret < 0 && ret != -ENETUNREACH && ret != -EHOSTUNREACH) {
+			return ret;
+		}
 
-		if (send_len < 0) {
-			LOG_ERR("Echo server send error: %d", errno);
-			continue;
+		ret = zsock_poll(pfds, ARRAY_SIZE(pfds), UDP_PROBE_INTERVAL_MS);
+		if (ret < 0) {
+			return -errno;
 		}
 
-		/* Update stats */
-		if (stats) {
-			stats->packets_sent++;
-			stats->bytes_sent += send_len;
+		while (ret > 0 && (pfds[0].revents & ZSOCK_POLLIN)) {
+			from_len = sizeof(from);
+			ret = zsock_recvfrom(socket, reply, sizeof(reply),
+					     ZSOCK_MSG_DONTWAIT,
+					     (struct sockaddr *)&from, &from_len);
+			if (ret <= 0) {
+				break;
+			}
+
+			if (echo_proto_parse(reply, ret, &hdr) == 0 &&
+			    hdr.type == ECHO_PROTO_TYPE_PROBE) {
+				if (discover) {
+					char ip_str[NET_IPV4_ADDR_LEN];
+
+					server_addr->sin_addr = from.sin_addr;
+					zsock_inet_ntop(AF_INET, &from.sin_addr,
+							ip_str, sizeof(ip_str));
+					LOG_INF("Echo server found at %s", ip_str);
+				}
+				LOG_INF("Echo server ready after %lld ms",
+					k_uptime_get() - start);
+				return 0;
+			}
 		}
+	}
 
-		LOG_DBG("Echoed %d bytes back to %s:%d",
-			send_len, ip_str, ntohs(client_addr.sin_port));
+	return -ETIMEDOUT;
+}
+
+static int udp_buf_alloc(void **bufs, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		if (k_mem_slab_alloc(&udp_buf_slab, &bufs[i], K_NO_WAIT) != 0) {
+			LOG_ERR("Out of echo buffers (%u of %u in use)",
+				k_mem_slab_num_used_get(&udp_buf_slab),
+				UDP_ECHO_BUF_COUNT);
+			while (i-- > 0) {
+				k_mem_slab_free(&udp_buf_slab, bufs[i]);
+			}
+			return -ENOMEM;
+		}
 	}
 
-	LOG_INF("UDP Echo Server stopped");
 	return 0;
 }
 
-int udp_echo_client_run(int socket, struct sockaddr_in *server_addr,
-			size_t packet_size, uint32_t interval_ms,
-			uint32_t count, struct udp_echo_stats *stats,
-			volatile bool *stop_flag)
+static void udp_buf_free(void **bufs, size_t count)
 {
-	char send_buffer[CONFIG_UDP_ECHO_PACKET_SIZE + 64];
-	char recv_buffer[CONFIG_UDP_ECHO_PACKET_SIZE + 64];
-	uint32_t seq_num = 0;
-	uint32_t rtt_us;
+	for (size_t i = 0; i < count; i++) {
+		k_mem_slab_free(&udp_buf_slab, bufs[i]);
+	}
+}
+
+/* Serve one receive batch of a server socket, returns the packets received */
+static int udp_echo_server_batch(int socket, void **buffers,
+				 struct udp_echo_stats *stats)
+{
+	struct udp_batch_msg msgs[CONFIG_UDP_ECHO_BATCH_SIZE];
+	struct echo_proto_hdr hdr;
+	uint64_t rx_bytes, tx_bytes;
+	uint32_t corrupt, dropped;
+	int recv_cnt, echo_cnt, sent;
 	int ret;
+	int i;
 
-	/* Ensure packet size is within bounds */
-	if (packet_size > sizeof(send_buffer)) {
-		packet_size = sizeof(send_buffer);
+	for (i = 0; i < ARRAY_SIZE(msgs); i++) {
+		msgs[i].buf = buffers[i];
+		msgs[i].size = UDP_ECHO_BUF_SIZE;
 	}
 
-	LOG_INF("UDP Echo Client started");
-	LOG_INF("  Packet size: %d bytes", packet_size);
-	LOG_INF("  Interval: %d ms", interval_ms);
-	LOG_INF("  Count: %s", count == 0 ? "infinite" : "");
+	/* Receive a batch of packets */
+	recv_cnt = udp_receive_batch(socket, msgs, ARRAY_SIZE(msgs));
+	if (recv_cnt < 0) {
+		if (recv_cnt != -EAGAIN) {
+			LOG_ERR("Echo server receive error: %d", recv_cnt);
+		}
+		return 0;
+	}
 
-	while (!(*stop_flag)) {
-		/* Check count limit */
-		if (count > 0 && seq_num >= count) {
-			LOG_INF("Completed %d echo requests", count);
-			break;
+	/* Compact echo requests to the front of the batch; throughput
+	 * stream packets are accounted, not echoed. Corrupt and
+	 * foreign datagrams are still echoed, so the peer sees them.
+	 */
+	rx_bytes = 0;
+	corrupt = 0;
+	dropped = 0;
+	echo_cnt = 0;
+	for (i = 0; i < recv_cnt; i++) {
+		rx_bytes += msgs[i].len;
+
+		if (msgs[i].len == 0) {
+			continue;
 		}
 
-		/* Prepare packet with sequence number and timestamp */
-		memset(send_buffer, 'A' + (seq_num % 26), packet_size);
-		snprintf(send_buffer, packet_size, "SEQ=%08u,T=%lld",
-			 seq_num, k_uptime_get());
+		ret = echo_proto_parse(msgs[i].buf, msgs[i].len, &hdr);
+		if (ret == 0 && hdr.type == ECHO_PROTO_TYPE_STREAM) {
+			udp_stream_rx_packet(UDP_STREAM_RX_UDP, &hdr, msgs[i].len);
+			continue;
+		}
 
-		/* Send and receive echo */
-		ret = udp_echo_ping(socket, server_addr,
-				    send_buffer, packet_size,
-				    recv_buffer, sizeof(recv_buffer),
-				    &rtt_us);
+		/* Reliable transport frames are acknowledged, not echoed */
+		if (IS_ENABLED(CONFIG_UDP_RELIABLE) && ret == 0 &&
+		    (hdr.type == ECHO_PROTO_TYPE_REL_DATA ||
+		     hdr.type == ECHO_PROTO_TYPE_REL_FEC)) {
+			udp_rel_server_input(socket, &hdr, &msgs[i]);
+			continue;
+		}
 
-		if (ret > 0) {
-			/* Success */
-			if (stats) {
-				stats->packets_sent++;
-				stats->packets_received++;
-				stats->bytes_sent += packet_size;
-				stats->bytes_received += ret;
-
-				/* Update RTT statistics */
-				if (stats->packets_received == 1 ||
-				    rtt_us < stats->rtt_min_us) {
-					stats->rtt_min_us = rtt_us;
-				}
-				if (rtt_us > stats->rtt_max_us) {
-					stats->rtt_max_us = rtt_us;
-				}
-				stats->rtt_total_us += rtt_us;
-				stats->rtt_avg_us = (uint32_t)(stats->rtt_total_us /
-							       stats->packets_received);
-			}
+		/* Tell a host peer the time base of our stream timestamps */
+		if (ret == 0 && hdr.type == ECHO_PROTO_TYPE_PROBE &&
+		    msgs[i].len >= ECHO_PROTO_PROBE_LEN) {
+			sys_put_le32(time_utils_hz(),
+				     (uint8_t *)msgs[i].buf + ECHO_PROTO_HDR_LEN);
+		}
 
-			LOG_INF("Echo reply: seq=%u, bytes=%d, RTT=%u.%03u ms",
-				seq_num, ret, rtt_us / 1000, rtt_us % 1000);
-		} else if (ret == -ETIMEDOUT) {
-			/* Timeout */
-			if (stats) {
-				stats->packets_sent++;
-				stats->packets_lost++;
-				stats->bytes_sent += packet_size;
-			}
-			LOG_WRN("Echo timeout: seq=%u", seq_num);
-		} else {
-			/* Error */
-			LOG_ERR("Echo error: seq=%u, ret=%d", seq_num, ret);
+		if (ret == -EBADMSG) {
+			corrupt++;
+			echo_trace_record(ECHO_TRACE_CORRUPT, 0,
+					  msgs[i].len);
+		}
+
+		echo_trace_record(ECHO_TRACE_RX, 0, msgs[i].len);
+
+		/* Table full or peer over its rate: not echoed */
+		if (peer_table_rx(&msgs[i].addr.sin_addr, NULL,
+				  msgs[i].len, ret == -EBADMSG) < 0) {
+			dropped++;
+			continue;
+		}
+
+		if (UDP_PKT_DBG) {
+			char ip_str[INET_ADDRSTRLEN];
+
+			zsock_inet_ntop(AF_INET, &msgs[i].addr.sin_addr,
+					ip_str, sizeof(ip_str));
+			UDP_PKT_LOG_DBG("Received %d bytes from %s:%d",
+					(int)msgs[i].len, ip_str,
+					ntohs(msgs[i].addr.sin_port));
 		}
 
-		seq_num++;
+		msgs[echo_cnt++] = msgs[i];
+	}
 
-		/* Wait for next interval */
-		k_msleep(interval_ms);
+	/* Echo back the batch */
+	sent = 0;
+	tx_bytes = 0;
+	if (echo_cnt > 0) {
+		sent = udp_send_batch(socket, msgs, echo_cnt);
+		if (sent < echo_cnt) {
+			echo_trace_record(ECHO_TRACE_ERROR, 0,
+					  sent < 0 ? sent : -EIO);
+			UDP_PKT_LOG_ERR("Echo server send error: %d",
+					sent < 0 ? sent : -EIO);
+		}
+		for (i = 0; i < sent; i++) {
+			tx_bytes += msgs[i].len;
+			peer_table_tx(&msgs[i].addr.sin_addr,
+				      msgs[i].len);
+		}
+		if (sent > 0) {
+			bringup_prof_mark(BRINGUP_PROF_ECHO_REPLY);
+		}
 	}
 
-	LOG_INF("UDP Echo Client stopped");
-	return 0;
+	/* Update stats once per batch */
+	if (stats) {
+		seqlock_write_begin(&stats->seq);
+		stats->packets_received += recv_cnt;
+		stats->bytes_received += rx_bytes;
+		stats->packets_corrupt += corrupt;
+		stats->packets_dropped += dropped;
+		if (sent > 0) {
+			stats->packets_sent += sent;
+			stats->bytes_sent += tx_bytes;
+		}
+		seqlock_write_end(&stats->seq);
+	}
+
+	return recv_cnt;
 }
 
-void udp_client_cleanup(int socket)
+static uint16_t udp_socket_port(int socket)
 {
-	if (socket >= 0) {
-		zsock_close(socket);
-		LOG_INF("UDP client socket closed");
+	struct sockaddr_in addr;
+	socklen_t addr_len = sizeof(addr);
+
+	if (zsock_getsockname(socket, (struct sockaddr *)&addr, &addr_len) < 0) {
+		return 0;
 	}
+
+	return ntohs(addr.sin_port);
 }
 
-void udp_server_cleanup(int socket)
+int udp_echo_server_run_multi(const int *sockets, size_t count,
+			      struct udp_echo_stats *stats,
+			      struct udp_echo_stop *stop)
 {
-	if (socket >= 0) {
-		zsock_close(socket);
-		LOG_INF("UDP server socket closed");
+	struct zsock_pollfd pfds[UDP_ECHO_SERVER_MAX_SOCKETS + 1];
+	uint32_t packets[UDP_ECHO_SERVER_MAX_SOCKETS] = { 0 };
+	void *buffers[CONFIG_UDP_ECHO_BATCH_SIZE];
+	size_t n;
+	int ret;
+
+	if (count == 0 || count > UDP_ECHO_SERVER_MAX_SOCKETS) {
+		return -EINVAL;
+	}
+
+	ret = udp_buf_alloc(buffers, ARRAY_SIZE(buffers));
+	if (ret < 0) {
+		return ret;
+	}
+
+	for (n = 0; n < count; n++) {
+		pfds[n].fd = sockets[n];
+		pfds[n].events = ZSOCK_POLLIN;
+	}
+	pfds[count].fd = stop->efd;
+	pfds[count].events = ZSOCK_POLLIN;
+
+	LOG_INF("UDP Echo Server started - waiting for packets...");
+	stream_rx[UDP_STREAM_RX_UDP].active = false;
+
+	while (!stop->flag) {
+		/* Sleep until a datagram or the stop wakeup arrives. The
+		 * timeout only matters when there is no stop eventfd.
+		 */
+		ret = zsock_poll(pfds, count + 1, UDP_RECV_TIMEOUT_MS);
+		if (ret < 0) {
+			ret = -errno;
+			LOG_ERR("Echo server poll error: %d", ret);
+			udp_buf_free(buffers, ARRAY_SIZE(buffers));
+			return ret;
+		}
+
+		/* One batch per socket, so none waits behind a busy one */
+		for (n = 0; n < count; n++) {
+			if (pfds[n].revents & ZSOCK_POLLIN) {
+				packets[n] += udp_echo_server_batch(sockets[n],
+								    buffers, stats);
+			}
+		}
+	}
+
+	udp_buf_free(buffers, ARRAY_SIZE(buffers));
+
+	if (count > 1) {
+		for (n = 0; n < count; n++) {
+			LOG_INF("Port %u: %u packets", udp_socket_port(sockets[n]),
+				packets[n]);
+		}
 	}
+
+	LOG_INF("UDP Echo Server stopped");
+	return 0;
 }
 
-void udp_echo_print_stats(const struct udp_echo_stats *stats)
+int udp_echo_server_run(int socket, struct udp_echo_stats *stats,
+			struct udp_echo_stop *stop)
 {
-	if (!stats) {
-		return;
-	}
+	return udp_echo_server_run_multi(&socket, 1, stats, stop);
+}
 
-	LOG_INF("=== UDP Echo Statistics ===");
-	LOG_INF("Packets sent:     %u", stats->packets_sent);
-	LOG_INF("Packets received: %u", stats->packets_received);
-	LOG_INF("Packets lost:     %u", stats->packets_lost);
-	LOG_INF("Bytes sent:       %u", stats->bytes_sent);
-	LOG_INF("Bytes received:   %u", stats->bytes_received);
+/* Echo request slot states (windowed client) */
+enum echo_slot_state {
+	ECHO_SLOT_FREE = 0,
+	ECHO_SLOT_PENDING,
+	ECHO_SLOT_ANSWERED,
+	ECHO_SLOT_EXPIRED,
+};
 
-	/* Only print RTT stats if they were actually measured (client only) */
-	if (stats->packets_received > 0 && stats->rtt_min_us != UINT32_MAX) {
-		LOG_INF("RTT min:          %u.%03u ms", stats->rtt_min_us / 1000,
-			stats->rtt_min_us % 1000);
-		LOG_INF("RTT max:          %u.%03u ms", stats->rtt_max_us / 1000,
-			stats->rtt_max_us % 1000);
-		LOG_INF("RTT avg:          %u.%03u ms", stats->rtt_avg_us / 1000,
-			stats->rtt_avg_us % 1000);
+/* Outstanding echo request, indexed by seq % CONFIG_UDP_ECHO_WINDOW_MAX */
+struct echo_slot {
+	uint32_t seq;
+	/* Uptime in ms, used for expiry */
+	int64_t tx_time;
+	/* High-resolution send timestamp, used for RTT */
+	uint64_t tx_stamp;
+	enum echo_slot_state state;
+};
+
+/* Only one echo client runs at a time, so keep the window off the stack */
+static struct echo_slot echo_slots[CONFIG_UDP_ECHO_WINDOW_MAX];
+
+void udp_echo_stats_add_rtt(struct udp_echo_stats *stats, uint32_t rtt_us)
+{
+	if (stats->packets_received == 1 || rtt_us < stats->rtt_min_us) {
+		stats->rtt_min_us = rtt_us;
+	}
+	if (rtt_us > stats->rtt_max_us) {
+		stats->rtt_max_us = rtt_us;
 	}
+	stats->rtt_total_us += rtt_us;
+	stats->rtt_avg_us = (uint32_t)(stats->rtt_total_us /
+				       stats->packets_received);
 
-	if (stats->packets_sent > 0) {
-		uint32_t loss_pct = (stats->packets_lost * 100) / stats->packets_sent;
-		LOG_INF("Packet loss:      %u%%", loss_pct);
+	/* RFC 3550 A.8 estimator applied to consecutive RTT samples */
+	if (stats->rtt_hist.count > 0) {
+		uint32_t delta = rtt_us > stats->rtt_last_us ?
+				 rtt_us - stats->rtt_last_us :
+				 stats->rtt_last_us - rtt_us;
+
+		stats->jitter_q4 += delta - ((stats->jitter_q4 + 8) >> 4);
+		stats->jitter_us = stats->jitter_q4 >> 4;
 	}
+	stats->rtt_last_us = rtt_us;
 
-	LOG_INF("===========================");
+	rtt_histogram_add(&stats->rtt_hist, rtt_us);
 }
 
-void udp_echo_reset_stats(struct udp_echo_stats *stats)
+/* Echo request header flags */
+#define UDP_ECHO_PROTO_FLAGS \
+	(IS_ENABLED(CONFIG_UDP_ECHO_FULL_CRC) ? ECHO_PROTO_FLAG_FULL_CRC : 0)
+
+/**
+ * @brief Build the constant padding of the echo request payload once
+ */
+static void udp_echo_build_payload(char *buffer, size_t packet_size)
 {
-	if (stats) {
-		memset(stats, 0, sizeof(*stats));
-		stats->rtt_min_us = UINT32_MAX;
+	for (size_t i = ECHO_PROTO_HDR_LEN; i < packet_size; i++) {
+		buffer[i] = 'A' + (i % 26);
 	}
 }
+
+static void udp_echo_fill_request(char *buffer, size_t packet_size, uint32_t seq,
+				  uint64_t tx_time)
+{
+	echo_proto_write(buffer, packet_size, ECHO_PROTO_TYPE_ECHO,
+			 UDP_ECHO_PROTO_FLAGS, seq, tx_time);
+}
+
+/**
+ * @brief Validate an echo reply and extract its sequence number
+ *
+ * @return 0 on success, -EBADMSG if corrupted, -EINVAL if not an echo reply
+ */
+static int udp_echo_parse_reply(const char *buffer, size_t len, uint32_t *seq)
+{
+	struct echo_proto_hdr hdr;
+	int ret;
+
+	ret = echo_proto_parse(buffer, len, &hdr);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (hdr.type != ECHO_PROTO_TYPE_ECHO) {
+		return -EINVAL;
+	}
+
+	*seq = hdr.seq;
+	return 0;
+}
+
+/**
+ * @brief Match an echo reply to its request and account it
+ *
+ * @return RTT in microseconds of an accepted reply, negative error code
+ *         for corrupt, unexpected, late and duplicate replies
+ */
+static int udp_echo_handle_reply(const char *buffer, int len, uint64_t rx_time,
+				  uint32_t next_seq, uint32_t *highest_seq,
+				  uint32_t *in_flight, bool verbose,
+				  struct udp_echo_stats *stats)
+{
+	struct echo_slot *slot;
+	uint32_t seq;
+	uint32_t rtt_us;
+	int ret;
+
+	ret = udp_echo_parse_reply(buffer, len, &seq);
+	if (ret == -EBADMSG) {
+		if (stats) {
+			seqlock_write_begin(&stats->seq);
+			stats->packets_corrupt++;
+			seqlock_write_end(&stats->seq);
+		}
+		echo_trace_record(ECHO_TRACE_CORRUPT, 0, len);
+		UDP_PKT_LOG_WRN("Corrupt echo reply (%d bytes)", len);
+		return ret;
+	}
+
+	if (ret < 0 || seq >= next_seq) {
+		UDP_PKT_LOG_DBG("Ignoring unexpected echo reply (%d bytes)", len);
+		return -EINVAL;
+	}
+
+	slot = &echo_slots[seq % CONFIG_UDP_ECHO_WINDOW_MAX];
+
+	if (slot->seq != seq || slot->state == ECHO_SLOT_FREE) {
+		/* Slot already reused by a newer request */
+		if (stats) {
+			seqlock_write_begin(&stats->seq);
+			stats->packets_late++;
+			seqlock_write_end(&stats->seq);
+		}
+		echo_trace_record(ECHO_TRACE_LATE, seq, 0);
+		UDP_PKT_LOG_DBG("Late echo reply: seq=%u", seq);
+		return -ETIMEDOUT;
+	}
+
+	switch (slot->state) {
+	case ECHO_SLOT_PENDING:
+		break;
+	case ECHO_SLOT_ANSWERED:
+		if (stats) {
+			seqlock_write_begin(&stats->seq);
+			stats->packets_duplicate++;
+			seqlock_write_end(&stats->seq);
+		}
+		echo_trace_record(ECHO_TRACE_DUP, seq, 0);
+		UDP_PKT_LOG_DBG("Duplicate echo reply: seq=%u", seq);
+		return -EALREADY;
+	case ECHO_SLOT_EXPIRED:
+	default:
+		if (stats) {
+			seqlock_write_begin(&stats->seq);
+			stats->packets_late++;
+			seqlock_write_end(&stats->seq);
+		}
+		echo_trace_record(ECHO_TRACE_LATE, seq, 0);
+		UDP_PKT_LOG_DBG("Late echo reply: seq=%u", seq);
+		return -ETIMEDOUT;
+	}
+
+	rtt_us = time_utils_delta_us(slot->tx_stamp, rx_time);
+	slot->state = ECHO_SLOT_ANSWERED;
+	(*in_flight)--;
+
+	if (stats) {
+		seqlock_write_begin(&stats->seq);
+		stats->packets_received++;
+		stats->bytes_received += len;
+		if (*highest_seq != UINT32_MAX && seq < *highest_seq) {
+			stats->packets_reordered++;
+		}
+		udp_echo_stats_add_rtt(stats, rtt_us);
+		seqlock_write_end(&stats->seq);
+	}
+
+	if (*highest_seq == UINT32_MAX || seq > *highest_seq) {
+		*highest_seq = seq;
+	}
+
+	echo_trace_record(ECHO_TRACE_REPLY, seq, rtt_us);
+	if (verbose) {
+		UDP_PKT_LOG_INF("Echo reply: seq=%u, bytes=%d, RTT=%u.%03u ms",
+				seq, len, rtt_us / 1000, rtt_us % 1000);
+	} else {
+		UDP_PKT_LOG_DBG("Echo reply: seq=%u, bytes=%d, RTT=%u.%03u ms",
+				seq, len, rtt_us / 1000, rtt_us % 1000);
+	}
+
+	return (int)MIN(rtt_us, INT32_MAX);
+}
+
+/* Expire the requests whose reply did not arrive in time, returns the
+ * earlier of @p wake_ms and the next expiry
+ */
+static int64_t udp_echo_expire(int64_t now_ms, int64_t wake_ms,
+			       uint32_t *in_flight, struct udp_echo_stats *stats)
+{
+	for (int i = 0; i < CONFIG_UDP_ECHO_WINDOW_MAX; i++) {
+		struct echo_slot *slot = &echo_slots[i];
+		int64_t expiry = slot->tx_time + UDP_RECV_TIMEOUT_MS;
+
+		if (slot->state != ECHO_SLOT_PENDING) {
+			continue;
+		}
+
+		if (now_ms >= expiry) {
+			slot->state = ECHO_SLOT_EXPIRED;
+			(*in_flight)--;
+			if (stats) {
+				seqlock_write_begin(&stats->seq);
+				stats->packets_lost++;
+				seqlock_write_end(&stats->seq);
+			}
+			echo_trace_record(ECHO_TRACE_TIMEOUT, slot->seq, 0);
+			UDP_PKT_LOG_WRN("Echo timeout: seq=%u", slot->seq);
+		} else if (expiry < wake_ms) {
+			wake_ms = expiry;
+		}
+	}
+
+	return wake_ms;
+}
+
+/* Send request @p seq and make its window slot pending */
+static void udp_echo_send_request(int socket, struct sockaddr_in *server_addr,
+				  char *send_buffer, size_t packet_size,
+				  uint32_t seq, int64_t now_ms, uint64_t now,
+				  uint32_t *in_flight, struct udp_echo_stats *stats)
+{
+	struct echo_slot *slot = &echo_slots[seq % CONFIG_UDP_ECHO_WINDOW_MAX];
+	int ret;
+
+	slot->tx_stamp = now;
+	udp_echo_fill_request(send_buffer, packet_size, seq, slot->tx_stamp);
+
+	ret = udp_send(socket, server_addr, send_buffer, packet_size);
+	if (ret < 0) {
+		echo_trace_record(ECHO_TRACE_ERROR, seq, ret);
+		UDP_PKT_LOG_ERR("Echo error: seq=%u, ret=%d", seq, ret);
+		return;
+	}
+
+	echo_trace_record(ECHO_TRACE_TX, seq, packet_size);
+	slot->seq = seq;
+	slot->tx_time = now_ms;
+	slot->state = ECHO_SLOT_PENDING;
+	(*in_flight)++;
+	if (stats) {
+		seqlock_write_begin(&stats->seq);
+		stats->packets_sent++;
+		stats->bytes_sent += packet_size;
+		seqlock_write_end(&stats->seq);
+	}
+}
+
+static uint64_t udp_echo_period_ns(const struct udp_echo_client_params *params)
+{
+	if (params->rate_pps > 0) {
+		return NSEC_PER_SEC / params->rate_pps;
+	}
+
+	return (uint64_t)params->interval_ms * NSEC_PER_MSEC;
+}
+
+static int udp_echo_client_loop(int socket, struct sockaddr_in *server_addr,
+				size_t packet_size,
+				const struct udp_echo_client_params *params,
+				uint32_t window,
+				char *send_buffer, char *recv_buffer,
+				size_t buffer_size,
+				struct udp_echo_stats *stats,
+				struct udp_echo_stop *stop)
+{
+	struct zsock_pollfd pfds[] = {
+		{ .fd = socket, .events = ZSOCK_POLLIN },
+		{ .fd = stop->efd, .events = ZSOCK_POLLIN },
+	};
+	struct tx_sched sched;
+	uint32_t next_seq = 0;
+	uint32_t highest_seq = UINT32_MAX;
+	uint32_t in_flight = 0;
+	/* Stop-and-wait keeps the original per-reply log line */
+	bool verbose = (window == 1);
+	int ret;
+
+	memset(echo_slots, 0, sizeof(echo_slots));
+	tx_sched_init(&sched, params->pattern, udp_echo_period_ns(params),
+		      params->burst);
+
+	while (!stop->flag) {
+		bool more_to_send = params->count == 0 || next_seq < params->count;
+		int64_t now_ms = k_uptime_get();
+		int64_t wake_ms = now_ms + UDP_RECV_TIMEOUT_MS;
+		uint64_t now = 0;
+		uint64_t deadline = 0;
+		bool send_ready = false;
+		int timeout_ms;
+
+		if (!more_to_send && in_flight == 0) {
+			LOG_INF("Completed %d echo requests", params->count);
+			break;
+		}
+
+		/* Expire requests whose reply did not arrive in time */
+		wake_ms = udp_echo_expire(now_ms, wake_ms, &in_flight, stats);
+
+		/* Send on the scheduler's deadline if the window has room */
+		if (more_to_send && in_flight < window) {
+			struct echo_slot *slot =
+				&echo_slots[next_seq % CONFIG_UDP_ECHO_WINDOW_MAX];
+
+			if (slot->state != ECHO_SLOT_PENDING) {
+				now = time_utils_now();
+				deadline = tx_sched_deadline(&sched);
+				send_ready = true;
+			}
+
+			if (send_ready && now >= deadline) {
+				udp_echo_send_request(socket, server_addr, send_buffer,
+						      packet_size, next_seq, now_ms, now,
+						      &in_flight, stats);
+				next_seq++;
+				tx_sched_advance(&sched);
+				continue;
+			}
+		}
+
+		/* Wait for replies, the next deadline or the next expiry. poll()
+		 * has millisecond resolution, so the last sub-millisecond before
+		 * a deadline is slept with an absolute timeout instead.
+		 */
+		timeout_ms = (int)MAX(wake_ms - now_ms, 0);
+		if (send_ready) {
+			uint32_t until_us = time_utils_delta_us(now, deadline);
+
+			timeout_ms = MIN(timeout_ms, (int)(until_us / USEC_PER_MSEC));
+		}
+
+		ret = zsock_poll(pfds, ARRAY_SIZE(pfds), timeout_ms);
+		if (ret < 0) {
+			LOG_ERR("Echo client poll error: %d", errno);
+			return -errno;
+		}
+
+		if (ret == 0 || !(pfds[0].revents & ZSOCK_POLLIN)) {
+			if (send_ready && timeout_ms == 0) {
+				tx_sched_wait(&sched);
+			}
+			continue;
+		}
+
+		/* Drain every queued reply before servicing the window again */
+		while (true) {
+			uint64_t rx_time;
+
+			ret = udp_receive_timestamped(socket, recv_buffer,
+						      buffer_size, NULL,
+						      ZSOCK_MSG_DONTWAIT, &rx_time);
+			if (ret <= 0) {
+				break;
+			}
+
+			udp_echo_handle_reply(recv_buffer, ret, rx_time, next_seq,
+					      &highest_seq, &in_flight, verbose,
+					      stats);
+		}
+	}
+
+	if (sched.missed > 0) {
+		LOG_WRN("%u send deadlines missed (window full or sender too slow)",
+			sched.missed);
+	}
+
+	return 0;
+}
+
+int udp_echo_client_run(int socket, struct sockaddr_in *server_addr,
+			const struct udp_echo_client_params *params,
+			struct udp_echo_stats *stats,
+			struct udp_echo_stop *stop)
+{
+	static const char *const pattern_names[] = {
+		[TX_SCHED_PERIODIC] = "periodic",
+		[TX_SCHED_POISSON] = "poisson",
+		[TX_SCHED_BURST] = "burst",
+	};
+	void *bufs[2];
+	char *send_buffer, *recv_buffer;
+	size_t packet_size = params->packet_size;
+	uint32_t window = CLAMP(params->window, 1, CONFIG_UDP_ECHO_WINDOW_MAX);
+	uint64_t period_ns = udp_echo_period_ns(params);
+	int ret;
+
+	/* Ensure packet size is within bounds */
+	packet_size = CLAMP(packet_size, ECHO_PROTO_HDR_LEN,
+			    CONFIG_UDP_ECHO_MAX_PACKET_SIZE);
+
+	if (!atomic_cas(&client_active, 0, 1)) {
+		LOG_ERR("Another echo client is running");
+		return -EBUSY;
+	}
+
+	ret = udp_buf_alloc(bufs, ARRAY_SIZE(bufs));
+	if (ret < 0) {
+		atomic_clear(&client_active);
+		return ret;
+	}
+	send_buffer = bufs[0];
+	recv_buffer = bufs[1];
+
+	LOG_INF("UDP Echo Client started");
+	LOG_INF("  Packet size: %d bytes", packet_size);
+	LOG_INF("  Interval: %u.%03u ms (%s)", (uint32_t)(period_ns / NSEC_PER_MSEC),
+		(uint32_t)((period_ns % NSEC_PER_MSEC) / NSEC_PER_USEC),
+		params->pattern < ARRAY_SIZE(pattern_names) ?
+		pattern_names[params->pattern] : "?");
+	LOG_INF("  Count: %s", params->count == 0 ? "infinite" : "");
+	LOG_INF("  Window: %d", window);
+
+	udp_echo_build_payload(send_buffer, packet_size);
+
+	ret = udp_echo_client_loop(socket, server_addr, packet_size, params,
+				   window, send_buffer, recv_buffer,
+				   UDP_ECHO_BUF_SIZE, stats, stop);
+
+	udp_buf_free(bufs, ARRAY_SIZE(bufs));
+	atomic_clear(&client_active);
+
+	LOG_INF("UDP Echo Client stopped");
+	return ret;
+}
+
+/* Sweep sizes double from the minimum, stopping at the single-frame
+ * payload on the way so the cost of IPv4 fragmentation shows up
+ */
+size_t udp_echo_sweep_next_size(size_t size, size_t max_size)
+{
+	size_t next = size * 2;
+
+	if (size < UDP_MTU_PAYLOAD && next > UDP_MTU_PAYLOAD) {
+		next = UDP_MTU_PAYLOAD;
+	}
+
+	return MIN(next, max_size);
+}
+
+#if defined(CONFIG_UDP_ECHO_SWEEP)
+int udp_echo_sweep_run(int socket, struct sockaddr_in *server_addr,
+		       const struct udp_echo_client_params *params,
+		       struct udp_echo_stats *stats,
+		       struct udp_echo_stop *stop)
+{
+	/* Snapshot buffer is too large for the client stack */
+	static struct udp_echo_stats snap;
+	struct udp_echo_client_params step = *params;
+	uint32_t best_kbps = 0;
+	size_t best_size = 0;
+	size_t size = CONFIG_UDP_ECHO_SWEEP_MIN_SIZE;
+	uint64_t start_us, elapsed_us;
+	int ret = 0;
+
+	step.count = CONFIG_UDP_ECHO_SWEEP_COUNT;
+
+	LOG_INF("Packet size sweep: %u to %u bytes, %u requests each",
+		CONFIG_UDP_ECHO_SWEEP_MIN_SIZE, CONFIG_UDP_ECHO_MAX_PACKET_SIZE,
+		CONFIG_UDP_ECHO_SWEEP_COUNT);
+
+	while (!stop->flag) {
+		uint32_t kbps = 0;
+		uint32_t p99_us = 0;
+
+		step.packet_size = size;
+		udp_echo_reset_stats(stats);
+
+		start_us = time_utils_to_us(time_utils_now());
+		ret = udp_echo_client_run(socket, server_addr, &step, stats, stop);
+		elapsed_us = time_utils_to_us(time_utils_now()) - start_us;
+		if (ret < 0 || stop->flag) {
+			break;
+		}
+
+		udp_echo_stats_snapshot(stats, &snap);
+
+		/* Goodput of the echoed payload, the direction-limited rate */
+		if (elapsed_us > 0) {
+			kbps = (uint32_t)(snap.bytes_received * 8 * 1000 / elapsed_us);
+		}
+		if (snap.packets_received > 0) {
+			p99_us = CLAMP(rtt_histogram_percentile(&snap.rtt_hist, 9900),
+				       snap.rtt_min_us, snap.rtt_max_us);
+		}
+
+		LOG_INF("Sweep %5u B: %u/%u replies, RTT avg %u.%03u p99 %u.%03u ms, "
+			"%u kbit/s%s", (uint32_t)size,
+			(uint32_t)snap.packets_received, (uint32_t)snap.packets_sent,
+			snap.rtt_avg_us / 1000, snap.rtt_avg_us % 1000,
+			p99_us / 1000, p99_us % 1000, kbps,
+			size > UDP_MTU_PAYLOAD ? " (fragmented)" : "");
+
+		if (kbps > best_kbps) {
+			best_kbps = kbps;
+			best_size = size;
+		}
+
+		if (size >= CONFIG_UDP_ECHO_MAX_PACKET_SIZE) {
+			break;
+		}
+		size = udp_echo_sweep_next_size(size, CONFIG_UDP_ECHO_MAX_PACKET_SIZE);
+	}
+
+	if (best_size > 0) {
+		LOG_INF("Sweep best: %u bytes at %u kbit/s", (uint32_t)best_size,
+			best_kbps);
+	}
+
+	return ret;
+}
+#endif /* CONFIG_UDP_ECHO_SWEEP */
+
+static void udp_stream_fill_header(char *buffer, uint32_t seq, uint16_t flags)
+{
+	/* Header-only CRC: stream packets are not checked end to end */
+	echo_proto_write(buffer, ECHO_PROTO_HDR_LEN, ECHO_PROTO_TYPE_STREAM,
+			 flags, seq, time_utils_now());
+}
+
+int udp_stream_client_run(int socket, struct sockaddr_in *server_addr,
+			  const struct udp_stream_params *params,
+			  struct udp_echo_stats *stats,
+			  struct udp_echo_stop *stop)
+{
+	size_t packet_size = CLAMP(params->packet_size,
+				   ECHO_PROTO_HDR_LEN,
+				   CONFIG_UDP_THROUGHPUT_PACKET_SIZE);
+	void *buf;
+	char *send_buffer;
+	struct tx_sched sched;
+	uint64_t period_ns = 0;
+	uint64_t start_us, now_us;
+	uint64_t bytes_sent = 0;
+	uint32_t send_errors = 0;
+	uint32_t seq = 0;
+	int ret;
+
+	if (!atomic_cas(&client_active, 0, 1)) {
+		LOG_ERR("Another echo client is running");
+		return -EBUSY;
+	}
+
+	ret = udp_buf_alloc(&buf, 1);
+	if (ret < 0) {
+		atomic_clear(&client_active);
+		return ret;
+	}
+	send_buffer = buf;
+
+	if (params->rate_kbps > 0) {
+		period_ns = (packet_size * 8ULL * NSEC_PER_MSEC) / params->rate_kbps;
+	}
+
+	LOG_INF("UDP Throughput Stream started");
+	LOG_INF("  Packet size: %d bytes", packet_size);
+	LOG_INF("  Target rate: %s%u kbit/s", params->rate_kbps ? "" : "max, ",
+		params->rate_kbps);
+	LOG_INF("  Duration: %u ms", params->duration_ms);
+
+	memset(send_buffer, 'S', packet_size);
+
+	tx_sched_init(&sched, TX_SCHED_PERIODIC, period_ns, 1);
+	start_us = time_utils_to_us(time_utils_now());
+
+	while (!stop->flag) {
+		now_us = time_utils_to_us(time_utils_now());
+
+		if (params->duration_ms > 0 &&
+		    now_us - start_us >= params->duration_ms * 1000ULL) {
+			break;
+		}
+
+		tx_sched_wait(&sched);
+
+		udp_stream_fill_header(send_buffer, seq, 0);
+
+		ret = zsock_sendto(socket, send_buffer, packet_size, 0,
+				   (struct sockaddr *)server_addr,
+				   sizeof(*server_addr));
+		if (ret < 0) {
+			/* Out of TX buffers: back off and retry this sequence */
+			if (errno == ENOMEM || errno == ENOBUFS || errno == EAGAIN) {
+				send_errors++;
+				udp_buffer_backoff();
+				continue;
+			}
+			LOG_ERR("Stream send error: %d", errno);
+			break;
+		}
+
+		bytes_sent += ret;
+		seq++;
+		tx_sched_advance(&sched);
+
+		if (stats) {
+			seqlock_write_begin(&stats->seq);
+			stats->packets_sent++;
+			stats->bytes_sent += ret;
+			seqlock_write_end(&stats->seq);
+		}
+	}
+
+	/* Tell the receiver to print its totals */
+	for (int i = 0; i < UDP_STREAM_END_MARKERS; i++) {
+		udp_stream_fill_header(send_buffer, seq, ECHO_PROTO_FLAG_END);
+		(void)zsock_sendto(socket, send_buffer, ECHO_PROTO_HDR_LEN,
+				   0, (struct sockaddr *)server_addr,
+				   sizeof(*server_addr));
+	}
+
+	now_us = time_utils_to_us(time_utils_now());
+	if (now_us > start_us) {
+		LOG_INF("Stream sent %u packets, %llu bytes in %u ms (%u kbit/s), "
+			"%u send retries",
+			seq, (unsigned long long)bytes_sent,
+			(uint32_t)((now_us - start_us) / 1000),
+			(uint32_t)((bytes_sent * 8 * 1000) / (now_us - start_us)),
+			send_errors);
+	}
+
+	udp_buf_free(&buf, 1);
+	atomic_clear(&client_active);
+
+	LOG_INF("UDP Throughput Stream stopped");
+	return 0;
+}
+
+#if defined(CONFIG_UDP_ECHO_MULTI_STREAM)
+/* Stream packets sent per loop pass at most, so replies are drained
+ * between them even when the stream is unpaced
+ */
+#define UDP_MIXED_BULK_BURST 4
+
+/* Probe RTTs of one phase of a mixed run */
+struct udp_mixed_phase {
+	struct rtt_histogram hist;
+	uint32_t min_us;
+	uint32_t max_us;
+	uint64_t total_us;
+};
+
+enum udp_mixed_phase_id {
+	UDP_MIXED_BASELINE,
+	UDP_MIXED_LOADED,
+	UDP_MIXED_PHASES,
+};
+
+/* Only one client runs at a time, so keep the histograms off the stack */
+static struct udp_mixed_phase mixed_phase[UDP_MIXED_PHASES];
+static char mixed_bulk_buffer[CONFIG_UDP_THROUGHPUT_PACKET_SIZE];
+
+static void udp_mixed_phase_add(struct udp_mixed_phase *ph, uint32_t rtt_us)
+{
+	if (ph->hist.count == 0 || rtt_us < ph->min_us) {
+		ph->min_us = rtt_us;
+	}
+	ph->max_us = MAX(ph->max_us, rtt_us);
+	ph->total_us += rtt_us;
+	rtt_histogram_add(&ph->hist, rtt_us);
+}
+
+static uint32_t udp_mixed_phase_percentile(const struct udp_mixed_phase *ph,
+					   uint32_t permyriad)
+{
+	return CLAMP(rtt_histogram_percentile(&ph->hist, permyriad),
+		     ph->min_us, ph->max_us);
+}
+
+static void udp_mixed_phase_print(const char *label,
+				  const struct udp_mixed_phase *ph)
+{
+	uint32_t avg_us, p50_us, p99_us;
+
+	if (ph->hist.count == 0) {
+		LOG_INF("Probe RTT %s: no replies", label);
+		return;
+	}
+
+	avg_us = (uint32_t)(ph->total_us / ph->hist.count);
+	p50_us = udp_mixed_phase_percentile(ph, 5000);
+	p99_us = udp_mixed_phase_percentile(ph, 9900);
+
+	LOG_INF("Probe RTT %-8s n=%u min %u.%03u avg %u.%03u p50 %u.%03u "
+		"p99 %u.%03u max %u.%03u ms", label, ph->hist.count,
+		ph->min_us / 1000, ph->min_us % 1000, avg_us / 1000, avg_us % 1000,
+		p50_us / 1000, p50_us % 1000, p99_us / 1000, p99_us % 1000,
+		ph->max_us / 1000, ph->max_us % 1000);
+}
+
+static void udp_mixed_print_inflation(void)
+{
+	const struct udp_mixed_phase *base = &mixed_phase[UDP_MIXED_BASELINE];
+	const struct udp_mixed_phase *load = &mixed_phase[UDP_MIXED_LOADED];
+	int32_t p50_us, p99_us;
+
+	if (base->hist.count == 0 || load->hist.count == 0) {
+		return;
+	}
+
+	p50_us = (int32_t)udp_mixed_phase_percentile(load, 5000) -
+		 (int32_t)udp_mixed_phase_percentile(base, 5000);
+	p99_us = (int32_t)udp_mixed_phase_percentile(load, 9900) -
+		 (int32_t)udp_mixed_phase_percentile(base, 9900);
+
+	LOG_INF("Bulk inflates probe RTT: p50 %c%u.%03u ms, p99 %c%u.%03u ms",
+		p50_us < 0 ? '-' : '+', abs(p50_us) / 1000, abs(p50_us) % 1000,
+		p99_us < 0 ? '-' : '+', abs(p99_us) / 1000, abs(p99_us) % 1000);
+}
+
+/* Send up to UDP_MIXED_BULK_BURST due stream packets. Returns the number
+ * sent, -ENOBUFS when the stack is out of buffers, or another negative
+ * error code if the stream failed.
+ */
+static int udp_mixed_send_bulk(int socket, struct sockaddr_in *addr,
+			       size_t packet_size, struct tx_sched *sched,
+			       uint32_t *seq, uint64_t *bytes)
+{
+	int sent = 0;
+	int ret;
+
+	while (sent < UDP_MIXED_BULK_BURST &&
+	       time_utils_now() >= tx_sched_deadline(sched)) {
+		udp_stream_fill_header(mixed_bulk_buffer, *seq, 0);
+
+		ret = zsock_sendto(socket, mixed_bulk_buffer, packet_size,
+				   ZSOCK_MSG_DONTWAIT, (struct sockaddr *)addr,
+				   sizeof(*addr));
+		if (ret < 0) {
+			if (errno == ENOMEM || errno == ENOBUFS || errno == EAGAIN) {
+				mem_stats_alloc_failed();
+				return -ENOBUFS;
+			}
+			return -errno;
+		}
+
+		*bytes += ret;
+		(*seq)++;
+		sent++;
+		tx_sched_advance(sched);
+	}
+
+	return sent;
+}
+
+int udp_echo_mixed_run(int probe_socket, struct sockaddr_in *probe_addr,
+		       int bulk_socket, struct sockaddr_in *bulk_addr,
+		       const struct udp_echo_client_params *probe,
+		       const struct udp_stream_params *bulk,
+		       uint32_t baseline_ms,
+		       struct udp_echo_stats *stats,
+		       struct udp_echo_stop *stop)
+{
+	struct zsock_pollfd pfds[] = {
+		{ .fd = probe_socket, .events = ZSOCK_POLLIN },
+		{ .fd = stop->efd, .events = ZSOCK_POLLIN },
+	};
+	size_t probe_size = CLAMP(probe->packet_size, ECHO_PROTO_HDR_LEN,
+				  CONFIG_UDP_ECHO_MAX_PACKET_SIZE);
+	size_t bulk_size = CLAMP(bulk->packet_size, ECHO_PROTO_HDR_LEN,
+				 sizeof(mixed_bulk_buffer));
+	uint32_t window = CLAMP(probe->window, 1, CONFIG_UDP_ECHO_WINDOW_MAX);
+	enum udp_mixed_phase_id phase = UDP_MIXED_BASELINE;
+	struct tx_sched probe_sched, bulk_sched;
+	uint64_t bulk_period_ns = 0;
+	uint64_t bulk_bytes = 0;
+	uint32_t bulk_seq = 0;
+	uint32_t bulk_retries = 0;
+	uint32_t next_seq = 0;
+	uint32_t highest_seq = UINT32_MAX;
+	uint32_t in_flight = 0;
+	int64_t bulk_start_ms, bulk_end_ms = 0;
+	bool bulk_done = false;
+	bool backoff = false;
+	void *bufs[2];
+	char *send_buffer, *recv_buffer;
+	int err = 0;
+	int ret;
+
+	if (!atomic_cas(&client_active, 0, 1)) {
+		LOG_ERR("Another echo client is running");
+		return -EBUSY;
+	}
+
+	ret = udp_buf_alloc(bufs, ARRAY_SIZE(bufs));
+	if (ret < 0) {
+		atomic_clear(&client_active);
+		return ret;
+	}
+	send_buffer = bufs[0];
+	recv_buffer = bufs[1];
+
+	if (bulk->rate_kbps > 0) {
+		bulk_period_ns = (bulk_size * 8ULL * NSEC_PER_MSEC) / bulk->rate_kbps;
+	}
+
+	LOG_INF("UDP Mixed Client started");
+	LOG_INF("  Probes: %d bytes, window %u", probe_size, window);
+	LOG_INF("  Bulk: %d bytes, %s%u kbit/s, %u ms after %u ms baseline",
+		bulk_size, bulk->rate_kbps ? "" : "max, ", bulk->rate_kbps,
+		bulk->duration_ms, baseline_ms);
+
+	memset(echo_slots, 0, sizeof(echo_slots));
+	memset(mixed_phase, 0, sizeof(mixed_phase));
+	udp_echo_build_payload(send_buffer, probe_size);
+	memset(mixed_bulk_buffer, 'S', bulk_size);
+
+	tx_sched_init(&probe_sched, probe->pattern, udp_echo_period_ns(probe),
+		      probe->burst);
+	bulk_start_ms = k_uptime_get() + baseline_ms;
+
+	while (!stop->flag) {
+		int64_t now_ms = k_uptime_get();
+		int64_t wake_ms = now_ms + UDP_RECV_TIMEOUT_MS;
+		struct tx_sched *next_sched = NULL;
+		uint64_t now = time_utils_now();
+		uint64_t deadline = 0;
+		int timeout_ms;
+
+		/* Baseline over: start the stream */
+		if (phase == UDP_MIXED_BASELINE && now_ms >= bulk_start_ms) {
+			LOG_INF("Bulk stream started after %u probe replies",
+				mixed_phase[UDP_MIXED_BASELINE].hist.count);
+			phase = UDP_MIXED_LOADED;
+			tx_sched_init(&bulk_sched, TX_SCHED_PERIODIC, bulk_period_ns, 1);
+			if (bulk->duration_ms > 0) {
+				bulk_end_ms = now_ms + bulk->duration_ms;
+			}
+		}
+
+		/* Stream over: stop probing and collect the last replies */
+		if (phase == UDP_MIXED_LOADED && !bulk_done && bulk_end_ms > 0 &&
+		    now_ms >= bulk_end_ms) {
+			bulk_done = true;
+		}
+
+		if (bulk_done && in_flight == 0) {
+			break;
+		}
+
+		wake_ms = udp_echo_expire(now_ms, wake_ms, &in_flight, stats);
+
+		/* Probe on its deadline if the window has room */
+		if (!bulk_done && in_flight < window &&
+		    echo_slots[next_seq % CONFIG_UDP_ECHO_WINDOW_MAX].state !=
+		    ECHO_SLOT_PENDING) {
+			deadline = tx_sched_deadline(&probe_sched);
+			if (now >= deadline) {
+				udp_echo_send_request(probe_socket, probe_addr,
+						      send_buffer, probe_size,
+						      next_seq, now_ms, now,
+						      &in_flight, stats);
+				next_seq++;
+				tx_sched_advance(&probe_sched);
+				continue;
+			}
+			next_sched = &probe_sched;
+		}
+
+		if (phase == UDP_MIXED_LOADED && !bulk_done) {
+			ret = udp_mixed_send_bulk(bulk_socket, bulk_addr, bulk_size,
+						  &bulk_sched, &bulk_seq,
+						  &bulk_bytes);
+			backoff = (ret == -ENOBUFS);
+			if (backoff) {
+				bulk_retries++;
+			} else if (ret < 0) {
+				LOG_ERR("Stream send error: %d", ret);
+				bulk_done = true;
+				continue;
+			} else if (ret == UDP_MIXED_BULK_BURST) {
+				/* More may be due: drain replies, don't sleep */
+				wake_ms = now_ms;
+			}
+
+			if (!next_sched ||
+			    tx_sched_deadline(&bulk_sched) < deadline) {
+				deadline = tx_sched_deadline(&bulk_sched);
+				next_sched = &bulk_sched;
+			}
+		}
+
+		if (phase == UDP_MIXED_BASELINE) {
+			wake_ms = MIN(wake_ms, bulk_start_ms);
+		} else if (!bulk_done && bulk_end_ms > 0) {
+			wake_ms = MIN(wake_ms, bulk_end_ms);
+		}
+
+		/* Wait for replies or the next deadline. Out of buffers, give
+		 * the stack a tick to release some; the last sub-millisecond
+		 * before a deadline is slept with an absolute timeout.
+		 */
+		timeout_ms = (int)MAX(wake_ms - now_ms, 0);
+		if (backoff) {
+			timeout_ms = MAX(timeout_ms, 1);
+		} else if (next_sched) {
+			now = time_utils_now();
+			timeout_ms = MIN(timeout_ms, deadline > now ?
+					 (int)(time_utils_delta_us(now, deadline) /
+					       USEC_PER_MSEC) : 0);
+		}
+
+		ret = zsock_poll(pfds, ARRAY_SIZE(pfds), timeout_ms);
+		if (ret < 0) {
+			err = -errno;
+			LOG_ERR("Mixed client poll error: %d", err);
+			break;
+		}
+
+		if (ret == 0 || !(pfds[0].revents & ZSOCK_POLLIN)) {
+			if (next_sched && !backoff && timeout_ms == 0 &&
+			    wake_ms > now_ms) {
+				tx_sched_wait(next_sched);
+			}
+			continue;
+		}
+
+		while (true) {
+			uint64_t rx_time;
+			int rtt_us;
+
+			ret = udp_receive_timestamped(probe_socket, recv_buffer,
+						      UDP_ECHO_BUF_SIZE, NULL,
+						      ZSOCK_MSG_DONTWAIT, &rx_time);
+			if (ret <= 0) {
+				break;
+			}
+
+			rtt_us = udp_echo_handle_reply(recv_buffer, ret, rx_time,
+						       next_seq, &highest_seq,
+						       &in_flight, false, stats);
+			if (rtt_us >= 0) {
+				udp_mixed_phase_add(&mixed_phase[phase], rtt_us);
+			}
+		}
+	}
+
+	/* Tell the receiver to print its totals */
+	if (phase == UDP_MIXED_LOADED) {
+		for (int i = 0; i < UDP_STREAM_END_MARKERS; i++) {
+			udp_stream_fill_header(mixed_bulk_buffer, bulk_seq,
+					       ECHO_PROTO_FLAG_END);
+			(void)zsock_sendto(bulk_socket, mixed_bulk_buffer,
+					   ECHO_PROTO_HDR_LEN, 0,
+					   (struct sockaddr *)bulk_addr,
+					   sizeof(*bulk_addr));
+		}
+	}
+
+	LOG_INF("Bulk sent %u packets, %llu bytes, %u send retries", bulk_seq,
+		(unsigned long long)bulk_bytes, bulk_retries);
+	udp_mixed_phase_print("baseline", &mixed_phase[UDP_MIXED_BASELINE]);
+	udp_mixed_phase_print("loaded", &mixed_phase[UDP_MIXED_LOADED]);
+	udp_mixed_print_inflation();
+
+	udp_buf_free(bufs, ARRAY_SIZE(bufs));
+	atomic_clear(&client_active);
+
+	LOG_INF("UDP Mixed Client stopped");
+	return err;
+}
+#endif /* CONFIG_UDP_ECHO_MULTI_STREAM */
+
+void udp_client_cleanup(int socket)
+{
+	if (socket >= 0) {
+		zsock_close(socket);
+		LOG_INF("UDP client socket closed");
+	}
+}
+
+void udp_server_cleanup(int socket)
+{
+	if (socket >= 0) {
+		zsock_close(socket);
+		LOG_INF("UDP server socket closed");
+	}
+}
+
+void udp_echo_print_stats(const struct udp_echo_stats *live)
+{
+	/* Snapshot buffer is too large for work queue stacks */
+	static struct udp_echo_stats snapshot;
+	static K_MUTEX_DEFINE(snapshot_lock);
+	const struct udp_echo_stats *stats = &snapshot;
+
+	if (!live) {
+		return;
+	}
+
+	k_mutex_lock(&snapshot_lock, K_FOREVER);
+	udp_echo_stats_snapshot(live, &snapshot);
+
+	LOG_INF("=== UDP Echo Statistics ===");
+	LOG_INF("Packets sent:     %llu", (unsigned long long)stats->packets_sent);
+	LOG_INF("Packets received: %llu", (unsigned long long)stats->packets_received);
+	LOG_INF("Packets lost:     %llu", (unsigned long long)stats->packets_lost);
+	LOG_INF("Bytes sent:       %llu", (unsigned long long)stats->bytes_sent);
+	LOG_INF("Bytes received:   %llu", (unsigned long long)stats->bytes_received);
+
+	/* Only print RTT stats if they were actually measured (client only) */
+	if (stats->packets_received > 0 && stats->rtt_min_us != UINT32_MAX) {
+		LOG_INF("RTT min:          %u.%03u ms", stats->rtt_min_us / 1000,
+			stats->rtt_min_us % 1000);
+		LOG_INF("RTT max:          %u.%03u ms", stats->rtt_max_us / 1000,
+			stats->rtt_max_us % 1000);
+		LOG_INF("RTT avg:          %u.%03u ms", stats->rtt_avg_us / 1000,
+			stats->rtt_avg_us % 1000);
+		LOG_INF("RTT jitter:       %u.%03u ms", stats->jitter_us / 1000,
+			stats->jitter_us % 1000);
+
+		static const struct {
+			const char *label;
+			uint32_t permyriad;
+		} pct[] = {
+			{ "p50:", 5000 }, { "p90:", 9000 },
+			{ "p99:", 9900 }, { "p99.9:", 9990 },
+		};
+
+		for (int i = 0; i < ARRAY_SIZE(pct); i++) {
+			uint32_t us = rtt_histogram_percentile(&stats->rtt_hist,
+							       pct[i].permyriad);
+
+			/* Bucket midpoints can fall outside the observed range */
+			us = CLAMP(us, stats->rtt_min_us, stats->rtt_max_us);
+
+			LOG_INF("RTT %-7s       %u.%03u ms", pct[i].label,
+				us / 1000, us % 1000);
+		}
+	}
+
+	if (stats->packets_late || stats->packets_reordered ||
+	    stats->packets_duplicate || stats->packets_corrupt) {
+		LOG_INF("Late replies:     %u", stats->packets_late);
+		LOG_INF("Reordered:        %u", stats->packets_reordered);
+		LOG_INF("Duplicates:       %u", stats->packets_duplicate);
+		LOG_INF("Corrupt:          %u", stats->packets_corrupt);
+	}
+
+	if (stats->packets_dropped) {
+		LOG_INF("Not echoed:       %u", stats->packets_dropped);
+	}
+
+	if (stats->packets_sent > 0) {
+		uint32_t loss_pct = (uint32_t)((stats->packets_lost * 100) /
+					       stats->packets_sent);
+		LOG_INF("Packet loss:      %u%%", loss_pct);
+	}
+
+	LOG_INF("===========================");
+	k_mutex_unlock(&snapshot_lock);
+
+	mem_stats_print();
+}
+
+void udp_echo_reset_stats(struct udp_echo_stats *stats)
+{
+	atomic_val_t seq;
+
+	if (stats) {
+		seqlock_write_begin(&stats->seq);
+		seq = atomic_get(&stats->seq);
+		memset(stats, 0, sizeof(*stats));
+		atomic_set(&stats->seq, seq);
+		stats->rtt_min_us = UINT32_MAX;
+		seqlock_write_end(&stats->seq);
+	}
+}
+
+void udp_echo_stats_snapshot(const struct udp_echo_stats *stats,
+			     struct udp_echo_stats *snapshot)
+{
+	atomic_val_t seq;
+
+	do {
+		seq = seqlock_read_begin(&stats->seq);
+		memcpy(snapshot, stats, sizeof(*snapshot));
+	} while (seqlock_read_retry(&stats->seq, seq));
+}
@@ -9,23 +9,45 @@
 
 #include <zephyr/kernel.h>
 #include <zephyr/net/socket.h>
+#include <zephyr/sys/atomic.h>
+
+#include "rtt_histogram.h"
+#include "echo_proto.h"
+#include "tx_sched.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-/** UDP Echo statistics */
+/**
+ * Priority of the echo data plane threads, CONFIG_UDP_ECHO_THREAD_PRIORITY
+ * clamped to the configured application priorities
+ */
+#define UDP_ECHO_THREAD_PRIO                                                  \
+	CLAMP(CONFIG_UDP_ECHO_THREAD_PRIORITY,                                \
+	      K_HIGHEST_APPLICATION_THREAD_PRIO,                              \
+	      K_LOWEST_APPLICATION_THREAD_PRIO)
+
+/**
+ * UDP Echo statistics
+ *
+ * Each instance has a single writer (the thread running the client or
+ * server loop). Other threads must read it through
+ * udp_echo_stats_snapshot(), which never blocks the writer.
+ */
 struct udp_echo_stats {
+	/** Sequence lock for consistent snapshots (see seqlock.h) */
+	atomic_t seq;
 	/** Total packets sent */
-	uint32_t packets_sent;
+	uint64_t packets_sent;
 	/** Total packets received */
-	uint32_t packets_received;
+	uint64_t packets_received;
 	/** Total bytes sent */
-	uint32_t bytes_sent;
+	uint64_t bytes_sent;
 	/** Total bytes received */
-	uint32_t bytes_received;
+	uint64_t bytes_received;
 	/** Packet loss count */
-	uint32_t packets_lost;
+	uint64_t packets_lost;
 	/** Minimum RTT in microseconds */
 	uint32_t rtt_min_us;
 	/** Maximum RTT in microseconds */
@@ -34,6 +56,77 @@ struct udp_echo_stats {
 	uint32_t rtt_avg_us;
 	/** Total RTT for averaging */
 	uint64_t rtt_total_us;
+	/** Replies that arrived after their request was counted lost */
+	uint32_t packets_late;
+	/** Replies that arrived out of sequence order */
+	uint32_t packets_reordered;
+	/** Replies received more than once */
+	uint32_t packets_duplicate;
+	/** Datagrams whose echo_proto header failed the CRC check */
+	uint32_t packets_corrupt;
+	/** Requests the server did not echo (peer table full or rate limited) */
+	uint32_t packets_dropped;
+	/** RFC 3550-style RTT jitter in microseconds */
+	uint32_t jitter_us;
+	/** Jitter estimator state (scaled by 16) */
+	uint32_t jitter_q4;
+	/** Previous RTT sample, for jitter */
+	uint32_t rtt_last_us;
+	/** RTT distribution, for percentiles */
+	struct rtt_histogram rtt_hist;
+};
+
+/** UDP Echo client parameters */
+struct udp_echo_client_params {
+	/** Size of packets to send */
+	size_t packet_size;
+	/** Interval between packets in milliseconds (if rate_pps is 0) */
+	uint32_t interval_ms;
+	/** Request rate in packets per second (0 = use interval_ms) */
+	uint32_t rate_pps;
+	/** Send pattern; the interval is the mean gap */
+	enum tx_sched_pattern pattern;
+	/** Requests per burst with TX_SCHED_BURST */
+	uint32_t burst;
+	/** Number of packets to send (0 = infinite) */
+	uint32_t count;
+	/** Maximum outstanding requests (1 = stop-and-wait) */
+	uint32_t window;
+};
+
+/** Throughput stream sender parameters */
+struct udp_stream_params {
+	/** Size of each datagram */
+	size_t packet_size;
+	/** Target rate in kbit/s (0 = as fast as possible) */
+	uint32_t rate_kbps;
+	/** Stream duration in milliseconds (0 = until stopped) */
+	uint32_t duration_ms;
+};
+
+/** Transport a throughput stream is received on */
+enum udp_stream_rx_src {
+	/** UDP echo port, socket server or zero-copy reflector */
+	UDP_STREAM_RX_UDP,
+	/** TCP echo server */
+	UDP_STREAM_RX_TCP,
+	UDP_STREAM_RX_SRC_COUNT,
+};
+
+/** Throughput stream receiver statistics */
+struct udp_stream_rx_stats {
+	/** Packets received */
+	uint32_t packets;
+	/** Bytes received */
+	uint64_t bytes;
+	/** Packets missing from the sequence */
+	uint32_t lost;
+	/** Packets received with a lower sequence than expected */
+	uint32_t out_of_order;
+	/** RFC 3550 interarrival jitter in microseconds */
+	uint32_t jitter_us;
+	/** Elapsed time in microseconds covered by these statistics */
+	uint64_t elapsed_us;
 };
 
 /**
@@ -81,6 +174,106 @@ int udp_send(int socket, struct sockaddr_in *server_addr,
 int udp_receive(int socket, char *buffer, size_t buffer_size,
 		struct sockaddr_in *client_addr);
 
+/**
+ * @brief Receive UDP packet with a high-resolution RX timestamp
+ *
+ * The timestamp uses the time_utils.h time base. With
+ * CONFIG_UDP_ECHO_SOCKET_TIMESTAMP the timestamp attached by the network
+ * stack is used when available, otherwise the time at which the datagram
+ * was dequeued from the socket.
+ *
+ * @param socket Socket descriptor
+ * @param buffer Buffer to store received data
+ * @param buffer_size Size of the buffer
+ * @param client_addr Pointer to store client address (can be NULL)
+ * @param flags Socket receive flags (e.g. ZSOCK_MSG_DONTWAIT)
+ * @param rx_time Output: RX timestamp (see time_utils_now())
+ * @return Number of bytes received on success, negative error code on failure
+ */
+int udp_receive_timestamped(int socket, char *buffer, size_t buffer_size,
+			    struct sockaddr_in *client_addr, int flags,
+			    uint64_t *rx_time);
+
+/**
+ * @brief Stop signal of an echo loop
+ *
+ * Besides the flag, an eventfd wakes a loop blocked in poll, so stopping
+ * does not wait for a receive timeout.
+ */
+struct udp_echo_stop {
+	/** Set when the loop should return */
+	volatile bool flag;
+	/** Wakeup eventfd, -1 if unavailable (the loops then poll) */
+	int efd;
+};
+
+/**
+ * @brief Create the wakeup eventfd of a stop signal
+ *
+ * Call once. Without an eventfd the loops fall back to waking up every
+ * receive timeout to check the flag.
+ *
+ * @param stop Stop signal
+ * @return 0 on success, negative error code on failure
+ */
+int udp_echo_stop_init(struct udp_echo_stop *stop);
+
+/**
+ * @brief Clear a stop signal before (re)starting a loop
+ *
+ * @param stop Stop signal
+ */
+void udp_echo_stop_reset(struct udp_echo_stop *stop);
+
+/**
+ * @brief Ask the loop to return and wake it up
+ *
+ * @param stop Stop signal
+ */
+void udp_echo_stop_request(struct udp_echo_stop *stop);
+
+/**
+ * @brief Datagram descriptor for the batch receive/send APIs
+ */
+struct udp_batch_msg {
+	/** Datagram buffer */
+	char *buf;
+	/** Capacity of @ref buf */
+	size_t size;
+	/** Datagram length (filled on receive, used on send) */
+	size_t len;
+	/** Peer address (source on receive, destination on send) */
+	struct sockaddr_in addr;
+};
+
+/**
+ * @brief Receive up to @p count queued datagrams in one call
+ *
+ * Blocks for the first datagram (subject to the socket receive timeout),
+ * then drains whatever else is already queued without blocking.
+ *
+ * @param socket Socket descriptor
+ * @param msgs Array of descriptors with buf and size set
+ * @param count Number of descriptors
+ * @return Number of datagrams received (> 0), -EAGAIN on timeout, or
+ *         negative error code on failure
+ */
+int udp_receive_batch(int socket, struct udp_batch_msg *msgs, size_t count);
+
+/**
+ * @brief Send @p count datagrams in one call
+ *
+ * Transient lack of network buffers is retried after yielding a tick so a
+ * burst of replies is not dropped at the first full queue.
+ *
+ * @param socket Socket descriptor
+ * @param msgs Array of descriptors with buf, len and addr set
+ * @param count Number of descriptors
+ * @return Number of datagrams sent, or negative error code if none could
+ *         be sent
+ */
+int udp_send_batch(int socket, const struct udp_batch_msg *msgs, size_t count);
+
 /**
  * @brief Send UDP packet and receive echo response (with RTT measurement)
  *
@@ -98,33 +291,187 @@ int udp_echo_ping(int socket, struct sockaddr_in *server_addr,
 		  char *recv_buffer, size_t recv_buffer_size,
 		  uint32_t *rtt_us);
 
+/**
+ * @brief Wait until the echo server answers a readiness probe
+ *
+ * Sends small probe datagrams every few tens of milliseconds until one is
+ * echoed back, so the client can start as soon as the server is up
+ * instead of after a fixed delay. If @p server_addr is the broadcast
+ * address, the probes also locate the server: @p server_addr is replaced
+ * with the address that answered.
+ *
+ * @param socket Client socket descriptor
+ * @param server_addr Server address (updated when broadcast)
+ * @param timeout_ms Upper bound for the wait
+ * @param stop Stop signal ending the wait early (can be NULL)
+ * @return 0 once the server answered, -ETIMEDOUT on timeout, -ECANCELED
+ *         if stopped, or negative error code on failure
+ */
+int udp_echo_wait_server_ready(int socket, struct sockaddr_in *server_addr,
+			       uint32_t timeout_ms, struct udp_echo_stop *stop);
+
 /**
  * @brief Run UDP echo server (blocks and loops back packets)
  *
  * @param socket Server socket descriptor
  * @param stats Pointer to statistics structure (can be NULL)
- * @param stop_flag Pointer to stop flag (set to true to stop server)
+ * @param stop Stop signal
  * @return 0 on success, negative error code on failure
  */
 int udp_echo_server_run(int socket, struct udp_echo_stats *stats,
-			volatile bool *stop_flag);
+			struct udp_echo_stop *stop);
+
+/** Maximum number of sockets served by udp_echo_server_run_multi() */
+#define UDP_ECHO_SERVER_MAX_SOCKETS 4
+
+/**
+ * @brief Run UDP echo server on several sockets from one thread
+ *
+ * Waits on all sockets with a single poll() and serves them in order,
+ * one receive batch per socket and wakeup, so a busy socket, such as a
+ * bulk stream, delays the ones before it by one batch at most. Every
+ * socket is served as in udp_echo_server_run() and counts into the same
+ * @p stats; the packets per port are logged when the server stops.
+ *
+ * @param sockets Server socket descriptors, most latency-sensitive first
+ * @param count Number of sockets, up to UDP_ECHO_SERVER_MAX_SOCKETS
+ * @param stats Pointer to statistics structure (can be NULL)
+ * @param stop Stop signal
+ * @return 0 on success, negative error code on failure
+ */
+int udp_echo_server_run_multi(const int *sockets, size_t count,
+			      struct udp_echo_stats *stats,
+			      struct udp_echo_stop *stop);
 
 /**
  * @brief Run UDP echo client (sends packets and measures RTT)
  *
+ * With a window of 1 the client waits for each reply before sending the
+ * next request. Larger windows keep up to @p params->window requests in
+ * flight and match replies to requests by their sequence number.
+ *
+ * Only one echo or stream client runs at a time.
+ *
  * @param socket Client socket descriptor
  * @param server_addr Server address structure
- * @param packet_size Size of packets to send
- * @param interval_ms Interval between packets in milliseconds
- * @param count Number of packets to send (0 = infinite)
+ * @param params Client parameters (packet size, interval, count, window)
  * @param stats Pointer to statistics structure (can be NULL)
- * @param stop_flag Pointer to stop flag (set to true to stop client)
- * @return 0 on success, negative error code on failure
+ * @param stop Stop signal
+ * @return 0 on success, -EBUSY if another client is running, or
+ *         negative error code on failure
  */
 int udp_echo_client_run(int socket, struct sockaddr_in *server_addr,
-			size_t packet_size, uint32_t interval_ms,
-			uint32_t count, struct udp_echo_stats *stats,
-			volatile bool *stop_flag);
+			const struct udp_echo_client_params *params,
+			struct udp_echo_stats *stats,
+			struct udp_echo_stop *stop);
+
+/**
+ * @brief Next packet size of a size sweep
+ *
+ * Doubles @p size, stopping once at the largest unfragmented payload.
+ *
+ * @param size Current size
+ * @param max_size Largest size of the sweep
+ * @return Next size, @p max_size at most
+ */
+size_t udp_echo_sweep_next_size(size_t size, size_t max_size);
+
+/**
+ * @brief Run the echo client over a range of packet sizes
+ *
+ * Runs CONFIG_UDP_ECHO_SWEEP_COUNT requests at each size, from
+ * CONFIG_UDP_ECHO_SWEEP_MIN_SIZE doubling up to
+ * CONFIG_UDP_ECHO_MAX_PACKET_SIZE (with a stop at the largest
+ * unfragmented payload), and logs replies, RTT and echo goodput per
+ * size. The other client parameters apply to every step. @p stats holds
+ * the results of the last size when it returns.
+ *
+ * @param socket Client socket descriptor
+ * @param server_addr Server address structure
+ * @param params Client parameters; size and count are overridden
+ * @param stats Statistics structure, reset for every size
+ * @param stop Stop signal
+ * @return 0 on success, negative error code on failure
+ */
+int udp_echo_sweep_run(int socket, struct sockaddr_in *server_addr,
+		       const struct udp_echo_client_params *params,
+		       struct udp_echo_stats *stats,
+		       struct udp_echo_stop *stop);
+
+/**
+ * @brief Run throughput stream sender (unidirectional, no echo)
+ *
+ * Sends stream packets at the requested rate, or as fast as the stack
+ * accepts them. The receiving echo server accounts for them instead of
+ * echoing, so the return path does not consume airtime.
+ *
+ * @param socket Client socket descriptor
+ * @param server_addr Server address structure
+ * @param params Stream parameters
+ * @param stats Pointer to statistics structure (can be NULL)
+ * @param stop Stop signal
+ * @return 0 on success, negative error code on failure
+ */
+int udp_stream_client_run(int socket, struct sockaddr_in *server_addr,
+			  const struct udp_stream_params *params,
+			  struct udp_echo_stats *stats,
+			  struct udp_echo_stop *stop);
+
+/**
+ * @brief Run latency probes alongside a bulk stream from one thread
+ *
+ * Sends echo requests on @p probe_socket as udp_echo_client_run() does
+ * and, after @p baseline_ms of probes alone, a throughput stream on
+ * @p bulk_socket as udp_stream_client_run() does, both paced from a
+ * single poll() loop. The run ends when the stream ends. The probe RTT
+ * distribution is logged separately for the baseline and the loaded
+ * phase, together with how much the stream inflated the median and
+ * the tail. @p stats covers the probes only.
+ *
+ * Only one echo or stream client runs at a time.
+ *
+ * @param probe_socket Client socket of the probes
+ * @param probe_addr Server address of the probes
+ * @param bulk_socket Client socket of the stream
+ * @param bulk_addr Server address of the stream
+ * @param probe Probe parameters (packet size, interval, window)
+ * @param bulk Stream parameters
+ * @param baseline_ms Time the probes run alone before the stream starts
+ * @param stats Pointer to probe statistics structure (can be NULL)
+ * @param stop Stop signal
+ * @return 0 on success, -EBUSY if another client is running, or
+ *         negative error code on failure
+ */
+int udp_echo_mixed_run(int probe_socket, struct sockaddr_in *probe_addr,
+		       int bulk_socket, struct sockaddr_in *bulk_addr,
+		       const struct udp_echo_client_params *probe,
+		       const struct udp_stream_params *bulk,
+		       uint32_t baseline_ms,
+		       struct udp_echo_stats *stats,
+		       struct udp_echo_stop *stop);
+
+/**
+ * @brief Account a throughput stream packet on the receiver
+ *
+ * Used by echo server implementations for datagrams whose header decoded
+ * as ECHO_PROTO_TYPE_STREAM. Stream packets are not echoed. Each source
+ * is accounted separately and must only be fed from one thread.
+ *
+ * @param src Transport the packet arrived on
+ * @param hdr Decoded datagram header
+ * @param len Total datagram length
+ */
+void udp_stream_rx_packet(enum udp_stream_rx_src src,
+			  const struct echo_proto_hdr *hdr, int len);
+
+/**
+ * @brief Get cumulative statistics of the last received stream
+ *
+ * @param src Transport the stream arrived on
+ * @param stats Output statistics
+ */
+void udp_stream_get_rx_stats(enum udp_stream_rx_src src,
+			     struct udp_stream_rx_stats *stats);
 
 /**
  * @brief Cleanup UDP client
@@ -143,6 +490,9 @@ void udp_server_cleanup(int socket);
 /**
  * @brief Print UDP echo statistics
  *
+ * Prints a snapshot, so it is safe to call while the statistics are
+ * being updated.
+ *
  * @param stats Pointer to statistics structure
  */
 void udp_echo_print_stats(const struct udp_echo_stats *stats);
@@ -154,6 +504,30 @@ void udp_echo_print_stats(const struct udp_echo_stats *stats);
  */
 void udp_echo_reset_stats(struct udp_echo_stats *stats);
 
+/**
+ * @brief Add an RTT sample to echo statistics
+ *
+ * Updates minimum, maximum, average, jitter and the histogram. Call
+ * inside a seqlock write section of @p stats, after counting the reply
+ * in packets_received.
+ *
+ * @param stats Statistics structure
+ * @param rtt_us Round-trip time in microseconds
+ */
+void udp_echo_stats_add_rtt(struct udp_echo_stats *stats, uint32_t rtt_us);
+
+/**
+ * @brief Take a consistent copy of UDP echo statistics
+ *
+ * Safe to call from any thread while the client or server loop is
+ * updating @p stats. Not callable from ISRs.
+ *
+ * @param stats Live statistics structure
+ * @param snapshot Output copy
+ */
+void udp_echo_stats_snapshot(const struct udp_echo_stats *stats,
+			     struct udp_echo_stats *snapshot);
+
 #ifdef __cplusplus
 }
 #endif
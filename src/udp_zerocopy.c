@@ -0,0 +1,315 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/net/net_context.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/sys/crc.h>
+#include <string.h>
+
+#include "udp_zerocopy.h"
+#include "seqlock.h"
+#include "peer_table.h"
+#include "mem_stats.h"
+#include "bringup_prof.h"
+
+LOG_MODULE_REGISTER(udp_zerocopy, CONFIG_LOG_DEFAULT_LEVEL);
+
+/* Payload bytes copied when a packet cannot be reflected in place */
+#define UDP_ZC_FALLBACK_SIZE (CONFIG_UDP_ECHO_MAX_PACKET_SIZE + 64)
+
+/* Read size when checking a full-payload CRC */
+#define UDP_ZC_CRC_CHUNK 64
+
+static struct net_context *zc_ctx;
+static struct udp_echo_stats *zc_stats;
+
+static void zc_stats_update(bool rx, size_t len)
+{
+	if (!zc_stats) {
+		return;
+	}
+
+	seqlock_write_begin(&zc_stats->seq);
+	if (rx) {
+		zc_stats->packets_received++;
+		zc_stats->bytes_received += len;
+	} else {
+		zc_stats->packets_sent++;
+		zc_stats->bytes_sent += len;
+	}
+	seqlock_write_end(&zc_stats->seq);
+}
+
+static void zc_stats_drop(void)
+{
+	if (!zc_stats) {
+		return;
+	}
+
+	seqlock_write_begin(&zc_stats->seq);
+	zc_stats->packets_dropped++;
+	seqlock_write_end(&zc_stats->seq);
+}
+
+/* The headers can only be rewritten if they point into the packet's
+ * first buffer; the stack hands out a stack copy for fragmented headers.
+ */
+static bool zc_headers_in_place(struct net_pkt *pkt,
+				const struct net_ipv4_hdr *ipv4,
+				const struct net_udp_hdr *udp)
+{
+	const struct net_buf *buf = pkt->buffer;
+	size_t ip_len = net_pkt_ip_hdr_len(pkt);
+
+	return buf && (const uint8_t *)ipv4 == buf->data &&
+	       (const uint8_t *)udp == buf->data + ip_len &&
+	       buf->len >= ip_len + sizeof(*udp);
+}
+
+static void zc_reflect_copy(struct net_context *context, struct net_pkt *pkt,
+			    const struct net_ipv4_hdr *ipv4,
+			    const struct net_udp_hdr *udp, size_t len)
+{
+	static uint8_t buffer[UDP_ZC_FALLBACK_SIZE];
+	struct sockaddr_in dst = {
+		.sin_family = AF_INET,
+		.sin_port = udp->src_port,
+	};
+	int ret;
+
+	memcpy(&dst.sin_addr, ipv4->src, sizeof(dst.sin_addr));
+	len = MIN(len, sizeof(buffer));
+
+	ret = net_pkt_read(pkt, buffer, len);
+	net_pkt_unref(pkt);
+	if (ret < 0) {
+		return;
+	}
+
+	ret = net_context_sendto(context, buffer, len, (struct sockaddr *)&dst,
+				 sizeof(dst), NULL, K_NO_WAIT, NULL);
+	if (ret < 0) {
+		if (ret == -ENOMEM || ret == -ENOBUFS) {
+			mem_stats_alloc_failed();
+		}
+		LOG_DBG("Zero-copy fallback send failed: %d", ret);
+		return;
+	}
+
+	zc_stats_update(false, len);
+	peer_table_tx(&dst.sin_addr, len);
+	bringup_prof_mark(BRINGUP_PROF_ECHO_REPLY);
+}
+
+/* Parse the payload header without moving the packet cursor. With
+ * ECHO_PROTO_FLAG_FULL_CRC the CRC covers the whole payload, which may span
+ * several fragments, so it is checked chunk by chunk.
+ */
+static int zc_parse(struct net_pkt *pkt, size_t len, struct echo_proto_hdr *hdr)
+{
+	uint8_t buf[MAX(UDP_ZC_CRC_CHUNK, ECHO_PROTO_HDR_LEN)];
+	struct net_pkt_cursor backup;
+	size_t left, chunk;
+	uint16_t crc;
+	int ret;
+
+	if (len < ECHO_PROTO_HDR_LEN) {
+		return -EINVAL;
+	}
+
+	net_pkt_cursor_backup(pkt, &backup);
+
+	ret = net_pkt_read(pkt, buf, ECHO_PROTO_HDR_LEN);
+	if (ret < 0) {
+		goto out;
+	}
+
+	/* Only the header is in buf, so a full-payload CRC fails here even
+	 * on an intact datagram; the decoded fields are valid regardless.
+	 */
+	ret = echo_proto_parse(buf, ECHO_PROTO_HDR_LEN, hdr);
+	if (ret != -EBADMSG || !(hdr->flags & ECHO_PROTO_FLAG_FULL_CRC) ||
+	    len == ECHO_PROTO_HDR_LEN) {
+		goto out;
+	}
+
+	crc = echo_proto_crc_begin(buf);
+	for (left = len - ECHO_PROTO_HDR_LEN; left > 0; left -= chunk) {
+		chunk = MIN(left, sizeof(buf));
+		ret = net_pkt_read(pkt, buf, chunk);
+		if (ret < 0) {
+			goto out;
+		}
+		crc = crc16_ccitt(crc, buf, chunk);
+	}
+
+	ret = crc == hdr->crc ? 0 : -EBADMSG;
+
+out:
+	net_pkt_cursor_restore(pkt, &backup);
+	return ret;
+}
+
+static void zc_recv_cb(struct net_context *context, struct net_pkt *pkt,
+		       union net_ip_header *ip_hdr,
+		       union net_proto_header *proto_hdr,
+		       int status, void *user_data)
+{
+	struct net_ipv4_hdr *ipv4;
+	struct net_udp_hdr *udp;
+	struct echo_proto_hdr hdr;
+	struct net_linkaddr *src_mac;
+	struct in_addr peer;
+	uint8_t tmp[sizeof(ipv4->src)];
+	uint16_t port;
+	size_t len;
+	int ret;
+
+	ARG_UNUSED(user_data);
+
+	if (!pkt) {
+		return;
+	}
+
+	if (status < 0 || net_pkt_family(pkt) != AF_INET) {
+		net_pkt_unref(pkt);
+		return;
+	}
+
+	ipv4 = ip_hdr->ipv4;
+	udp = proto_hdr->udp;
+	len = net_pkt_remaining_data(pkt);
+
+	zc_stats_update(true, len);
+
+	/* Parse the payload header to divert throughput stream packets */
+	ret = zc_parse(pkt, len, &hdr);
+	if (ret == 0 && hdr.type == ECHO_PROTO_TYPE_STREAM) {
+		udp_stream_rx_packet(UDP_STREAM_RX_UDP, &hdr, len);
+		net_pkt_unref(pkt);
+		return;
+	}
+
+	/* The link-layer source is still set on RX; bind it to the entry */
+	memcpy(&peer, ipv4->src, sizeof(peer));
+	src_mac = net_pkt_lladdr_src(pkt);
+	if (peer_table_rx(&peer,
+			  src_mac->len == WIFI_MAC_ADDR_LEN ? src_mac->addr : NULL,
+			  len, ret == -EBADMSG) < 0) {
+		zc_stats_drop();
+		net_pkt_unref(pkt);
+		return;
+	}
+
+	/* Broadcast requests (link-local server discovery) need a unicast
+	 * source address in the reply, which the copy path picks.
+	 */
+	if (!zc_headers_in_place(pkt, ipv4, udp) ||
+	    net_ipv4_is_addr_bcast(net_pkt_iface(pkt), (struct in_addr *)ipv4->dst) ||
+	    net_ipv4_is_addr_mcast((struct in_addr *)ipv4->dst)) {
+		zc_reflect_copy(context, pkt, ipv4, udp, len);
+		return;
+	}
+
+	/* Swapping source and destination leaves both the IPv4 header
+	 * checksum and the UDP pseudo-header checksum unchanged.
+	 */
+	memcpy(tmp, ipv4->src, sizeof(tmp));
+	memcpy(ipv4->src, ipv4->dst, sizeof(tmp));
+	memcpy(ipv4->dst, tmp, sizeof(tmp));
+
+	port = udp->src_port;
+	udp->src_port = udp->dst_port;
+	udp->dst_port = port;
+
+	/* Let L2 resolve the link addresses again for the TX direction */
+	net_pkt_lladdr_clear(pkt);
+	net_pkt_cursor_init(pkt);
+
+	ret = net_send_data(pkt);
+	if (ret < 0) {
+		if (ret == -ENOMEM || ret == -ENOBUFS) {
+			mem_stats_alloc_failed();
+		}
+		LOG_DBG("Zero-copy reflect failed: %d", ret);
+		net_pkt_unref(pkt);
+		return;
+	}
+
+	zc_stats_update(false, len);
+	peer_table_tx(&peer, len);
+	bringup_prof_mark(BRINGUP_PROF_ECHO_REPLY);
+}
+
+int udp_echo_zc_start(uint16_t port, struct udp_echo_stats *stats)
+{
+	struct sockaddr_in addr;
+	int ret;
+
+	if (zc_ctx) {
+		return -EALREADY;
+	}
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons(port);
+
+	ret = net_context_get(AF_INET, SOCK_DGRAM, IPPROTO_UDP, &zc_ctx);
+	if (ret < 0) {
+		LOG_ERR("Failed to get net_context: %d", ret);
+		zc_ctx = NULL;
+		return ret;
+	}
+
+	ret = net_context_bind(zc_ctx, (struct sockaddr *)&addr, sizeof(addr));
+	if (ret < 0) {
+		LOG_ERR("Failed to bind net_context: %d", ret);
+		goto fail;
+	}
+
+	zc_stats = stats;
+
+	ret = net_context_recv(zc_ctx, zc_recv_cb, K_NO_WAIT, NULL);
+	if (ret < 0) {
+		LOG_ERR("Failed to register receive callback: %d", ret);
+		goto fail;
+	}
+
+	LOG_INF("Zero-copy UDP echo reflector started on port %d", port);
+	return 0;
+
+fail:
+	net_context_put(zc_ctx);
+	zc_ctx = NULL;
+	zc_stats = NULL;
+	return ret;
+}
+
+void udp_echo_zc_stop(void)
+{
+	if (!zc_ctx) {
+		return;
+	}
+
+	/* The callback runs with the context lock held, which this takes
+	 * too: once it returns, no callback still uses zc_stats.
+	 */
+	(void)net_context_recv(zc_ctx, NULL, K_NO_WAIT, NULL);
+	zc_stats = NULL;
+	net_context_put(zc_ctx);
+	zc_ctx = NULL;
+
+	LOG_INF("Zero-copy UDP echo reflector stopped");
+}
+
+bool udp_echo_zc_running(void)
+{
+	return zc_ctx != NULL;
+}
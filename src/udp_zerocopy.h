@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2026 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef UDP_ZEROCOPY_H_
+#define UDP_ZEROCOPY_H_
+
+#include <zephyr/kernel.h>
+
+#include "udp_utils.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Start the zero-copy UDP echo reflector
+ *
+ * Binds a net_context to @p port and reflects each received datagram from
+ * the network RX thread by swapping the IPv4 addresses and UDP ports in
+ * the received net_pkt and sending the same buffers back. No socket,
+ * thread or payload copy is involved. Throughput stream packets are
+ * accounted and dropped, as in udp_echo_server_run().
+ *
+ * @param port Port number to listen on
+ * @param stats Pointer to statistics structure (can be NULL). Updated from
+ *              the network RX thread.
+ * @return 0 on success, negative error code on failure
+ */
+int udp_echo_zc_start(uint16_t port, struct udp_echo_stats *stats);
+
+/**
+ * @brief Stop the zero-copy UDP echo reflector
+ */
+void udp_echo_zc_stop(void);
+
+/**
+ * @brief Check whether the zero-copy reflector is bound
+ *
+ * @return true between udp_echo_zc_start() and udp_echo_zc_stop()
+ */
+bool udp_echo_zc_running(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UDP_ZEROCOPY_H_ */
@@ -15,6 +15,7 @@ LOG_MODULE_REGISTER(wifi_p2p_utils, CONFIG_LOG_DEFAULT_LEVEL);
 #include <stdio.h>
 
 #include "wifi_p2p_utils.h"
+#include "bringup_prof.h"
 
 /* Helper function to format MAC address as string */
 static inline char *format_mac_addr(const uint8_t *mac, char *buf, size_t buf_len)
@@ -36,10 +37,30 @@ static K_SEM_DEFINE(p2p_connect_sem, 0, 1);
 static K_SEM_DEFINE(p2p_group_formed_sem, 0, 1);
 static K_SEM_DEFINE(p2p_go_neg_request_sem, 0, 1);
 static K_SEM_DEFINE(p2p_ap_sta_connected_sem, 0, 1);
+static K_SEM_DEFINE(p2p_find_stopped_sem, 0, 1);
+
+/* Supplicant events that only newer network stacks forward to net_mgmt.
+ * Without them the corresponding waits run to their timeout, which is
+ * the fixed delay the application used before.
+ */
+#if defined(NET_EVENT_WIFI_P2P_GO_NEG_REQUEST)
+#define P2P_GO_NEG_REQUEST_EVENT NET_EVENT_WIFI_P2P_GO_NEG_REQUEST
+#else
+#define P2P_GO_NEG_REQUEST_EVENT 0
+#endif
+
+#if defined(NET_EVENT_WIFI_P2P_FIND_STOPPED)
+#define P2P_FIND_STOPPED_EVENT NET_EVENT_WIFI_P2P_FIND_STOPPED
+#else
+#define P2P_FIND_STOPPED_EVENT 0
+#endif
 
 /* User callback for P2P events */
 static wifi_p2p_event_cb_t user_event_cb;
 
+/* Role requested by wifi_p2p_group_reinvoke(), until aborted */
+static enum wifi_p2p_role reinvoked_role;
+
 /* State strings */
 static const char *const p2p_state_str[] = {
 	[WIFI_P2P_STATE_IDLE] = "IDLE",
@@ -74,6 +95,32 @@ const char *wifi_p2p_role_txt(enum wifi_p2p_role role)
 	return "UNKNOWN";
 }
 
+uint32_t wifi_p2p_channel_to_freq(uint8_t channel)
+{
+	if (channel == 14) {
+		return 2484;
+	}
+
+	return channel > 14 ? 5000 + 5 * channel : 2407 + 5 * channel;
+}
+
+uint8_t wifi_p2p_freq_to_channel(uint32_t freq)
+{
+	if (freq == 2484) {
+		return 14;
+	}
+
+	if (freq >= 2412 && freq <= 2472) {
+		return (freq - 2407) / 5;
+	}
+
+	if (freq >= 5180 && freq <= 5885) {
+		return (freq - 5000) / 5;
+	}
+
+	return 0;
+}
+
 static void notify_user_event(enum wifi_p2p_event event)
 {
 	if (user_event_cb) {
@@ -101,8 +148,10 @@ static void handle_p2p_device_found(struct net_mgmt_event_callback *cb)
 
 	/* Store peer MAC for connection */
 	memcpy(p2p_ctx.peer_mac, peer_info->mac, WIFI_MAC_ADDR_LEN);
+	p2p_ctx.found_peer = *peer_info;
 	p2p_ctx.peer_count++;
 	p2p_ctx.state = WIFI_P2P_STATE_FOUND;
+	bringup_prof_mark(BRINGUP_PROF_PEER_FOUND);
 
 	/* Signal that a peer was found */
 	k_sem_give(&p2p_find_sem);
@@ -132,6 +181,7 @@ static void handle_p2p_connect_result(struct net_mgmt_event_callback *cb)
 		p2p_ctx.state = WIFI_P2P_STATE_CONNECTED;
 		p2p_ctx.connected = true;
 		p2p_ctx.group_formed = true;
+		bringup_prof_mark(BRINGUP_PROF_GROUP_FORMED);
 
 		k_sem_give(&p2p_connect_sem);
 		k_sem_give(&p2p_group_formed_sem);
@@ -171,6 +221,7 @@ static void handle_ap_enable_result(struct net_mgmt_event_callback *cb)
 		p2p_ctx.group_formed = true;
 		p2p_ctx.state = WIFI_P2P_STATE_GROUP_FORMED;
 		p2p_ctx.connected = true;
+		bringup_prof_mark(BRINGUP_PROF_GROUP_FORMED);
 
 		/* CRITICAL: Bring interface up for L2 packet operations
 		 * This is needed for WPA supplicant to send EAPOL packets during WPS.
@@ -225,7 +276,10 @@ static void handle_ap_sta_connected(struct net_mgmt_event_callback *cb)
 		format_mac_addr(sta_info->mac, mac_string_buf, sizeof(mac_string_buf)));
 
 	p2p_ctx.connected = true;
+	p2p_ctx.client_count++;
+	bringup_prof_mark(BRINGUP_PROF_STA_CONNECTED);
 	memcpy(p2p_ctx.peer_mac, sta_info->mac, WIFI_MAC_ADDR_LEN);
+	memcpy(p2p_ctx.event_mac, sta_info->mac, WIFI_MAC_ADDR_LEN);
 
 	/* Notify user callback - a peer has joined our group */
 	notify_user_event(WIFI_P2P_EVENT_PEER_JOINED);
@@ -245,18 +299,39 @@ static void handle_ap_sta_disconnected(struct net_mgmt_event_callback *cb)
 	LOG_INF("  MAC: %s",
 		format_mac_addr(sta_info->mac, mac_string_buf, sizeof(mac_string_buf)));
 
-	if (memcmp(p2p_ctx.peer_mac, sta_info->mac, WIFI_MAC_ADDR_LEN) == 0) {
+	if (p2p_ctx.client_count > 0) {
+		p2p_ctx.client_count--;
+	}
+
+	/* The group stays up while other Clients remain associated */
+	if (p2p_ctx.client_count == 0) {
 		p2p_ctx.connected = false;
-		memset(p2p_ctx.peer_mac, 0, WIFI_MAC_ADDR_LEN);
+	}
 
-		/* Notify user callback */
-		notify_user_event(WIFI_P2P_EVENT_PEER_LEFT);
+	if (memcmp(p2p_ctx.peer_mac, sta_info->mac, WIFI_MAC_ADDR_LEN) == 0) {
+		memset(p2p_ctx.peer_mac, 0, WIFI_MAC_ADDR_LEN);
 	}
+
+	/* Notify user callback */
+	memcpy(p2p_ctx.event_mac, sta_info->mac, WIFI_MAC_ADDR_LEN);
+	notify_user_event(WIFI_P2P_EVENT_PEER_LEFT);
 }
 
 static void p2p_mgmt_event_handler(struct net_mgmt_event_callback *cb,
 				   uint64_t mgmt_event, struct net_if *iface)
 {
+	if (P2P_GO_NEG_REQUEST_EVENT && mgmt_event == P2P_GO_NEG_REQUEST_EVENT) {
+		LOG_INF("P2P GO negotiation request received");
+		k_sem_give(&p2p_go_neg_request_sem);
+		return;
+	}
+
+	if (P2P_FIND_STOPPED_EVENT && mgmt_event == P2P_FIND_STOPPED_EVENT) {
+		LOG_DBG("P2P-FIND-STOPPED");
+		k_sem_give(&p2p_find_stopped_sem);
+		return;
+	}
+
 	switch (mgmt_event) {
 	case NET_EVENT_WIFI_P2P_DEVICE_FOUND:
 		handle_p2p_device_found(cb);
@@ -293,6 +368,7 @@ int wifi_p2p_init(void)
 	k_sem_reset(&p2p_group_formed_sem);
 	k_sem_reset(&p2p_go_neg_request_sem);
 	k_sem_reset(&p2p_ap_sta_connected_sem);
+	k_sem_reset(&p2p_find_stopped_sem);
 
 	/* CRITICAL: Bring interface up early for P2P operations
 	 * This ensures the interface is ready for L2 packet operations
@@ -330,7 +406,9 @@ int wifi_p2p_init(void)
 				     NET_EVENT_WIFI_CONNECT_RESULT |
 				     NET_EVENT_WIFI_AP_ENABLE_RESULT |
 				     NET_EVENT_WIFI_AP_STA_CONNECTED |
-				     NET_EVENT_WIFI_AP_STA_DISCONNECTED);
+				     NET_EVENT_WIFI_AP_STA_DISCONNECTED |
+				     P2P_GO_NEG_REQUEST_EVENT |
+				     P2P_FIND_STOPPED_EVENT);
 
 	net_mgmt_add_event_callback(&p2p_mgmt_cb);
 
@@ -414,6 +492,33 @@ int wifi_p2p_wait_for_ap_sta_connected(uint32_t timeout_ms)
 	return 0;
 }
 
+int wifi_p2p_wait_for_go_neg_request(uint32_t timeout_ms)
+{
+	int ret;
+
+	LOG_DBG("Waiting for GO negotiation request...");
+
+	ret = k_sem_take(&p2p_go_neg_request_sem, K_MSEC(timeout_ms));
+	if (ret == -EAGAIN) {
+		return -ETIMEDOUT;
+	}
+
+	return 0;
+}
+
+int wifi_p2p_wait_for_find_stopped(uint32_t timeout_ms)
+{
+	int ret;
+
+	ret = k_sem_take(&p2p_find_stopped_sem, K_MSEC(timeout_ms));
+	if (ret == -EAGAIN) {
+		LOG_WRN("Timeout waiting for P2P-FIND-STOPPED");
+		return -ETIMEDOUT;
+	}
+
+	return 0;
+}
+
 int wifi_p2p_find(uint16_t timeout_sec)
 {
 	struct net_if *iface = net_if_get_first_wifi();
@@ -434,6 +539,12 @@ int wifi_p2p_find(uint16_t timeout_sec)
 	p2p_ctx.state = WIFI_P2P_STATE_FINDING;
 	p2p_ctx.peer_count = 0;
 
+	/* Drop events left over from a previous attempt */
+	k_sem_reset(&p2p_find_sem);
+	k_sem_reset(&p2p_find_stopped_sem);
+	k_sem_reset(&p2p_go_neg_request_sem);
+
+	bringup_prof_mark(BRINGUP_PROF_FIND);
 	ret = net_mgmt(NET_REQUEST_WIFI_P2P_OPER, iface, &params, sizeof(params));
 	if (ret) {
 		LOG_ERR("P2P find failed: %d", ret);
@@ -467,10 +578,18 @@ int wifi_p2p_stop_find(void)
 
 	p2p_ctx.state = WIFI_P2P_STATE_IDLE;
 
+	/* The supplicant handles P2P_STOP_FIND synchronously, so discovery
+	 * has stopped once the request returns.
+	 */
+	if (!P2P_FIND_STOPPED_EVENT) {
+		k_sem_give(&p2p_find_stopped_sem);
+	}
+
 	return 0;
 }
 
-int wifi_p2p_connect(const uint8_t *peer_mac, uint8_t go_intent, uint32_t freq)
+static int p2p_connect_peer(const uint8_t *peer_mac, uint8_t go_intent,
+			    uint32_t freq, bool join)
 {
 	struct net_if *iface = net_if_get_first_wifi();
 	struct wifi_p2p_params params = {0};
@@ -501,13 +620,14 @@ int wifi_p2p_connect(const uint8_t *peer_mac, uint8_t go_intent, uint32_t freq)
 
 	params.connect.go_intent = go_intent;
 	params.connect.freq = freq;
+	params.connect.join = join;
 
 	p2p_ctx.go_intent = go_intent;
 	p2p_ctx.frequency = freq;
 
 	char mac_string_buf[sizeof("xx:xx:xx:xx:xx:xx")];
 
-	LOG_INF("Connecting to P2P peer:");
+	LOG_INF("%s P2P peer:", join ? "Joining group of" : "Connecting to");
 	LOG_INF("  MAC: %s",
 		format_mac_addr(peer_mac, mac_string_buf, sizeof(mac_string_buf)));
 	LOG_INF("  GO Intent: %d", go_intent);
@@ -516,6 +636,7 @@ int wifi_p2p_connect(const uint8_t *peer_mac, uint8_t go_intent, uint32_t freq)
 
 	p2p_ctx.state = WIFI_P2P_STATE_CONNECTING;
 
+	bringup_prof_mark(BRINGUP_PROF_CONNECT);
 	ret = net_mgmt(NET_REQUEST_WIFI_P2P_OPER, iface, &params, sizeof(params));
 	if (ret) {
 		LOG_ERR("P2P connect failed: %d", ret);
@@ -524,7 +645,10 @@ int wifi_p2p_connect(const uint8_t *peer_mac, uint8_t go_intent, uint32_t freq)
 	}
 
 	/* Determine role based on GO intent */
-	if (go_intent == 15) {
+	if (join) {
+		p2p_ctx.role = WIFI_P2P_ROLE_CLI;
+		LOG_INF("Device will join as Client");
+	} else if (go_intent == 15) {
 		p2p_ctx.role = WIFI_P2P_ROLE_GO;
 		LOG_INF("Device will act as Group Owner (GO)");
 	} else if (go_intent == 0) {
@@ -537,6 +661,17 @@ int wifi_p2p_connect(const uint8_t *peer_mac, uint8_t go_intent, uint32_t freq)
 	return 0;
 }
 
+int wifi_p2p_connect(const uint8_t *peer_mac, uint8_t go_intent, uint32_t freq)
+{
+	return p2p_connect_peer(peer_mac, go_intent, freq, false);
+}
+
+int wifi_p2p_join(const uint8_t *go_mac)
+{
+	/* The running group fixes the channel, nothing to negotiate */
+	return p2p_connect_peer(go_mac, 0, 0, true);
+}
+
 int wifi_p2p_group_add(uint32_t freq)
 {
 	struct net_if *iface = net_if_get_first_wifi();
@@ -554,9 +689,14 @@ int wifi_p2p_group_add(uint32_t freq)
 
 	LOG_INF("Creating P2P group as GO (freq: %d MHz)...", freq);
 
+	k_sem_reset(&p2p_group_formed_sem);
+	p2p_ctx.state = WIFI_P2P_STATE_CONNECTING;
+
+	bringup_prof_mark(BRINGUP_PROF_CONNECT);
 	ret = net_mgmt(NET_REQUEST_WIFI_P2P_OPER, iface, &params, sizeof(params));
 	if (ret) {
 		LOG_ERR("P2P group add failed: %d", ret);
+		p2p_ctx.state = WIFI_P2P_STATE_ERROR;
 		return ret;
 	}
 
@@ -566,6 +706,121 @@ int wifi_p2p_group_add(uint32_t freq)
 	return 0;
 }
 
+int wifi_p2p_wps_pbc(void)
+{
+	struct net_if *iface = net_if_get_first_wifi();
+	struct wifi_wps_config_params params = {0};
+	int ret;
+
+	if (!iface) {
+		LOG_ERR("No Wi-Fi interface found");
+		return -ENODEV;
+	}
+
+	params.oper = WIFI_WPS_PBC;
+
+	ret = net_mgmt(NET_REQUEST_WIFI_AP_WPS_CONFIG, iface, &params, sizeof(params));
+	if (ret) {
+		LOG_ERR("Failed to start WPS PBC: %d", ret);
+		return ret;
+	}
+
+	LOG_INF("WPS push button active, Clients can join now");
+
+	return 0;
+}
+
+int wifi_p2p_group_reinvoke(enum wifi_p2p_role role, const char *ssid,
+			    const char *psk, uint8_t channel)
+{
+	struct net_if *iface = net_if_get_first_wifi();
+	struct wifi_connect_req_params params = {0};
+	int ret;
+
+	if (!iface) {
+		LOG_ERR("No Wi-Fi interface found");
+		return -ENODEV;
+	}
+
+	if (!ssid || !psk || (role != WIFI_P2P_ROLE_GO && role != WIFI_P2P_ROLE_CLI)) {
+		return -EINVAL;
+	}
+
+	params.ssid = (const uint8_t *)ssid;
+	params.ssid_length = strlen(ssid);
+	params.psk = (const uint8_t *)psk;
+	params.psk_length = strlen(psk);
+	params.security = WIFI_SECURITY_TYPE_PSK;
+	params.band = channel > 14 ? WIFI_FREQ_BAND_5_GHZ : WIFI_FREQ_BAND_2_4_GHZ;
+	params.channel = channel;
+	params.mfp = WIFI_MFP_OPTIONAL;
+	params.timeout = SYS_FOREVER_MS;
+
+	LOG_INF("Reinvoking persistent group as %s (SSID: %s, channel: %d)",
+		wifi_p2p_role_txt(role), ssid, channel);
+
+	k_sem_reset(&p2p_group_formed_sem);
+	k_sem_reset(&p2p_ap_sta_connected_sem);
+
+	p2p_ctx.group_formed = false;
+	p2p_ctx.connected = false;
+	p2p_ctx.client_count = 0;
+	p2p_ctx.frequency = wifi_p2p_channel_to_freq(channel);
+	p2p_ctx.state = WIFI_P2P_STATE_CONNECTING;
+
+	/* The GO role is set by AP_ENABLE_RESULT and the CLI role by
+	 * CONNECT_RESULT, exactly as after a negotiated connection.
+	 */
+	p2p_ctx.role = WIFI_P2P_ROLE_UNDETERMINED;
+	reinvoked_role = role;
+
+	bringup_prof_mark(BRINGUP_PROF_CONNECT);
+	ret = net_mgmt(role == WIFI_P2P_ROLE_GO ? NET_REQUEST_WIFI_AP_ENABLE :
+						  NET_REQUEST_WIFI_CONNECT,
+		       iface, &params, sizeof(params));
+	if (ret) {
+		LOG_ERR("Persistent group reinvoke failed: %d", ret);
+		p2p_ctx.state = WIFI_P2P_STATE_ERROR;
+		reinvoked_role = WIFI_P2P_ROLE_UNDETERMINED;
+		return ret;
+	}
+
+	return 0;
+}
+
+int wifi_p2p_group_reinvoke_abort(void)
+{
+	struct net_if *iface = net_if_get_first_wifi();
+	enum wifi_p2p_role role = reinvoked_role;
+	int ret;
+
+	if (!iface) {
+		LOG_ERR("No Wi-Fi interface found");
+		return -ENODEV;
+	}
+
+	if (role == WIFI_P2P_ROLE_UNDETERMINED) {
+		return 0;
+	}
+
+	reinvoked_role = WIFI_P2P_ROLE_UNDETERMINED;
+
+	ret = net_mgmt(role == WIFI_P2P_ROLE_GO ? NET_REQUEST_WIFI_AP_DISABLE :
+						  NET_REQUEST_WIFI_DISCONNECT,
+		       iface, NULL, 0);
+	if (ret && ret != -EALREADY) {
+		LOG_WRN("Failed to leave persistent group: %d", ret);
+	}
+
+	p2p_ctx.group_formed = false;
+	p2p_ctx.connected = false;
+	p2p_ctx.client_count = 0;
+	p2p_ctx.role = WIFI_P2P_ROLE_UNDETERMINED;
+	p2p_ctx.state = WIFI_P2P_STATE_IDLE;
+
+	return ret;
+}
+
 int wifi_p2p_group_remove(void)
 {
 	struct net_if *iface = net_if_get_first_wifi();
@@ -590,6 +845,7 @@ int wifi_p2p_group_remove(void)
 
 	p2p_ctx.group_formed = false;
 	p2p_ctx.connected = false;
+	p2p_ctx.client_count = 0;
 	p2p_ctx.state = WIFI_P2P_STATE_IDLE;
 
 	return 0;
@@ -718,3 +974,71 @@ struct wifi_p2p_device_info *wifi_p2p_find_peer_by_mac(
 	LOG_WRN("No peer found matching MAC filter: %s", mac_filter);
 	return NULL;
 }
+
+int wifi_p2p_discover_peers(struct wifi_p2p_device_info *peers,
+			    uint16_t max_peers, uint16_t *peer_count,
+			    const char *mac_filter, int min_rssi,
+			    uint32_t timeout_ms)
+{
+	char mac_string_buf[sizeof("xx:xx:xx:xx:xx:xx")];
+	uint8_t filter_mac[WIFI_MAC_ADDR_LEN];
+	bool by_mac = mac_filter && mac_filter[0] != '\0';
+	int64_t start = k_uptime_get();
+	int64_t remaining;
+	int ret;
+
+	if (!peers || !peer_count) {
+		return -EINVAL;
+	}
+
+	if (by_mac && parse_mac_address(mac_filter, filter_mac) != 0) {
+		LOG_ERR("Invalid MAC address format: %s", mac_filter);
+		return -EINVAL;
+	}
+
+	*peer_count = 0;
+
+	if (!by_mac && min_rssi >= 0) {
+		/* No early-exit criterion, wait out the whole window */
+		k_sleep(K_MSEC(timeout_ms));
+		goto out;
+	}
+
+	while ((remaining = start + timeout_ms - k_uptime_get()) > 0) {
+		if (k_sem_take(&p2p_find_sem, K_MSEC(remaining)) != 0) {
+			break;
+		}
+
+		/* Several devices may have been reported since the last
+		 * wakeup, so re-read the full list rather than the event.
+		 */
+		if (wifi_p2p_get_peers(peers, max_peers, peer_count) < 0) {
+			continue;
+		}
+
+		for (int i = 0; i < *peer_count; i++) {
+			if (by_mac && memcmp(peers[i].mac, filter_mac,
+					     WIFI_MAC_ADDR_LEN) != 0) {
+				continue;
+			}
+
+			if (min_rssi < 0 && peers[i].rssi < min_rssi) {
+				continue;
+			}
+
+			LOG_INF("Target peer %s (%d dBm) found after %lld ms",
+				format_mac_addr(peers[i].mac, mac_string_buf,
+						sizeof(mac_string_buf)),
+				peers[i].rssi, k_uptime_get() - start);
+			return 0;
+		}
+	}
+
+out:
+	ret = wifi_p2p_get_peers(peers, max_peers, peer_count);
+	if (ret < 0) {
+		return ret;
+	}
+
+	return -ETIMEDOUT;
+}
@@ -64,6 +64,12 @@ struct wifi_p2p_context {
 	bool group_formed;
 	/** Connection established flag */
 	bool connected;
+	/** Peer reported by the last DEVICE_FOUND event */
+	struct wifi_p2p_device_info found_peer;
+	/** MAC address of the peer a PEER_JOINED/PEER_LEFT event refers to */
+	uint8_t event_mac[WIFI_MAC_ADDR_LEN];
+	/** Clients associated with our group (GO only) */
+	uint8_t client_count;
 };
 
 /**
@@ -121,6 +127,48 @@ int wifi_p2p_wait_for_connection(uint32_t timeout_ms);
  */
 int wifi_p2p_wait_for_ap_sta_connected(uint32_t timeout_ms);
 
+/**
+ * @brief Wait for the peer's GO negotiation request (event-driven)
+ *
+ * If the network stack does not report GO negotiation requests, this
+ * waits for the full timeout.
+ *
+ * @param timeout_ms Timeout in milliseconds
+ * @return 0 if the request was received, -ETIMEDOUT on timeout
+ */
+int wifi_p2p_wait_for_go_neg_request(uint32_t timeout_ms);
+
+/**
+ * @brief Wait until discovery has stopped after wifi_p2p_stop_find()
+ *
+ * @param timeout_ms Timeout in milliseconds
+ * @return 0 on success, -ETIMEDOUT on timeout
+ */
+int wifi_p2p_wait_for_find_stopped(uint32_t timeout_ms);
+
+/**
+ * @brief Collect discovered peers, returning early once the target appears
+ *
+ * Discovery must already be running (see wifi_p2p_find()). Each
+ * P2P-DEVICE-FOUND event refreshes the peer list, and the wait ends as
+ * soon as a peer matches @p mac_filter and @p min_rssi. Without any
+ * criterion the full @p timeout_ms is waited so the best peer can be
+ * chosen from everything that answered.
+ *
+ * @param peers Array to store the peer list
+ * @param max_peers Maximum number of peers to store
+ * @param peer_count Output: number of peers stored
+ * @param mac_filter Target MAC ("xx:xx:xx:xx:xx:xx"), empty for any peer
+ * @param min_rssi Minimum RSSI in dBm to accept a peer early, 0 to disable
+ * @param timeout_ms Upper bound for the discovery window
+ * @return 0 if a matching peer was found early, -ETIMEDOUT when the window
+ *         expired (@p peers holds the final list), or negative error code
+ */
+int wifi_p2p_discover_peers(struct wifi_p2p_device_info *peers,
+			    uint16_t max_peers, uint16_t *peer_count,
+			    const char *mac_filter, int min_rssi,
+			    uint32_t timeout_ms);
+
 /**
  * @brief Start P2P device discovery
  *
@@ -146,14 +194,62 @@ int wifi_p2p_stop_find(void);
  */
 int wifi_p2p_connect(const uint8_t *peer_mac, uint8_t go_intent, uint32_t freq);
 
+/**
+ * @brief Join the running group of a P2P Group Owner
+ *
+ * Provisions with the GO and joins its group as Client, without GO
+ * negotiation. Completion is reported like a normal connection, see
+ * wifi_p2p_wait_for_group_formation().
+ *
+ * @param go_mac P2P device address of the GO
+ * @return 0 on success, negative error code on failure
+ */
+int wifi_p2p_join(const uint8_t *go_mac);
+
 /**
  * @brief Create a P2P group as Group Owner
  *
+ * Starts an autonomous group. Completion is reported by
+ * wifi_p2p_wait_for_group_formation().
+ *
  * @param freq Operating frequency in MHz (0 = auto)
  * @return 0 on success, negative error code on failure
  */
 int wifi_p2p_group_add(uint32_t freq);
 
+/**
+ * @brief Accept the next push-button join on our group (GO only)
+ *
+ * Opens the WPS PBC walk time, so one Client can provision.
+ *
+ * @return 0 on success, negative error code on failure
+ */
+int wifi_p2p_wps_pbc(void);
+
+/**
+ * @brief Bring a previously formed group back up without negotiation
+ *
+ * As GO, starts the group with the given credentials; as CLI, joins it.
+ * GO negotiation, provisioning and WPS are skipped, only the 4-way
+ * handshake remains. Completion is reported like a normal connection,
+ * see wifi_p2p_wait_for_group_formation().
+ *
+ * @param role Role to take in the group (GO or CLI)
+ * @param ssid Group SSID
+ * @param psk Group passphrase
+ * @param channel Operating channel
+ * @return 0 on success, negative error code on failure
+ */
+int wifi_p2p_group_reinvoke(enum wifi_p2p_role role, const char *ssid,
+			    const char *psk, uint8_t channel);
+
+/**
+ * @brief Abort a group started with wifi_p2p_group_reinvoke()
+ *
+ * @return 0 on success, negative error code on failure
+ */
+int wifi_p2p_group_reinvoke_abort(void);
+
 /**
  * @brief Remove P2P group
  *
@@ -195,6 +291,22 @@ const char *wifi_p2p_state_txt(enum wifi_p2p_state state);
  */
 const char *wifi_p2p_role_txt(enum wifi_p2p_role role);
 
+/**
+ * @brief Convert a 2.4 or 5 GHz channel number to its center frequency
+ *
+ * @param channel Channel number
+ * @return Center frequency in MHz
+ */
+uint32_t wifi_p2p_channel_to_freq(uint8_t channel);
+
+/**
+ * @brief Convert a 2.4 or 5 GHz center frequency to its channel number
+ *
+ * @param freq Center frequency in MHz
+ * @return Channel number, or 0 if @p freq is not a 2.4/5 GHz channel
+ */
+uint8_t wifi_p2p_freq_to_channel(uint32_t freq);
+
 /**
  * @brief Print P2P status information
  */
@@ -0,0 +1,110 @@
+#
+# Copyright (c) 2026 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+#
+
+"""Host implementation of the datagram header in src/echo_proto.h."""
+
+import struct
+
+MAGIC = 0x5032
+VERSION = 1
+
+TYPE_ECHO = 1
+TYPE_STREAM = 2
+TYPE_PROBE = 3
+TYPE_GROUP = 4
+TYPE_REL_DATA = 5
+TYPE_REL_ACK = 6
+TYPE_REL_FEC = 7
+
+FLAG_END = 1 << 0
+FLAG_FULL_CRC = 1 << 1
+
+# magic, version, type, flags, crc, seq, tx_time (little-endian, packed)
+_HDR = struct.Struct("<HBBHHIQ")
+HDR_LEN = _HDR.size
+_CRC_OFFSET = 6
+# A probe is followed by the sender's time_utils_hz(), 0 = unknown
+PROBE_LEN = HDR_LEN + 4
+
+
+class ProtoError(Exception):
+    """Datagram is not ours (too short, bad magic or version)."""
+
+
+class CrcError(ProtoError):
+    """Header, or payload with FLAG_FULL_CRC, failed the CRC check."""
+
+
+def crc16_ccitt(seed, data):
+    """Zephyr's crc16_ccitt(): reflected polynomial 0x8408, no final XOR."""
+    for byte in data:
+        e = (seed ^ byte) & 0xFF
+        f = (e ^ (e << 4)) & 0xFF
+        seed = ((seed >> 8) ^ (f << 8) ^ (f << 3) ^ (f >> 4)) & 0xFFFF
+    return seed
+
+
+def _crc(buf):
+    crc = crc16_ccitt(0xFFFF, buf[:_CRC_OFFSET])
+    crc = crc16_ccitt(crc, b"\x00\x00")
+    return crc16_ccitt(crc, buf[_CRC_OFFSET + 2:])
+
+
+class Header:
+    """Decoded header fields."""
+
+    __slots__ = ("type", "flags", "seq", "tx_time")
+
+    def __init__(self, type_, flags, seq, tx_time):
+        self.type = type_
+        self.flags = flags
+        self.seq = seq
+        self.tx_time = tx_time
+
+
+def write(buf, type_, flags, seq, tx_time):
+    """Write the header at the start of bytearray buf, as echo_proto_write().
+
+    With FLAG_FULL_CRC the CRC covers all of buf, so the payload must be
+    final before calling this.
+    """
+    _HDR.pack_into(buf, 0, MAGIC, VERSION, type_, flags, 0,
+                   seq & 0xFFFFFFFF, tx_time & 0xFFFFFFFFFFFFFFFF)
+    covered = buf if flags & FLAG_FULL_CRC else buf[:HDR_LEN]
+    struct.pack_into("<H", buf, _CRC_OFFSET, _crc(bytes(covered)))
+
+
+def parse(data):
+    """Validate and decode a datagram header, as echo_proto_parse()."""
+    if len(data) < HDR_LEN:
+        raise ProtoError("short datagram")
+    magic, version, type_, flags, crc, seq, tx_time = _HDR.unpack_from(data)
+    if magic != MAGIC or version != VERSION:
+        raise ProtoError("not an echo_proto datagram")
+    covered = data if flags & FLAG_FULL_CRC else data[:HDR_LEN]
+    if _crc(bytes(covered)) != crc:
+        raise CrcError("CRC mismatch")
+    return Header(type_, flags, seq, tx_time)
+
+
+def probe_rate(data):
+    """Timestamp rate (Hz) carried by a probe, 0 if it has none."""
+    if len(data) < PROBE_LEN:
+        return 0
+    return struct.unpack_from("<I", data, HDR_LEN)[0]
+
+
+def echo_payload(size):
+    """Padding of an echo request, as udp_echo_build_payload()."""
+    return bytes(ord("A") + (i % 26) for i in range(HDR_LEN, size))
+
+
+def percentile(sorted_values, permyriad):
+    """Nearest-rank percentile of a sorted list, permyriad = 9900 for p99."""
+    if not sorted_values:
+        return 0
+    rank = max(1, -(-len(sorted_values) * permyriad // 10000))
+    return sorted_values[min(rank, len(sorted_values)) - 1]
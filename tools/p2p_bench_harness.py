@@ -0,0 +1,345 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+#
+
+"""Regression harness for the `p2p bench` shell commands.
+
+  run      Drive the benchmarks of a connected Client over its shell UART
+           and store every result point, plus the connection bring-up
+           times logged by CONFIG_P2P_BRINGUP_PROF, in a JSON file.
+  compare  Compare two result files, for example from two firmware
+           versions, and exit with status 1 if RTT percentiles, loss,
+           throughput or bring-up time regressed past the thresholds.
+
+`compare` also reads the raw result lines of `p2p bench` (CSV or JSON,
+e.g. a saved console log) and of `p2p_echo_peer.py --format json`.
+"""
+
+import argparse
+import csv
+import datetime
+import io
+import json
+import re
+import statistics
+import sys
+import time
+
+# Runs when no suite file is given: arguments after `p2p bench`
+DEFAULT_SUITE = (
+    "latency 64 200 20",
+    "latency 1024 200 20",
+    "window 16 256 500",
+    "sweep 20 1472 100 1",
+    "throughput 1024 0 5000",
+)
+
+ANSI_RE = re.compile(r"\x1b\[[0-9;?]*[A-Za-z]")
+BRINGUP_RE = re.compile(r"Bring-up profile \(([\w-]+)\): (\d+)\.(\d+) ms to first "
+                        r"echo reply")
+BRINGUP_FAIL_RE = re.compile(r"Bring-up profile \(([\w-]+)\): failed")
+CSV_HEADER = "test,size,window,sent,received,lost,"
+RESULT_TESTS = ("latency", "throughput", "sweep", "window")
+DONE_MARKERS = ("Benchmark done",)
+FAIL_MARKERS = ("Benchmark stopped", "Benchmark failed", "Echo client busy",
+                "No echo server yet", "Benchmark already running", "Invalid ",
+                "command not found")
+
+
+def log(msg):
+    print(msg, file=sys.stderr, flush=True)
+
+
+def parse_result_line(line):
+    """Return a result point of a JSON or CSV bench line, else None."""
+    line = line.strip()
+    start = line.find('{"test"')
+    if start >= 0:
+        try:
+            return json.loads(line[start:])
+        except ValueError:
+            return None
+    fields = line.split(",")
+    if len(fields) == 14 and fields[0] in RESULT_TESTS:
+        point = dict(zip(CSV_HEADER.rstrip(",").split(",") +
+                         ["rtt_min_us", "rtt_avg_us", "rtt_p50_us",
+                          "rtt_p99_us", "rtt_max_us", "jitter_us", "kbps",
+                          "elapsed_ms"], fields))
+        for k, v in point.items():
+            if k != "test":
+                try:
+                    point[k] = int(v)
+                except ValueError:
+                    return None
+        return point
+    return None
+
+
+class Console:
+    """Line-oriented access to the device shell over a serial port."""
+
+    def __init__(self, port, baud, logfile):
+        try:
+            import serial
+        except ImportError:
+            sys.exit("pyserial is required: pip install pyserial")
+        self.ser = serial.Serial(port, baud, timeout=0.2)
+        self.log = logfile
+        self.pending = b""
+        self.bringup = {}
+        self.bringup_failed = 0
+
+    def send(self, cmd):
+        self.ser.write(cmd.encode() + b"\n")
+
+    def lines(self, timeout):
+        """Yield console lines until timeout seconds have passed."""
+        deadline = time.monotonic() + timeout
+        while time.monotonic() < deadline:
+            self.pending += self.ser.read(4096)
+            while b"\n" in self.pending:
+                raw, self.pending = self.pending.split(b"\n", 1)
+                line = ANSI_RE.sub("", raw.decode(errors="replace")).strip("\r")
+                if self.log:
+                    self.log.write(line + "\n")
+                self._watch(line)
+                yield line
+
+    def _watch(self, line):
+        """Collect bring-up times whenever they show up on the console."""
+        m = BRINGUP_RE.search(line)
+        if m:
+            ms = int(m.group(2)) + int(m.group(3)) / 1000
+            self.bringup.setdefault(m.group(1), []).append(ms)
+            log("Bring-up (%s): %.3f ms" % (m.group(1), ms))
+        elif BRINGUP_FAIL_RE.search(line):
+            self.bringup_failed += 1
+            log("Bring-up failed: %s" % line)
+
+    def wait_for(self, pattern, timeout):
+        regex = re.compile(pattern)
+        for line in self.lines(timeout):
+            if regex.search(line):
+                return line
+        return None
+
+
+def load_suite(path):
+    if not path:
+        return list(DEFAULT_SUITE)
+    with open(path) as f:
+        return [ln.split("#", 1)[0].strip() for ln in f
+                if ln.split("#", 1)[0].strip()]
+
+
+def cmd_run(args):
+    logfile = open(args.log, "w") if args.log else None
+    con = Console(args.port, args.baud, logfile)
+    points = []
+    failures = []
+
+    for i in range(args.reboots):
+        log("Reboot %d/%d" % (i + 1, args.reboots))
+        con.send("kernel reboot cold")
+        if not con.wait_for(BRINGUP_RE.pattern + "|" + BRINGUP_FAIL_RE.pattern,
+                            args.setup_timeout):
+            # The Client only reconnects by itself with CONFIG_P2P_AUTO_START
+            log("No bring-up within %d s" % args.setup_timeout)
+            failures.append({"cmd": "reboot %d" % (i + 1),
+                             "error": "no bring-up within %d s" %
+                                      args.setup_timeout})
+    if args.reboots == 0 and args.setup_timeout:
+        log("Waiting up to %d s for a connection" % args.setup_timeout)
+        con.wait_for(BRINGUP_RE.pattern, args.setup_timeout)
+    if args.settle:
+        # Let the echo session started at connection finish
+        for _ in con.lines(args.settle):
+            pass
+
+    con.send("")
+    con.send("p2p bench format json")
+    for _ in con.lines(1):
+        pass
+
+    for bench in load_suite(args.suite):
+        cmd = "p2p bench " + bench
+        log("> " + cmd)
+        con.send(cmd)
+        outcome = None
+        for line in con.lines(args.bench_timeout):
+            point = parse_result_line(line)
+            if point:
+                point["cmd"] = bench
+                points.append(point)
+                log("  %s" % json.dumps(point))
+            elif any(m in line for m in DONE_MARKERS):
+                outcome = "done"
+                break
+            elif any(m in line for m in FAIL_MARKERS):
+                outcome = line
+                break
+        if outcome != "done":
+            outcome = outcome or "timeout after %d s" % args.bench_timeout
+            log("  failed: %s" % outcome)
+            failures.append({"cmd": bench, "error": outcome})
+            con.send("p2p bench stop")
+            for _ in con.lines(2):
+                pass
+
+    result = {
+        "label": args.label,
+        "date": datetime.datetime.now().isoformat(timespec="seconds"),
+        "points": points,
+        "bringup_ms": con.bringup,
+        "bringup_failed": con.bringup_failed,
+        "failures": failures,
+    }
+    with open(args.out, "w") as f:
+        json.dump(result, f, indent=1)
+    log("%d points, %d failed benchmarks written to %s" %
+        (len(points), len(failures), args.out))
+    if logfile:
+        logfile.close()
+    return 1 if failures else 0
+
+
+def load_results(path):
+    """Read a harness result file, or raw bench/peer result lines."""
+    with open(path) as f:
+        text = f.read()
+    try:
+        data = json.loads(text)
+        if isinstance(data, dict) and "points" in data:
+            return data
+    except ValueError:
+        pass
+
+    points = []
+    for line in io.StringIO(text):
+        point = parse_result_line(line)
+        if point:
+            points.append(point)
+    if not points and text.startswith(CSV_HEADER):
+        points = [parse_result_line(",".join(row.values()))
+                  for row in csv.DictReader(io.StringIO(text))]
+    return {"label": path, "points": points, "bringup_ms": {}}
+
+
+def point_key(p):
+    return (p["test"], int(p["size"]), int(p["window"]))
+
+
+def loss_pct(p):
+    sent = int(p["sent"])
+    return 100.0 * int(p["lost"]) / sent if sent else 0.0
+
+
+def cmd_compare(args):
+    base = load_results(args.baseline)
+    cur = load_results(args.current)
+    # A later point with the same key (a repeated run) replaces the earlier
+    base_pts = {point_key(p): p for p in base["points"]}
+    cur_pts = {point_key(p): p for p in cur["points"]}
+    regressions = []
+    rows = []
+
+    def check(name, key, old, new, worse, limit_pct, floor):
+        delta = new - old
+        pct = 100.0 * delta / old if old else 0.0
+        # limit_pct None: only the absolute floor applies
+        bad = (worse(delta) and abs(delta) > floor and
+               (limit_pct is None or abs(pct) > limit_pct))
+        rows.append((name, key, old, new, pct, "REGRESSION" if bad else ""))
+        if bad:
+            regressions.append((name, key))
+
+    higher = lambda d: d > 0  # noqa: E731
+    lower = lambda d: d < 0  # noqa: E731
+
+    for key in sorted(base_pts.keys() & cur_pts.keys()):
+        b, c = base_pts[key], cur_pts[key]
+        label = "%s/%d/w%d" % key
+        if key[0] != "throughput":
+            for field in ("rtt_p50_us", "rtt_p99_us"):
+                check(field, label, int(b[field]), int(c[field]), higher,
+                      args.rtt_pct, args.rtt_floor_us)
+            old_loss, new_loss = loss_pct(b), loss_pct(c)
+            check("loss_pct", label, old_loss, new_loss, higher, None,
+                  args.loss_points)
+        check("kbps", label, int(b["kbps"]), int(c["kbps"]), lower,
+              args.kbps_pct, 0)
+
+    for kind in sorted(base.get("bringup_ms", {}).keys() &
+                       cur.get("bringup_ms", {}).keys()):
+        check("bringup_ms", kind,
+              statistics.median(base["bringup_ms"][kind]),
+              statistics.median(cur["bringup_ms"][kind]), higher,
+              args.bringup_pct, args.bringup_floor_ms)
+
+    print("Baseline: %s (%s)" % (base.get("label"), base.get("date", "-")))
+    print("Current:  %s (%s)" % (cur.get("label"), cur.get("date", "-")))
+    print("%-11s %-22s %12s %12s %8s" % ("metric", "point", "baseline",
+                                         "current", "change"))
+    for name, key, old, new, pct, flag in rows:
+        print("%-11s %-22s %12.2f %12.2f %+7.1f%% %s" %
+              (name, key, old, new, pct, flag))
+
+    for key in sorted(base_pts.keys() - cur_pts.keys()):
+        print("missing in current: %s/%d/w%d" % key)
+    if cur.get("bringup_failed", 0) > base.get("bringup_failed", 0):
+        print("bring-up failures: %d -> %d" % (base.get("bringup_failed", 0),
+                                               cur["bringup_failed"]))
+        regressions.append(("bringup_failed", "-"))
+
+    print("%d regressions" % len(regressions))
+    return 1 if regressions else 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = parser.add_subparsers(dest="cmd", required=True)
+
+    run = sub.add_parser("run", help="run the benchmarks on a device")
+    run.add_argument("--port", required=True, help="Client shell UART, e.g. /dev/ttyACM1")
+    run.add_argument("--baud", type=int, default=115200)
+    run.add_argument("--suite", help="file with one `p2p bench` command per line "
+                                     "(without the prefix)")
+    run.add_argument("--out", required=True, help="result JSON file")
+    run.add_argument("--label", default="", help="firmware version or build")
+    run.add_argument("--log", help="save the console output")
+    run.add_argument("--reboots", type=int, default=0,
+                     help="reboot the Client this often first and record the "
+                          "bring-up time of each reconnection (needs "
+                          "CONFIG_P2P_AUTO_START)")
+    run.add_argument("--setup-timeout", type=int, default=120,
+                     help="wait for a connection (s, 0 = already connected)")
+    run.add_argument("--settle", type=int, default=0,
+                     help="wait time after connecting, for the echo session (s)")
+    run.add_argument("--bench-timeout", type=int, default=600)
+
+    cmp_ = sub.add_parser("compare", help="compare two result files")
+    cmp_.add_argument("baseline")
+    cmp_.add_argument("current")
+    cmp_.add_argument("--rtt-pct", type=float, default=10,
+                      help="allowed RTT p50/p99 increase (%%)")
+    cmp_.add_argument("--rtt-floor-us", type=float, default=200,
+                      help="RTT changes below this are noise (us)")
+    cmp_.add_argument("--loss-points", type=float, default=1.0,
+                      help="allowed loss increase (percentage points)")
+    cmp_.add_argument("--kbps-pct", type=float, default=10,
+                      help="allowed throughput decrease (%%)")
+    cmp_.add_argument("--bringup-pct", type=float, default=15,
+                      help="allowed median bring-up time increase (%%)")
+    cmp_.add_argument("--bringup-floor-ms", type=float, default=100,
+                      help="bring-up changes below this are noise (ms)")
+
+    args = parser.parse_args()
+    return cmd_run(args) if args.cmd == "run" else cmd_compare(args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
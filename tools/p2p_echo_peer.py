@@ -0,0 +1,590 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026 Nordic Semiconductor ASA
+#
+# SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+#
+
+"""Host echo and throughput peer for the P2P echo firmware.
+
+Speaks the binary protocol of src/echo_proto.h over UDP and, with the
+16-bit length prefix of src/tcp_utils.c, over TCP, so a Linux host in a
+P2P group (GO or Client) can stand in for either device:
+
+  server  Echo server: reflects echo requests and readiness probes, and
+          accounts throughput streams (goodput, loss, jitter) like the
+          GO's echo server.
+  client  Echo client: windowed requests at a fixed rate, RTT statistics
+          and percentiles, one result line in the `p2p bench` format.
+  stream  Throughput stream sender, ended with END markers so the
+          receiver logs its totals.
+"""
+
+import argparse
+import json
+import selectors
+import socket
+import struct
+import sys
+import time
+
+import echo_proto as proto
+
+UDP_ECHO_PORT = 5001
+TCP_ECHO_PORT = 5003
+BULK_PORT = 5004
+RECV_TIMEOUT_S = 2.0
+STREAM_END_MARKERS = 3
+MAX_DATAGRAM = 65535
+# Cycle rate of the default nRF54LM20 build (CONFIG_UDP_ECHO_TIMING_CYCLES),
+# used until the device reports its rate in a readiness probe
+DEFAULT_TICK_HZ = 1_000_000
+
+# Fields of a `p2p bench` result line (src/bench.c)
+RESULT_FIELDS = ("test", "size", "window", "sent", "received", "lost",
+                 "rtt_min_us", "rtt_avg_us", "rtt_p50_us", "rtt_p99_us",
+                 "rtt_max_us", "jitter_us", "kbps", "elapsed_ms")
+
+
+def log(msg):
+    print(msg, file=sys.stderr, flush=True)
+
+
+def device_time(tick_hz):
+    """Sender timestamp in the device time base (time_utils_now() units)."""
+    return time.monotonic_ns() * tick_hz // 1_000_000_000
+
+
+def fmt_ms(us):
+    return "%d.%03d ms" % (us // 1000, us % 1000)
+
+
+def print_result(result, fmt):
+    if fmt == "json":
+        print(json.dumps({k: result[k] for k in RESULT_FIELDS},
+                         separators=(",", ":")))
+    elif fmt == "csv":
+        print(",".join(RESULT_FIELDS))
+        print(",".join(str(result[k]) for k in RESULT_FIELDS))
+
+
+class StreamRx:
+    """Throughput stream receiver, as udp_stream_rx_packet()."""
+
+    def __init__(self, tick_hz, report_ms):
+        # An explicit --tick-hz wins over the rate the device reports
+        self.fixed = tick_hz is not None
+        self.tick_hz = tick_hz or DEFAULT_TICK_HZ
+        self.report_us = report_ms * 1000
+        self.active = False
+
+    def _reset(self, now_us, tx_us):
+        self.active = True
+        self.next_seq = 0
+        self.start_us = now_us
+        self.prev_transit = now_us - tx_us
+        self.jitter_q4 = 0
+        self.total = self._counters()
+        self.interval = self._counters()
+        self.interval_start_us = now_us
+        log("Throughput stream started")
+
+    def set_rate(self, tick_hz):
+        if tick_hz and not self.fixed and tick_hz != self.tick_hz:
+            log("Device time base: %d Hz" % tick_hz)
+            self.tick_hz = tick_hz
+
+    @staticmethod
+    def _counters():
+        return {"packets": 0, "bytes": 0, "lost": 0, "out_of_order": 0}
+
+    def _print(self, label, c, elapsed_us):
+        expected = c["packets"] + c["lost"]
+        kbps = c["bytes"] * 8 * 1000 // elapsed_us if elapsed_us else 0
+        jitter_us = self.jitter_q4 >> 4
+        log("%s %.3f s: %d bytes, %d kbit/s, lost %d/%d (%d%%), "
+            "out-of-order %d, jitter %s" %
+            (label, elapsed_us / 1e6, c["bytes"], kbps, c["lost"], expected,
+             c["lost"] * 100 // expected if expected else 0,
+             c["out_of_order"], fmt_ms(jitter_us)))
+
+    def packet(self, hdr, length):
+        now_us = time.monotonic_ns() // 1000
+        if hdr.flags & proto.FLAG_END:
+            if self.active:
+                self.active = False
+                self._print("Stream total", self.total,
+                            now_us - self.start_us)
+            return
+
+        tx_us = hdr.tx_time * 1_000_000 // self.tick_hz
+        if not self.active or hdr.seq == 0:
+            self._reset(now_us, tx_us)
+
+        for c in (self.total, self.interval):
+            if hdr.seq >= self.next_seq:
+                c["lost"] += hdr.seq - self.next_seq
+            else:
+                c["out_of_order"] += 1
+                c["lost"] = max(c["lost"] - 1, 0)
+            c["packets"] += 1
+            c["bytes"] += length
+        self.next_seq = max(self.next_seq, hdr.seq + 1)
+
+        # RFC 3550 interarrival jitter; the clock offset cancels out
+        transit = now_us - tx_us
+        delta = abs(transit - self.prev_transit)
+        self.prev_transit = transit
+        self.jitter_q4 += delta - ((self.jitter_q4 + 8) >> 4)
+
+        if now_us - self.interval_start_us >= self.report_us:
+            self._print("Stream interval", self.interval,
+                        now_us - self.interval_start_us)
+            self.interval = self._counters()
+            self.interval_start_us = now_us
+
+
+class EchoServer:
+    """Single-threaded UDP and TCP echo server."""
+
+    def __init__(self, args):
+        self.sel = selectors.DefaultSelector()
+        self.stream = StreamRx(args.tick_hz, args.report_ms)
+        self.counts = {}
+        self.warned = set()
+
+        for port in [args.port] + ([args.bulk_port] if args.bulk_port else []):
+            sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+            sock.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+            sock.bind((args.bind, port))
+            sock.setblocking(False)
+            self.sel.register(sock, selectors.EVENT_READ, self._udp_ready)
+            self.counts[("udp", port)] = 0
+            log("UDP echo server on %s:%d" % (args.bind, port))
+
+        if args.tcp_port:
+            lsock = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+            lsock.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+            lsock.bind((args.bind, args.tcp_port))
+            lsock.listen(1)
+            lsock.setblocking(False)
+            self.sel.register(lsock, selectors.EVENT_READ, self._tcp_accept)
+            self.counts[("tcp", args.tcp_port)] = 0
+            log("TCP echo server on %s:%d" % (args.bind, args.tcp_port))
+
+    def _warn_once(self, key, msg):
+        if key not in self.warned:
+            self.warned.add(key)
+            log(msg)
+
+    def _classify(self, data):
+        """Return the header of a stream packet, or None to echo."""
+        try:
+            hdr = proto.parse(data)
+        except proto.CrcError:
+            self._warn_once("crc", "Corrupt datagram(s) received, echoing")
+            return None, False
+        except proto.ProtoError:
+            return None, False
+
+        if hdr.type in (proto.TYPE_REL_DATA, proto.TYPE_REL_FEC,
+                        proto.TYPE_GROUP):
+            self._warn_once(hdr.type, "Datagram type %d not supported, "
+                            "dropped" % hdr.type)
+            return hdr, True
+        return hdr, hdr.type == proto.TYPE_STREAM
+
+    def _udp_ready(self, sock):
+        port = sock.getsockname()[1]
+        # One batch per wakeup, so a busy port does not starve the others
+        for _ in range(16):
+            try:
+                data, addr = sock.recvfrom(MAX_DATAGRAM)
+            except BlockingIOError:
+                return
+            self.counts[("udp", port)] += 1
+            hdr, consumed = self._classify(data)
+            if consumed:
+                if hdr.type == proto.TYPE_STREAM:
+                    self.stream.packet(hdr, len(data))
+                continue
+            if hdr and hdr.type == proto.TYPE_PROBE:
+                self.stream.set_rate(proto.probe_rate(data))
+            try:
+                sock.sendto(data, addr)
+            except OSError as e:
+                self._warn_once("send", "Echo send error: %s" % e)
+
+    def _tcp_accept(self, lsock):
+        conn, addr = lsock.accept()
+        conn.setblocking(False)
+        conn.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        self.sel.register(conn, selectors.EVENT_READ,
+                          lambda s, b=bytearray(): self._tcp_ready(s, b))
+        log("TCP client %s:%d connected" % addr)
+
+    def _tcp_ready(self, conn, buf):
+        try:
+            data = conn.recv(MAX_DATAGRAM)
+        except BlockingIOError:
+            return
+        except OSError:
+            data = b""
+        if not data:
+            log("TCP client disconnected")
+            self.sel.unregister(conn)
+            conn.close()
+            return
+
+        buf += data
+        while len(buf) >= 2:
+            (length,) = struct.unpack_from("<H", buf)
+            if len(buf) < 2 + length:
+                break
+            record = bytes(buf[2:2 + length])
+            del buf[:2 + length]
+            self.counts[("tcp", conn.getsockname()[1])] += 1
+            hdr, consumed = self._classify(record)
+            if consumed:
+                if hdr.type == proto.TYPE_STREAM:
+                    self.stream.packet(hdr, length)
+                continue
+            conn.setblocking(True)
+            conn.sendall(struct.pack("<H", length) + record)
+            conn.setblocking(False)
+
+    def run(self):
+        try:
+            while True:
+                for key, _ in self.sel.select():
+                    key.data(key.fileobj)
+        except KeyboardInterrupt:
+            pass
+        for (proto_name, port), count in self.counts.items():
+            log("%s port %d: %d packets" % (proto_name.upper(), port, count))
+
+
+class Transport:
+    """Datagram-style send/receive over UDP, or length-prefixed TCP."""
+
+    def __init__(self, host, port, tcp):
+        self.tcp = tcp
+        self.addr = (host, port)
+        if tcp:
+            self.sock = socket.create_connection(self.addr, timeout=5)
+            self.sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+            self.rxbuf = bytearray()
+            log("TCP connected to %s:%d" % self.addr)
+        else:
+            self.sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+        self.sock.setblocking(False)
+
+    def send(self, data):
+        if self.tcp:
+            self.sock.setblocking(True)
+            self.sock.sendall(struct.pack("<H", len(data)) + data)
+            self.sock.setblocking(False)
+            return True
+        try:
+            self.sock.sendto(data, self.addr)
+            return True
+        except (BlockingIOError, OSError):
+            return False
+
+    def recv_all(self):
+        """Return every datagram or record queued right now."""
+        out = []
+        while True:
+            try:
+                data = self.sock.recv(MAX_DATAGRAM)
+            except BlockingIOError:
+                break
+            if not self.tcp:
+                out.append(data)
+                continue
+            if not data:
+                raise ConnectionError("server closed the connection")
+            self.rxbuf += data
+        while self.tcp and len(self.rxbuf) >= 2:
+            (length,) = struct.unpack_from("<H", self.rxbuf)
+            if len(self.rxbuf) < 2 + length:
+                break
+            out.append(bytes(self.rxbuf[2:2 + length]))
+            del self.rxbuf[:2 + length]
+        return out
+
+    def wait(self, timeout):
+        sel = selectors.DefaultSelector()
+        sel.register(self.sock, selectors.EVENT_READ)
+        ready = sel.select(max(timeout, 0))
+        sel.close()
+        return bool(ready)
+
+
+def wait_server_ready(tr, timeout_ms):
+    """Probe until the server answers, as udp_echo_wait_server_ready().
+
+    Returns the rate the server reports for its timestamps (0 if none),
+    or None if it did not answer.
+    """
+    probe = bytearray(proto.PROBE_LEN)
+    deadline = time.monotonic() + timeout_ms / 1000
+    seq = 0
+    while time.monotonic() < deadline:
+        proto.write(probe, proto.TYPE_PROBE, 0, seq, 0)
+        tr.send(bytes(probe))
+        seq += 1
+        if tr.wait(0.05):
+            for data in tr.recv_all():
+                try:
+                    if proto.parse(data).type == proto.TYPE_PROBE:
+                        return proto.probe_rate(data)
+                except proto.ProtoError:
+                    pass
+    return None
+
+
+def cmd_client(args):
+    size = max(args.size, proto.HDR_LEN)
+    window = max(args.window, 1)
+    period = 1 / args.rate_pps if args.rate_pps else args.interval_ms / 1000
+    flags = proto.FLAG_FULL_CRC if args.full_crc else 0
+    tr = Transport(args.host, args.port, args.tcp)
+
+    if not args.tcp and args.wait_ready_ms:
+        if wait_server_ready(tr, args.wait_ready_ms) is not None:
+            log("Echo server ready")
+        else:
+            log("Echo server did not answer probe, starting anyway")
+
+    buf = bytearray(size)
+    buf[proto.HDR_LEN:] = proto.echo_payload(size)
+    pending = {}
+    answered = set()
+    rtts = []
+    st = dict(sent=0, received=0, lost=0, late=0, duplicate=0, corrupt=0,
+              reordered=0, bytes=0)
+    jitter_q4 = 0
+    last_rtt = None
+    highest = -1
+    seq = 0
+    start = time.monotonic()
+    next_tx = start
+
+    try:
+        while args.count == 0 or seq < args.count or pending:
+            now = time.monotonic()
+
+            # Expire requests whose reply did not arrive in time
+            for s, tx in list(pending.items()):
+                if now - tx >= RECV_TIMEOUT_S:
+                    del pending[s]
+                    st["lost"] += 1
+
+            if ((args.count == 0 or seq < args.count) and
+                    len(pending) < window and now >= next_tx):
+                proto.write(buf, proto.TYPE_ECHO, flags, seq,
+                            time.monotonic_ns())
+                if tr.send(bytes(buf)):
+                    pending[seq] = time.monotonic()
+                    st["sent"] += 1
+                seq += 1
+                next_tx += period
+                continue
+
+            timeout = RECV_TIMEOUT_S
+            if len(pending) < window and (args.count == 0 or seq < args.count):
+                timeout = next_tx - now
+            if pending:
+                timeout = min(timeout, min(pending.values()) +
+                              RECV_TIMEOUT_S - now)
+            if not tr.wait(timeout):
+                continue
+
+            rx = time.monotonic()
+            for data in tr.recv_all():
+                try:
+                    hdr = proto.parse(data)
+                except proto.CrcError:
+                    st["corrupt"] += 1
+                    continue
+                except proto.ProtoError:
+                    continue
+                if hdr.type != proto.TYPE_ECHO:
+                    continue
+                if hdr.seq in pending:
+                    rtt_us = int((rx - pending.pop(hdr.seq)) * 1e6)
+                    answered.add(hdr.seq)
+                    st["received"] += 1
+                    st["bytes"] += len(data)
+                    if hdr.seq < highest:
+                        st["reordered"] += 1
+                    highest = max(highest, hdr.seq)
+                    if last_rtt is not None:
+                        jitter_q4 += (abs(rtt_us - last_rtt) -
+                                      ((jitter_q4 + 8) >> 4))
+                    last_rtt = rtt_us
+                    rtts.append(rtt_us)
+                    if window == 1 and not args.quiet:
+                        log("Echo reply: seq=%d, bytes=%d, RTT=%s" %
+                            (hdr.seq, len(data), fmt_ms(rtt_us)))
+                elif hdr.seq in answered:
+                    st["duplicate"] += 1
+                else:
+                    st["late"] += 1
+    except KeyboardInterrupt:
+        st["lost"] += len(pending)
+
+    elapsed_us = int((time.monotonic() - start) * 1e6)
+    rtts.sort()
+    result = dict(test="latency" if window == 1 else "window", size=size,
+                  window=window, sent=st["sent"], received=st["received"],
+                  lost=st["lost"],
+                  rtt_min_us=rtts[0] if rtts else 0,
+                  rtt_avg_us=sum(rtts) // len(rtts) if rtts else 0,
+                  rtt_p50_us=proto.percentile(rtts, 5000),
+                  rtt_p99_us=proto.percentile(rtts, 9900),
+                  rtt_max_us=rtts[-1] if rtts else 0,
+                  jitter_us=jitter_q4 >> 4,
+                  kbps=st["bytes"] * 8 * 1000 // elapsed_us if elapsed_us else 0,
+                  elapsed_ms=elapsed_us // 1000)
+
+    log("=== Echo Statistics ===")
+    log("Packets sent:     %d" % st["sent"])
+    log("Packets received: %d" % st["received"])
+    log("Packets lost:     %d" % st["lost"])
+    log("Late / duplicate / reordered / corrupt: %d / %d / %d / %d" %
+        (st["late"], st["duplicate"], st["reordered"], st["corrupt"]))
+    if rtts:
+        log("RTT min/avg/max:  %s / %s / %s" %
+            (fmt_ms(result["rtt_min_us"]), fmt_ms(result["rtt_avg_us"]),
+             fmt_ms(result["rtt_max_us"])))
+        log("RTT p50/p90/p99/p99.9: %s / %s / %s / %s" %
+            tuple(fmt_ms(proto.percentile(rtts, p))
+                  for p in (5000, 9000, 9900, 9990)))
+        log("Jitter:           %s" % fmt_ms(result["jitter_us"]))
+    print_result(result, args.format)
+    return 0 if st["received"] else 1
+
+
+def cmd_stream(args):
+    size = max(args.size, proto.HDR_LEN)
+    period = size * 8 / (args.rate_kbps * 1000) if args.rate_kbps else 0
+    tr = Transport(args.host, args.port, args.tcp)
+    buf = bytearray(b"S" * size)
+    tick_hz = args.tick_hz
+
+    if not args.tcp and args.wait_ready_ms:
+        rate = wait_server_ready(tr, args.wait_ready_ms)
+        if rate is None:
+            log("Echo server did not answer probe, starting anyway")
+        elif rate and tick_hz is None:
+            log("Device time base: %d Hz" % rate)
+            tick_hz = rate
+    tick_hz = tick_hz or DEFAULT_TICK_HZ
+
+    sent = retries = total = 0
+    start = time.monotonic()
+    next_tx = start
+
+    try:
+        while (not args.duration_ms or
+               time.monotonic() - start < args.duration_ms / 1000):
+            delay = next_tx - time.monotonic()
+            if delay > 0:
+                time.sleep(delay)
+            # Header-only CRC: stream packets are not checked end to end
+            proto.write(buf, proto.TYPE_STREAM, 0, sent,
+                        device_time(tick_hz))
+            if not tr.send(bytes(buf)):
+                retries += 1
+                time.sleep(0.001)
+                continue
+            sent += 1
+            total += size
+            next_tx += period
+    except KeyboardInterrupt:
+        pass
+
+    # Tell the receiver to print its totals
+    end = bytearray(proto.HDR_LEN)
+    proto.write(end, proto.TYPE_STREAM, proto.FLAG_END, sent,
+                device_time(tick_hz))
+    for _ in range(1 if args.tcp else STREAM_END_MARKERS):
+        tr.send(bytes(end))
+
+    elapsed_us = max(int((time.monotonic() - start) * 1e6), 1)
+    kbps = total * 8 * 1000 // elapsed_us
+    log("Stream sent %d packets, %d bytes in %d ms (%d kbit/s), "
+        "%d send retries" % (sent, total, elapsed_us // 1000, kbps, retries))
+    result = dict(test="throughput", size=size, window=1, sent=sent,
+                  received=0, lost=0, rtt_min_us=0, rtt_avg_us=0,
+                  rtt_p50_us=0, rtt_p99_us=0, rtt_max_us=0, jitter_us=0,
+                  kbps=kbps, elapsed_ms=elapsed_us // 1000)
+    print_result(result, args.format)
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = parser.add_subparsers(dest="cmd", required=True)
+
+    srv = sub.add_parser("server", help="echo server (host as GO or Client)")
+    srv.add_argument("--bind", default="0.0.0.0")
+    srv.add_argument("--port", type=int, default=UDP_ECHO_PORT)
+    srv.add_argument("--bulk-port", type=int, default=0,
+                     help="also serve this UDP port, e.g. %d" % BULK_PORT)
+    srv.add_argument("--tcp-port", type=int, default=0,
+                     help="also serve TCP, e.g. %d" % TCP_ECHO_PORT)
+    srv.add_argument("--report-ms", type=int, default=1000,
+                     help="stream interval report period")
+
+    for name, helptxt in (("client", "echo client"),
+                          ("stream", "throughput stream sender")):
+        p = sub.add_parser(name, help=helptxt)
+        p.add_argument("host", help="echo server address, e.g. 192.168.88.1")
+        p.add_argument("--tcp", action="store_true",
+                       help="use TCP (server port %d)" % TCP_ECHO_PORT)
+        p.add_argument("--port", type=int, default=None)
+        p.add_argument("--format", choices=("text", "csv", "json"),
+                       default="text", help="result line format")
+        p.add_argument("--wait-ready-ms", type=int, default=2000,
+                       help="readiness probe timeout (UDP, 0 = off)")
+
+    cli = sub.choices["client"]
+    cli.add_argument("--size", type=int, default=64)
+    cli.add_argument("--count", type=int, default=100, help="0 = until ^C")
+    cli.add_argument("--interval-ms", type=float, default=1000)
+    cli.add_argument("--rate-pps", type=float, default=0,
+                     help="request rate, overrides the interval")
+    cli.add_argument("--window", type=int, default=1)
+    cli.add_argument("--full-crc", action="store_true",
+                     help="CRC over the payload too")
+    cli.add_argument("--quiet", action="store_true")
+
+    stm = sub.choices["stream"]
+    stm.add_argument("--size", type=int, default=1024)
+    stm.add_argument("--rate-kbps", type=int, default=0, help="0 = max")
+    stm.add_argument("--duration-ms", type=int, default=10000,
+                     help="0 = until ^C")
+
+    # Stream timestamps must be in the receiving device's time base
+    for p in (srv, stm):
+        p.add_argument("--tick-hz", type=int, default=None,
+                       help="device time_utils rate (default: as reported in "
+                            "the readiness probes, else %d)" % DEFAULT_TICK_HZ)
+
+    args = parser.parse_args()
+    if args.cmd == "server":
+        EchoServer(args).run()
+        return 0
+    if args.port is None:
+        args.port = TCP_ECHO_PORT if args.tcp else UDP_ECHO_PORT
+    if args.cmd == "client":
+        return cmd_client(args)
+    return cmd_stream(args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())